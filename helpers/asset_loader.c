@@ -0,0 +1,86 @@
+// helpers/asset_loader.c
+#include "asset_loader.h"
+
+#define TAG "ProtoPirateAssets"
+
+// Keystore decryption keeps a line buffer and the AES context on the stack
+#define ASSET_LOADER_STACK_SIZE 3072
+
+struct AssetLoader {
+    SubGhzSetting* setting;
+    const char* setting_path;
+    SubGhzEnvironment* environment;
+    const char* keystore_path;
+    AssetLoaderCallback callback;
+    void* context;
+
+    FuriThread* thread;
+    FuriEventFlag* ready;
+};
+
+static void asset_loader_done(AssetLoader* loader, AssetLoaderAsset asset) {
+    if(loader->callback) loader->callback(asset, loader->context);
+    furi_event_flag_set(loader->ready, asset);
+}
+
+static int32_t asset_loader_thread(void* context) {
+    AssetLoader* loader = context;
+
+    // Settings first: menus and the receiver config want them soonest
+    subghz_setting_load(loader->setting, loader->setting_path);
+    asset_loader_done(loader, AssetLoaderSetting);
+
+    if(!subghz_environment_load_keystore(loader->environment, loader->keystore_path)) {
+        FURI_LOG_W(TAG, "Keystore not loaded, keyed protocols won't decrypt");
+    }
+    asset_loader_done(loader, AssetLoaderKeystore);
+
+    return 0;
+}
+
+AssetLoader* asset_loader_alloc(
+    SubGhzSetting* setting,
+    const char* setting_path,
+    SubGhzEnvironment* environment,
+    const char* keystore_path,
+    AssetLoaderCallback callback,
+    void* context) {
+    furi_check(setting);
+    furi_check(setting_path);
+    furi_check(environment);
+    furi_check(keystore_path);
+
+    AssetLoader* loader = malloc(sizeof(AssetLoader));
+    memset(loader, 0, sizeof(AssetLoader));
+    loader->setting = setting;
+    loader->setting_path = setting_path;
+    loader->environment = environment;
+    loader->keystore_path = keystore_path;
+    loader->callback = callback;
+    loader->context = context;
+    loader->ready = furi_event_flag_alloc();
+
+    loader->thread = furi_thread_alloc_ex(
+        "ProtoPirateAssets", ASSET_LOADER_STACK_SIZE, asset_loader_thread, loader);
+    furi_thread_start(loader->thread);
+    return loader;
+}
+
+void asset_loader_free(AssetLoader* loader) {
+    furi_check(loader);
+    furi_thread_join(loader->thread);
+    furi_thread_free(loader->thread);
+    furi_event_flag_free(loader->ready);
+    free(loader);
+}
+
+bool asset_loader_is_ready(AssetLoader* loader, uint32_t assets) {
+    furi_check(loader);
+    return (furi_event_flag_get(loader->ready) & assets) == assets;
+}
+
+void asset_loader_wait(AssetLoader* loader, uint32_t assets) {
+    furi_check(loader);
+    furi_event_flag_wait(
+        loader->ready, assets, FuriFlagWaitAll | FuriFlagNoClear, FuriWaitForever);
+}
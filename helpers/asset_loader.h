@@ -0,0 +1,40 @@
+// helpers/asset_loader.h
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/subghz_setting.h>
+#include <lib/subghz/environment.h>
+
+// Reads the SubGhz user settings and decrypts the keystore on a background
+// thread, so neither holds up the first frame. Scenes that need one wait for
+// it on enter, by which time the loader has usually long finished.
+
+typedef enum {
+    AssetLoaderSetting = (1 << 0),
+    AssetLoaderKeystore = (1 << 1),
+    AssetLoaderAll = AssetLoaderSetting | AssetLoaderKeystore,
+} AssetLoaderAsset;
+
+// Called on the loader thread once an asset is in place, before anyone
+// waiting on it is released
+typedef void (*AssetLoaderCallback)(AssetLoaderAsset asset, void* context);
+
+typedef struct AssetLoader AssetLoader;
+
+// Start loading setting_path into setting, then keystore_path into the
+// environment's keystore. Both must outlive the loader.
+AssetLoader* asset_loader_alloc(
+    SubGhzSetting* setting,
+    const char* setting_path,
+    SubGhzEnvironment* environment,
+    const char* keystore_path,
+    AssetLoaderCallback callback,
+    void* context);
+
+// Waits for the thread to finish, it can't be interrupted mid-file
+void asset_loader_free(AssetLoader* loader);
+
+bool asset_loader_is_ready(AssetLoader* loader, uint32_t assets);
+
+// Block until every asset in the mask is loaded
+void asset_loader_wait(AssetLoader* loader, uint32_t assets);
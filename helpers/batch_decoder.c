@@ -0,0 +1,270 @@
+// helpers/batch_decoder.c
+#include "batch_decoder.h"
+
+#ifdef ENABLE_SUB_DECODE_SCENE
+#include "raw_file_reader.h"
+#include "../protocols/protocol_items.h"
+#include <m-array.h>
+#include <stdlib.h>
+#include <storage/storage.h>
+
+#define TAG "ProtoPirateBatchDecoder"
+
+// Decoders run their AES, TEA and keystore decryption on this stack through
+// get_result, then the row is printf'd and written to storage
+#define BATCH_DECODER_STACK_SIZE (4 * 1024)
+#define BATCH_DECODER_NAME_MAX   128
+
+ARRAY_DEF(BatchFileList, FuriString*, M_PTR_OPLIST)
+
+struct BatchDecoder {
+    SubGhzReceiver* receiver;
+    FuriThread* thread;
+    FuriString* folder;
+    FuriString* output_path;
+    FuriString* line;
+    File* output;
+
+    BatchDecoderCallback callback;
+    void* context;
+
+    // File being decoded and the index of the sample being fed
+    const char* current_name;
+    uint32_t offset;
+
+    volatile bool stop;
+    BatchDecoderStatus status;
+};
+
+BatchDecoder* batch_decoder_alloc(SubGhzReceiver* receiver) {
+    furi_check(receiver);
+    BatchDecoder* decoder = malloc(sizeof(BatchDecoder));
+    memset(decoder, 0, sizeof(BatchDecoder));
+    decoder->receiver = receiver;
+    decoder->folder = furi_string_alloc();
+    decoder->output_path = furi_string_alloc();
+    decoder->line = furi_string_alloc();
+    return decoder;
+}
+
+void batch_decoder_free(BatchDecoder* decoder) {
+    furi_check(decoder);
+    batch_decoder_stop(decoder);
+    furi_string_free(decoder->folder);
+    furi_string_free(decoder->output_path);
+    furi_string_free(decoder->line);
+    free(decoder);
+}
+
+static void batch_decoder_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    BatchDecoder* decoder = context;
+
+    ProtoPirateDecodeResult result;
+    protopirate_decoder_get_result(decoder_base, &result);
+
+    furi_string_printf(
+        decoder->line,
+        "%s\t%lu\t%s\t%u\t%08lX\t%02X\t%lX\t%u\t%u\t",
+        decoder->current_name,
+        decoder->offset,
+        decoder_base->protocol->name,
+        result.bits,
+        result.serial,
+        result.btn,
+        result.cnt,
+        result.crc_valid,
+        result.decrypted);
+    for(size_t i = 0; i < result.key_size; i++) {
+        furi_string_cat_printf(decoder->line, "%02X", result.key[i]);
+    }
+    furi_string_push_back(decoder->line, '\n');
+
+    storage_file_write(
+        decoder->output, furi_string_get_cstr(decoder->line), furi_string_size(decoder->line));
+    decoder->status.matches++;
+
+    // Same as Sub Decode: start clean to look for the next frame
+    subghz_receiver_reset(receiver);
+}
+
+static int batch_decoder_compare_names(const void* a, const void* b) {
+    return furi_string_cmp(*(FuriString* const*)a, *(FuriString* const*)b);
+}
+
+// Every .sub in the folder, sorted so runs over the same folder diff cleanly
+static void batch_decoder_list_files(Storage* storage, const char* folder, BatchFileList_t files) {
+    File* dir = storage_file_alloc(storage);
+    char name[BATCH_DECODER_NAME_MAX];
+    FileInfo info;
+
+    if(storage_dir_open(dir, folder)) {
+        while(storage_dir_read(dir, &info, name, sizeof(name))) {
+            if(file_info_is_dir(&info)) continue;
+            size_t length = strlen(name);
+            if(length < 4 || strcmp(&name[length - 4], ".sub") != 0) continue;
+            BatchFileList_push_back(files, furi_string_alloc_set_str(name));
+        }
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+
+    if(BatchFileList_size(files) > 1) {
+        qsort(
+            BatchFileList_get(files, 0),
+            BatchFileList_size(files),
+            sizeof(FuriString*),
+            batch_decoder_compare_names);
+    }
+}
+
+static void batch_decoder_decode_file(BatchDecoder* decoder, RawFileReader* reader) {
+    const LevelDuration* samples;
+    size_t count;
+
+    subghz_receiver_reset(decoder->receiver);
+    decoder->offset = 0;
+    while(!decoder->stop &&
+          (count = raw_file_reader_get_span(reader, RAW_READER_BUFFER_SIZE, &samples))) {
+        for(size_t i = 0; i < count; i++, decoder->offset++) {
+            subghz_receiver_decode(
+                decoder->receiver,
+                level_duration_get_level(samples[i]),
+                level_duration_get_duration(samples[i]));
+        }
+    }
+    // Let the last frame end the way it would on air
+    subghz_receiver_decode(decoder->receiver, false, PROTOPIRATE_RX_RESYNC_GAP_US);
+}
+
+static int32_t batch_decoder_thread(void* context) {
+    BatchDecoder* decoder = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+    RawFileReader* reader = raw_file_reader_alloc();
+    BatchFileList_t files;
+    BatchFileList_init(files);
+
+    do {
+        batch_decoder_list_files(storage, furi_string_get_cstr(decoder->folder), files);
+        decoder->status.files_total = BatchFileList_size(files);
+
+        DateTime date_time;
+        furi_hal_rtc_get_datetime(&date_time);
+        furi_string_printf(
+            decoder->output_path,
+            "%s/decode_%.4d%.2d%.2d_%.2d%.2d%.2d.tsv",
+            BATCH_DECODER_FOLDER,
+            date_time.year,
+            date_time.month,
+            date_time.day,
+            date_time.hour,
+            date_time.minute,
+            date_time.second);
+
+        storage_simply_mkdir(storage, BATCH_DECODER_FOLDER);
+        decoder->output = storage_file_alloc(storage);
+        if(!storage_file_open(
+               decoder->output,
+               furi_string_get_cstr(decoder->output_path),
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            FURI_LOG_E(TAG, "Failed to open %s", furi_string_get_cstr(decoder->output_path));
+            decoder->status.failed = true;
+            break;
+        }
+
+        furi_string_printf(
+            decoder->line,
+            "# %s\n# file\toffset\tprotocol\tbits\tserial\tbtn\tcnt\tcrc\tdecrypted\tkey\n",
+            furi_string_get_cstr(decoder->folder));
+        storage_file_write(
+            decoder->output, furi_string_get_cstr(decoder->line), furi_string_size(decoder->line));
+
+        subghz_receiver_set_rx_callback(decoder->receiver, batch_decoder_rx_callback, decoder);
+
+        for(size_t i = 0; i < BatchFileList_size(files) && !decoder->stop; i++) {
+            FuriString* name = *BatchFileList_get(files, i);
+            furi_string_printf(
+                path, "%s/%s", furi_string_get_cstr(decoder->folder), furi_string_get_cstr(name));
+            decoder->current_name = furi_string_get_cstr(name);
+
+            if(raw_file_reader_open(reader, furi_string_get_cstr(path))) {
+                batch_decoder_decode_file(decoder, reader);
+                raw_file_reader_close(reader);
+            } else {
+                decoder->status.files_skipped++;
+            }
+
+            decoder->status.files_done++;
+            if(decoder->callback) decoder->callback(decoder->context);
+        }
+
+        subghz_receiver_set_rx_callback(decoder->receiver, NULL, NULL);
+    } while(false);
+
+    if(decoder->output) {
+        storage_file_close(decoder->output);
+        storage_file_free(decoder->output);
+        decoder->output = NULL;
+    }
+
+    for(size_t i = 0; i < BatchFileList_size(files); i++) {
+        furi_string_free(*BatchFileList_get(files, i));
+    }
+    BatchFileList_clear(files);
+    raw_file_reader_free(reader);
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    decoder->status.running = false;
+    if(decoder->callback) decoder->callback(decoder->context);
+    return 0;
+}
+
+bool batch_decoder_start(
+    BatchDecoder* decoder,
+    const char* folder,
+    BatchDecoderCallback callback,
+    void* context) {
+    furi_check(decoder);
+    furi_check(folder);
+    if(decoder->thread) return false;
+
+    furi_string_set(decoder->folder, folder);
+    memset(&decoder->status, 0, sizeof(BatchDecoderStatus));
+    decoder->status.running = true;
+    decoder->callback = callback;
+    decoder->context = context;
+    decoder->stop = false;
+
+    decoder->thread = furi_thread_alloc_ex(
+        "ProtoPirateBatch", BATCH_DECODER_STACK_SIZE, batch_decoder_thread, decoder);
+    furi_thread_start(decoder->thread);
+    return true;
+}
+
+void batch_decoder_stop(BatchDecoder* decoder) {
+    furi_check(decoder);
+    if(!decoder->thread) return;
+
+    decoder->stop = true;
+    furi_thread_join(decoder->thread);
+    furi_thread_free(decoder->thread);
+    decoder->thread = NULL;
+}
+
+void batch_decoder_get_status(BatchDecoder* decoder, BatchDecoderStatus* status) {
+    furi_check(decoder);
+    furi_check(status);
+    *status = decoder->status;
+}
+
+const char* batch_decoder_get_output_path(BatchDecoder* decoder) {
+    furi_check(decoder);
+    return furi_string_get_cstr(decoder->output_path);
+}
+
+#endif // ENABLE_SUB_DECODE_SCENE
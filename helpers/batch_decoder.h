@@ -0,0 +1,47 @@
+// helpers/batch_decoder.h
+#pragma once
+
+#include "../protopirate_app_i.h"
+#ifdef ENABLE_SUB_DECODE_SCENE
+
+#define BATCH_DECODER_FOLDER "/ext/apps_data/proto_pirate/batch"
+
+// Decodes every RAW .sub file in a folder on its own thread, in file name
+// order, and writes one tab separated line per match:
+//   file  offset  protocol  bits  serial  btn  cnt  crc  decrypted  key
+// offset is the index of the sample the decoder fired on.
+
+typedef struct BatchDecoder BatchDecoder;
+
+typedef struct {
+    uint16_t files_total;
+    uint16_t files_done;
+    // Files that are not readable Flipper RAW captures
+    uint16_t files_skipped;
+    uint32_t matches;
+    bool running;
+    bool failed;
+} BatchDecoderStatus;
+
+// Called on the decoder thread after every file and once more when done
+typedef void (*BatchDecoderCallback)(void* context);
+
+// The receiver is borrowed, its rx callback is taken over while running
+BatchDecoder* batch_decoder_alloc(SubGhzReceiver* receiver);
+void batch_decoder_free(BatchDecoder* decoder);
+
+bool batch_decoder_start(
+    BatchDecoder* decoder,
+    const char* folder,
+    BatchDecoderCallback callback,
+    void* context);
+
+// Ask the thread to finish after the current chunk and wait for it
+void batch_decoder_stop(BatchDecoder* decoder);
+
+void batch_decoder_get_status(BatchDecoder* decoder, BatchDecoderStatus* status);
+
+// Results file of the last run
+const char* batch_decoder_get_output_path(BatchDecoder* decoder);
+
+#endif // ENABLE_SUB_DECODE_SCENE
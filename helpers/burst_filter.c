@@ -0,0 +1,154 @@
+// helpers/burst_filter.c
+#include "burst_filter.h"
+#include <string.h>
+
+#define BURST_HELD_LEVEL   0x8000
+#define BURST_TRAIN_LEVEL  0x80
+#define BURST_TRAIN_QUANTA 0x7F
+
+void burst_filter_init(BurstFilter* filter) {
+    memset(filter, 0, sizeof(BurstFilter));
+}
+
+static uint8_t burst_filter_quantise(uint16_t held) {
+    uint32_t quanta = (held & ~BURST_HELD_LEVEL) / BURST_FILTER_QUANTUM_US;
+    if(quanta > BURST_TRAIN_QUANTA) quanta = BURST_TRAIN_QUANTA;
+    return (held & BURST_HELD_LEVEL ? BURST_TRAIN_LEVEL : 0) | quanta;
+}
+
+// Same length, same levels, every duration within one quantum
+static bool burst_filter_matches(const BurstFilter* filter, const BurstFilterEntry* entry) {
+    if(entry->length != filter->held_count) return false;
+
+    for(size_t i = 0; i < filter->held_count; i++) {
+        uint8_t a = burst_filter_quantise(filter->held[i]);
+        uint8_t b = entry->train[i];
+        if((a ^ b) & BURST_TRAIN_LEVEL) return false;
+        int16_t diff = (int16_t)(a & BURST_TRAIN_QUANTA) - (int16_t)(b & BURST_TRAIN_QUANTA);
+        if(diff > 1 || diff < -1) return false;
+    }
+    return true;
+}
+
+// Replay the held pulses. Returns true if any of them completed a decode.
+static bool burst_filter_replay(BurstFilter* filter, BurstFilterFeed feed, void* context) {
+    bool decoded = false;
+    for(size_t i = 0; i < filter->held_count; i++) {
+        uint16_t held = filter->held[i];
+        decoded |= feed(context, held & BURST_HELD_LEVEL, held & ~BURST_HELD_LEVEL);
+    }
+    return decoded;
+}
+
+void burst_filter_flush(BurstFilter* filter, BurstFilterFeed feed, void* context) {
+    burst_filter_replay(filter, feed, context);
+    filter->held_count = 0;
+}
+
+static void burst_filter_remember(
+    BurstFilter* filter,
+    BurstFilterEntry* entry,
+    bool decoded,
+    uint32_t now) {
+    if(!entry) {
+        // Replace the oldest
+        entry = &filter->recent[0];
+        for(size_t i = 1; i < BURST_FILTER_HISTORY; i++) {
+            if((int32_t)(filter->recent[i].seen_at - entry->seen_at) < 0) {
+                entry = &filter->recent[i];
+            }
+        }
+        for(size_t i = 0; i < filter->held_count; i++) {
+            entry->train[i] = burst_filter_quantise(filter->held[i]);
+        }
+        entry->length = filter->held_count;
+        entry->frequency = filter->frequency;
+        entry->decoded = false;
+    }
+    entry->decoded |= decoded;
+    entry->seen_at = now;
+}
+
+// The gap closing a burst has arrived: drop the burst or replay it
+static size_t burst_filter_end_burst(
+    BurstFilter* filter,
+    bool level,
+    uint32_t duration,
+    uint32_t now,
+    BurstFilterFeed feed,
+    void* context) {
+    if(filter->held_count < BURST_FILTER_MIN_PULSES) {
+        burst_filter_flush(filter, feed, context);
+        feed(context, level, duration);
+        return 0;
+    }
+
+    BurstFilterEntry* match = NULL;
+    for(size_t i = 0; i < BURST_FILTER_HISTORY; i++) {
+        BurstFilterEntry* entry = &filter->recent[i];
+        if(entry->length && entry->frequency == filter->frequency &&
+           now - entry->seen_at <= BURST_FILTER_WINDOW_MS && burst_filter_matches(filter, entry)) {
+            match = entry;
+            break;
+        }
+    }
+
+    if(match && match->decoded) {
+        // Decoders have already seen this exact frame
+        size_t dropped = filter->held_count;
+        filter->held_count = 0;
+        feed(context, level, duration);
+        match->seen_at = now;
+        return dropped;
+    }
+
+    // Most decoders complete on the closing gap, so it counts towards the burst
+    bool decoded = burst_filter_replay(filter, feed, context);
+    decoded |= feed(context, level, duration);
+
+    burst_filter_remember(filter, match, decoded, now);
+    filter->held_count = 0;
+    return 0;
+}
+
+size_t burst_filter_push(
+    BurstFilter* filter,
+    bool level,
+    uint32_t duration,
+    uint32_t frequency,
+    uint32_t now,
+    BurstFilterFeed feed,
+    void* context) {
+    if(frequency != filter->frequency) {
+        // Retuned mid-burst: what is held belongs to the old frequency, and
+        // the decoders were reset with the retune, so it can only mislead them
+        filter->held_count = 0;
+        filter->passthrough = false;
+        filter->frequency = frequency;
+    }
+
+    if(duration >= BURST_FILTER_GAP_US) {
+        if(filter->passthrough) {
+            filter->passthrough = false;
+            feed(context, level, duration);
+            return 0;
+        }
+        return burst_filter_end_burst(filter, level, duration, now, feed, context);
+    }
+
+    if(filter->passthrough) {
+        feed(context, level, duration);
+        return 0;
+    }
+
+    if(filter->held_count >= BURST_FILTER_MAX_PULSES) {
+        // Too long to be a fob frame worth remembering
+        burst_filter_flush(filter, feed, context);
+        filter->passthrough = true;
+        feed(context, level, duration);
+        return 0;
+    }
+
+    filter->held[filter->held_count++] = (level ? BURST_HELD_LEVEL : 0) | duration;
+    return 0;
+}
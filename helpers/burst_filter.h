@@ -0,0 +1,64 @@
+// helpers/burst_filter.h
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Repeat-burst suppression ahead of the decoders. Pulses between two quiet
+// gaps are held back as a burst; when the gap arrives the burst is compared
+// against the last few bursts that decoded on the same frequency. A repeat
+// seen within the window is dropped instead of being decoded again, anything
+// else is replayed to the decoders unchanged. Pure bookkeeping like the
+// hopper scheduler: pulses go out through a caller supplied feed function.
+
+#define BURST_FILTER_MAX_PULSES 384
+#define BURST_FILTER_HISTORY    2
+// Pulses at least this long end a burst and always reach the decoders
+#define BURST_FILTER_GAP_US 4000
+// Bursts shorter than this are noise and are never held
+#define BURST_FILTER_MIN_PULSES 16
+// Quantum of the stored train; pulses match when within one quantum
+#define BURST_FILTER_QUANTUM_US 32
+#define BURST_FILTER_WINDOW_MS  300
+
+// Hand one pulse to the decoders. Returns true if it completed a decode.
+typedef bool (*BurstFilterFeed)(void* context, bool level, uint32_t duration);
+
+typedef struct {
+    // Level in bit 7, duration in quanta below it
+    uint8_t train[BURST_FILTER_MAX_PULSES];
+    uint16_t length;
+    uint32_t frequency;
+    uint32_t seen_at;
+    bool decoded;
+} BurstFilterEntry;
+
+typedef struct {
+    // Held pulses of the current burst: level in bit 15, duration in us below
+    uint16_t held[BURST_FILTER_MAX_PULSES];
+    uint16_t held_count;
+    // Current burst outgrew the buffer, feed it straight through to the gap
+    bool passthrough;
+    uint32_t frequency;
+    BurstFilterEntry recent[BURST_FILTER_HISTORY];
+} BurstFilter;
+
+void burst_filter_init(BurstFilter* filter);
+
+// Push one pulse received on frequency at time now (ms). Pulses reach feed
+// either straight away, when the burst ends, or not at all when the burst is
+// a repeat, and pulses still held when frequency changes are discarded.
+// Returns the number of pulses dropped as a repeat, normally 0.
+size_t burst_filter_push(
+    BurstFilter* filter,
+    bool level,
+    uint32_t duration,
+    uint32_t frequency,
+    uint32_t now,
+    BurstFilterFeed feed,
+    void* context);
+
+// Feed whatever is held straight to the decoders, e.g. before an overrun
+// recovery so the decoders know about the partial frame
+void burst_filter_flush(BurstFilter* filter, BurstFilterFeed feed, void* context);
@@ -0,0 +1,691 @@
+// helpers/decoder_bench.c
+#include "decoder_bench.h"
+
+#ifdef ENABLE_SUB_DECODE_SCENE
+#include "../protocols/protocol_items.h"
+#include "hopper_scheduler.h"
+#include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
+
+#define TAG "ProtoPirateDecoderBench"
+
+#define DECODER_BENCH_STACK_SIZE 2048
+
+#define DECODER_FUZZ_WORST_KEY "SlowestFeedUs"
+// Arbitrary durations are log-uniform up to 2^DECODER_FUZZ_MAX_EXPONENT us
+#define DECODER_FUZZ_MAX_EXPONENT 16
+
+typedef struct {
+    const char* name;
+    PulseGeneratorConfig config;
+} DecoderBenchScenario;
+
+static const DecoderBenchScenario decoder_bench_scenarios[] = {
+    {
+        .name = "Clean",
+        .config =
+            {
+                .jitter_pct = 5,
+                .gap_min_us = 10000,
+                .gap_max_us = 20000,
+                .interleave = true,
+            },
+    },
+    {
+        .name = "Jitter",
+        .config =
+            {
+                .jitter_pct = 20,
+                .glitch_permille = 10,
+                .glitch_max_us = 60,
+                .gap_min_us = 5000,
+                .gap_max_us = 20000,
+                .interleave = true,
+            },
+    },
+    {
+        .name = "Noise only",
+        .config =
+            {
+                .noise_pct = 100,
+                .noise_pulses = 64,
+                .noise_min_us = 20,
+                .noise_max_us = 3000,
+                .gap_min_us = 1000,
+                .gap_max_us = 5000,
+            },
+    },
+    {
+        // A crowded 433.92 MHz car park: overlapping remotes, glitches and
+        // noise between frames
+        .name = "Car park",
+        .config =
+            {
+                .jitter_pct = 15,
+                .glitch_permille = 20,
+                .glitch_max_us = 80,
+                .noise_pct = 40,
+                .noise_pulses = 48,
+                .noise_min_us = 30,
+                .noise_max_us = 1500,
+                .gap_min_us = 1000,
+                .gap_max_us = 8000,
+                .interleave = true,
+            },
+    },
+};
+
+#define DECODER_BENCH_SCENARIOS COUNT_OF(decoder_bench_scenarios)
+// Car park, the scenario with glitches inside frames
+#define DECODER_GLITCH_SCENARIO 3
+
+// Trains of the fuzzed decoder's own timing, rough enough to reach the odd
+// corners of its state machine
+static const PulseGeneratorConfig decoder_fuzz_shaped_config = {
+    .jitter_pct = 30,
+    .glitch_permille = 50,
+    .glitch_max_us = 150,
+    .noise_pct = 20,
+    .noise_pulses = 32,
+    .noise_min_us = 10,
+    .noise_max_us = 5000,
+    .gap_min_us = 500,
+    .gap_max_us = 30000,
+};
+
+// Hopper simulation: slot counts tried, the slot that sees a remote, and
+// how often it decodes while listened to
+static const uint8_t decoder_hopper_counts[DECODER_HOPPER_COUNTS] = {
+    2,
+    6,
+    HOPPER_SCHEDULER_MAX_SLOTS,
+};
+#define DECODER_HOPPER_ACTIVE_SLOT 1
+#define DECODER_HOPPER_DECODE_MS   500
+#define DECODER_HOPPER_QUIET_DBM   -100.0f
+#define DECODER_HOPPER_LOUD_DBM    -50.0f
+
+struct DecoderBench {
+    SubGhzReceiver* receiver;
+    FuriThread* thread;
+    PulseGenerator generator;
+
+    DecoderBenchCallback callback;
+    void* context;
+
+    volatile bool stop;
+    volatile bool running;
+    volatile size_t scenarios_done;
+    DecoderBenchResult results[DECODER_BENCH_SCENARIOS];
+    // Each decoder's feed cost over all scenarios
+    SubGhzProtocolDecoderBase* decoders[ProtoPirateProtocolIdCount];
+    ProtoPirateFeedStats decoder_feed[ProtoPirateProtocolIdCount];
+
+    volatile bool hopper_done;
+    DecoderHopperResult hopper[PROTOPIRATE_HOPPER_DWELL_COUNT];
+
+    volatile size_t glitch_done;
+    DecoderGlitchResult glitch[PROTOPIRATE_GLITCH_FILTER_COUNT];
+    // Scratch for the glitch runs, kept apart from the scenario totals
+    ProtoPirateFeedStats glitch_feed[ProtoPirateProtocolIdCount];
+
+    volatile size_t fuzz_done;
+    DecoderFuzzResult fuzz[ProtoPirateProtocolIdCount];
+    // Last pulses fed as signed RAW_Data, and a copy taken at the slowest feed
+    int32_t window[DECODER_FUZZ_WINDOW];
+    int32_t worst_window[DECODER_FUZZ_WINDOW];
+    size_t worst_length;
+};
+
+size_t decoder_bench_scenario_count(void) {
+    return DECODER_BENCH_SCENARIOS;
+}
+
+const char* decoder_bench_scenario_name(size_t index) {
+    return index < DECODER_BENCH_SCENARIOS ? decoder_bench_scenarios[index].name : NULL;
+}
+
+size_t decoder_bench_families(PulseGeneratorFamily* families, size_t max) {
+    size_t count = protopirate_get_protocol_timing_count();
+    if(count > max) count = max;
+
+    for(size_t i = 0; i < count; i++) {
+        const SubGhzBlockConst* timing = protopirate_get_protocol_timing_by_index(i)->timing;
+        families[i] = (PulseGeneratorFamily){
+            .te_short = timing->te_short,
+            .te_long = timing->te_long,
+            .te_delta = timing->te_delta,
+            .min_count_bit = timing->min_count_bit_for_found,
+        };
+    }
+    return count;
+}
+
+DecoderBench* decoder_bench_alloc(SubGhzReceiver* receiver) {
+    furi_check(receiver);
+    DecoderBench* bench = malloc(sizeof(DecoderBench));
+    memset(bench, 0, sizeof(DecoderBench));
+    bench->receiver = receiver;
+    return bench;
+}
+
+void decoder_bench_free(DecoderBench* bench) {
+    furi_check(bench);
+    decoder_bench_stop(bench);
+    free(bench);
+}
+
+static void decoder_bench_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    DecoderBenchResult* result = context;
+    result->decodes++;
+}
+
+// Drive the scheduler the way protopirate_hopper_update does, one radio poll
+// at a time, and return the longest any slot went unvisited. An ordinary
+// sweep has a remote on one slot only, otherwise every slot carries a loud
+// signal for the whole run so every visit is held as long as allowed.
+static uint32_t decoder_hopper_run(const HopperSchedulerConfig* config, size_t count, bool busy) {
+    HopperScheduler scheduler;
+    uint32_t last_seen[HOPPER_SCHEDULER_MAX_SLOTS] = {0};
+    uint32_t worst = 0;
+    uint32_t now = 0;
+
+    hopper_scheduler_init(&scheduler, config, count, now);
+    for(now = PROTOPIRATE_RADIO_POLL_MS; now <= DECODER_HOPPER_RUN_MS;
+        now += PROTOPIRATE_RADIO_POLL_MS) {
+        uint8_t current = hopper_scheduler_current(&scheduler);
+        bool active = current == DECODER_HOPPER_ACTIVE_SLOT;
+
+        if(active && now % DECODER_HOPPER_DECODE_MS == 0) {
+            hopper_scheduler_on_decode(&scheduler, now);
+        }
+        hopper_scheduler_on_rssi(
+            &scheduler,
+            busy || active ? DECODER_HOPPER_LOUD_DBM : DECODER_HOPPER_QUIET_DBM,
+            now);
+        if(hopper_scheduler_tick(&scheduler, now)) {
+            current = hopper_scheduler_current(&scheduler);
+            if(now - last_seen[current] > worst) worst = now - last_seen[current];
+        }
+        last_seen[current] = now;
+    }
+
+    // Slots still waiting when the run ends count as well
+    for(size_t i = 0; i < scheduler.count; i++) {
+        if(DECODER_HOPPER_RUN_MS - last_seen[i] > worst) {
+            worst = DECODER_HOPPER_RUN_MS - last_seen[i];
+        }
+    }
+    return worst;
+}
+
+static void decoder_hopper_pass(DecoderBench* bench) {
+    for(size_t i = 0; i < PROTOPIRATE_HOPPER_DWELL_COUNT && !bench->stop; i++) {
+        DecoderHopperResult* result = &bench->hopper[i];
+        result->passed = true;
+
+        for(size_t j = 0; j < DECODER_HOPPER_COUNTS; j++) {
+            size_t count = decoder_hopper_counts[j];
+            HopperSchedulerConfig config;
+            hopper_scheduler_config_for_dwell(&config, protopirate_hopper_dwell_ms[i], count);
+
+            uint32_t bound =
+                hopper_scheduler_revisit_bound(&config, count, PROTOPIRATE_RADIO_POLL_MS);
+            uint32_t sweep_gap = decoder_hopper_run(&config, count, false);
+            uint32_t busy_gap = decoder_hopper_run(&config, count, true);
+            uint32_t worst_gap = MAX(sweep_gap, busy_gap);
+
+            if(worst_gap > bound || sweep_gap >= config.max_revisit) result->passed = false;
+            result->worst_gap = worst_gap;
+            result->bound = bound;
+            result->sweep_gap = sweep_gap;
+            result->max_revisit = config.max_revisit;
+        }
+    }
+}
+
+static void decoder_bench_run_scenario(DecoderBench* bench, size_t index) {
+    DecoderBenchResult* result = &bench->results[index];
+    PulseGeneratorFamily families[PULSE_GENERATOR_MAX_FAMILIES];
+    size_t family_count = decoder_bench_families(families, COUNT_OF(families));
+
+    // Same seed for every scenario, so runs can be compared build to build
+    pulse_generator_init(
+        &bench->generator,
+        &decoder_bench_scenarios[index].config,
+        families,
+        family_count,
+        DECODER_BENCH_SEED);
+
+    subghz_receiver_reset(bench->receiver);
+    subghz_receiver_set_rx_callback(bench->receiver, decoder_bench_rx_callback, result);
+
+    bool level;
+    uint32_t duration;
+    for(uint32_t i = 0; i < DECODER_BENCH_PULSES && !bench->stop; i++) {
+        pulse_generator_next(&bench->generator, &level, &duration);
+
+        uint32_t decodes = result->decodes;
+        uint32_t start = protopirate_rx_metrics_now();
+        protopirate_rx_metrics_feed_decoders(
+            bench->decoder_feed, bench->decoders, level, duration);
+        protopirate_rx_metrics_timing_add(&result->feed, start);
+        if(result->decodes != decodes) protopirate_rx_metrics_timing_add(&result->trigger, start);
+    }
+
+    subghz_receiver_set_rx_callback(bench->receiver, NULL, NULL);
+    result->generated = bench->generator.stats;
+}
+
+static void decoder_glitch_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    UNUSED(decoder_base);
+    DecoderGlitchResult* result = context;
+    result->decodes++;
+}
+
+static void decoder_glitch_deliver(
+    DecoderBench* bench,
+    DecoderGlitchResult* result,
+    bool level,
+    uint32_t duration,
+    uint32_t shortest) {
+    result->delivered++;
+    if(duration < shortest) result->runts++;
+
+    uint32_t start = protopirate_rx_metrics_now();
+    protopirate_rx_metrics_feed_decoders(bench->glitch_feed, bench->decoders, level, duration);
+    protopirate_rx_metrics_timing_add(&result->feed, start);
+}
+
+// The scenario's pulses through the same merge SubGhzWorker runs in front of
+// the pair callback: a pulse shorter than threshold, or one repeating the
+// pending level, is added to the pending pulse, which goes out when the
+// level changes
+static void decoder_glitch_run(
+    DecoderBench* bench,
+    const PulseGeneratorFamily* families,
+    size_t family_count,
+    uint32_t shortest,
+    uint16_t threshold,
+    DecoderGlitchResult* result) {
+    pulse_generator_init(
+        &bench->generator,
+        &decoder_bench_scenarios[DECODER_GLITCH_SCENARIO].config,
+        families,
+        family_count,
+        DECODER_BENCH_SEED);
+
+    subghz_receiver_reset(bench->receiver);
+    subghz_receiver_set_rx_callback(bench->receiver, decoder_glitch_rx_callback, result);
+
+    bool pending_level = false;
+    uint32_t pending = 0;
+    bool level;
+    uint32_t duration;
+    for(uint32_t i = 0; i < DECODER_BENCH_PULSES && !bench->stop; i++) {
+        pulse_generator_next(&bench->generator, &level, &duration);
+        if(duration < threshold || level == pending_level) {
+            if(duration >= shortest && level != pending_level) result->swallowed++;
+            pending += duration;
+            continue;
+        }
+        if(pending) decoder_glitch_deliver(bench, result, pending_level, pending, shortest);
+        pending_level = level;
+        pending = duration;
+    }
+
+    subghz_receiver_set_rx_callback(bench->receiver, NULL, NULL);
+}
+
+static void decoder_glitch_pass(DecoderBench* bench) {
+    PulseGeneratorFamily families[PULSE_GENERATOR_MAX_FAMILIES];
+    size_t family_count = decoder_bench_families(families, COUNT_OF(families));
+
+    // Anything shorter than this can't be part of any protocol's frame
+    uint32_t shortest = UINT32_MAX;
+    for(size_t i = 0; i < family_count; i++) {
+        uint32_t low = families[i].te_short > families[i].te_delta ?
+                           families[i].te_short - families[i].te_delta :
+                           0;
+        if(low < shortest) shortest = low;
+    }
+
+    for(size_t i = 0; i < PROTOPIRATE_GLITCH_FILTER_COUNT && !bench->stop; i++) {
+        decoder_glitch_run(
+            bench,
+            families,
+            family_count,
+            shortest,
+            protopirate_glitch_filter_values[i],
+            &bench->glitch[i]);
+        if(bench->stop) break;
+        bench->glitch_done = i + 1;
+        if(bench->callback) bench->callback(bench->context);
+    }
+}
+
+// Next fuzz input: either anything at all, levels included, or a pulse of
+// the generator's train
+static void decoder_fuzz_next(
+    PulseGenerator* generator,
+    bool shaped,
+    bool* level,
+    uint32_t* duration) {
+    if(shaped) {
+        pulse_generator_next(generator, level, duration);
+        return;
+    }
+
+    *level = pulse_generator_random(generator, 0, 1);
+    uint32_t exponent = pulse_generator_random(generator, 0, DECODER_FUZZ_MAX_EXPONENT - 1);
+    *duration = pulse_generator_random(generator, 1U << exponent, (2U << exponent) - 1);
+}
+
+static void decoder_fuzz_keep_window(DecoderBench* bench, uint32_t pulse) {
+    // Unroll the ring so the slowest feed ends up last
+    size_t length = pulse + 1 < DECODER_FUZZ_WINDOW ? pulse + 1 : DECODER_FUZZ_WINDOW;
+    for(size_t i = 0; i < length; i++) {
+        bench->worst_window[i] = bench->window[(pulse + 1 - length + i) % DECODER_FUZZ_WINDOW];
+    }
+    bench->worst_length = length;
+}
+
+static void decoder_fuzz_run(
+    DecoderBench* bench,
+    SubGhzProtocolDecoderBase* decoder,
+    const PulseGeneratorFamily* family,
+    DecoderFuzzResult* result,
+    uint32_t seed) {
+    SubGhzDecoderFeed feed = decoder->protocol->decoder->feed;
+    bench->worst_length = 0;
+
+    for(uint32_t round = 0; round < DECODER_FUZZ_ROUNDS && !bench->stop; round++) {
+        bool shaped = round & 1;
+        pulse_generator_init(
+            &bench->generator, &decoder_fuzz_shaped_config, family, 1, seed + round);
+        decoder->protocol->decoder->reset(decoder);
+
+        bool level;
+        uint32_t duration;
+        for(uint32_t pulse = 0; pulse < DECODER_FUZZ_PULSES && !bench->stop; pulse++) {
+            decoder_fuzz_next(&bench->generator, shaped, &level, &duration);
+            bench->window[pulse % DECODER_FUZZ_WINDOW] =
+                level ? (int32_t)duration : -(int32_t)duration;
+
+            uint32_t start = protopirate_rx_metrics_now();
+            feed(decoder, level, duration);
+            uint32_t cycles = protopirate_rx_metrics_now() - start;
+
+            if(cycles > result->worst_cycles) {
+                result->worst_cycles = cycles;
+                result->worst_seed = seed + round;
+                result->worst_pulse = pulse;
+                decoder_fuzz_keep_window(bench, pulse);
+            }
+        }
+    }
+
+    decoder->protocol->decoder->reset(decoder);
+}
+
+// Write the kept window as a RAW capture unless the corpus already has a
+// slower input for this protocol
+static bool decoder_fuzz_save(DecoderBench* bench, const char* name, DecoderFuzzResult* result) {
+    uint32_t worst_us = result->worst_cycles / furi_hal_cortex_instructions_per_microsecond();
+    FuriString* path = furi_string_alloc_printf("%s/%s.sub", DECODER_FUZZ_FOLDER, name);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    bool saved = false;
+
+    do {
+        uint32_t corpus_us = 0;
+        if(flipper_format_file_open_existing(ff, furi_string_get_cstr(path)) &&
+           flipper_format_read_uint32(ff, DECODER_FUZZ_WORST_KEY, &corpus_us, 1) &&
+           corpus_us >= worst_us) {
+            break;
+        }
+        flipper_format_file_close(ff);
+
+        storage_simply_mkdir(storage, DECODER_FUZZ_FOLDER);
+        if(!flipper_format_file_open_always(ff, furi_string_get_cstr(path))) {
+            FURI_LOG_E(TAG, "Failed to open %s", furi_string_get_cstr(path));
+            break;
+        }
+
+        uint32_t frequency = 433920000;
+        if(!flipper_format_write_header_cstr(ff, "Flipper SubGhz RAW File", 1)) break;
+        if(!flipper_format_write_uint32(ff, "Frequency", &frequency, 1)) break;
+        if(!flipper_format_write_string_cstr(ff, "Preset", "FuriHalSubGhzPresetOok650Async")) {
+            break;
+        }
+        if(!flipper_format_write_string_cstr(ff, "Protocol", "RAW")) break;
+        if(!flipper_format_write_uint32(ff, DECODER_FUZZ_WORST_KEY, &worst_us, 1)) break;
+        if(!flipper_format_write_uint32(ff, "FuzzSeed", &result->worst_seed, 1)) break;
+        if(!flipper_format_write_uint32(ff, "FuzzPulse", &result->worst_pulse, 1)) break;
+        if(!flipper_format_write_int32(
+               ff, "RAW_Data", bench->worst_window, bench->worst_length)) {
+            break;
+        }
+
+        saved = true;
+    } while(false);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(path);
+    return saved;
+}
+
+static void decoder_fuzz_pass(DecoderBench* bench) {
+    PulseGeneratorFamily families[ProtoPirateProtocolIdCount];
+    decoder_bench_families(families, COUNT_OF(families));
+
+    // Decoders are driven directly, nothing should reach the app
+    subghz_receiver_set_rx_callback(bench->receiver, NULL, NULL);
+
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount && !bench->stop; i++) {
+        const char* name = protopirate_protocol_name(i);
+        SubGhzProtocolDecoderBase* decoder =
+            subghz_receiver_search_decoder_base_by_name(bench->receiver, name);
+        DecoderFuzzResult* result = &bench->fuzz[i];
+
+        if(decoder) {
+            decoder_fuzz_run(bench, decoder, &families[i], result, DECODER_BENCH_SEED + i * 64);
+            if(!bench->stop && bench->worst_length) {
+                result->saved = decoder_fuzz_save(bench, name, result);
+            }
+        }
+
+        if(bench->stop) break;
+        bench->fuzz_done = i + 1;
+        if(bench->callback) bench->callback(bench->context);
+    }
+}
+
+static int32_t decoder_bench_thread(void* context) {
+    DecoderBench* bench = context;
+
+    decoder_hopper_pass(bench);
+    if(!bench->stop) {
+        bench->hopper_done = true;
+        if(bench->callback) bench->callback(bench->context);
+    }
+
+    for(size_t i = 0; i < DECODER_BENCH_SCENARIOS && !bench->stop; i++) {
+        decoder_bench_run_scenario(bench, i);
+        if(bench->stop) break;
+        bench->scenarios_done = i + 1;
+        if(bench->callback) bench->callback(bench->context);
+    }
+    if(!bench->stop) decoder_glitch_pass(bench);
+    if(!bench->stop) decoder_fuzz_pass(bench);
+
+    subghz_receiver_reset(bench->receiver);
+    bench->running = false;
+    if(bench->callback) bench->callback(bench->context);
+    return 0;
+}
+
+bool decoder_bench_start(DecoderBench* bench, DecoderBenchCallback callback, void* context) {
+    furi_check(bench);
+    if(bench->thread) return false;
+
+    memset(bench->results, 0, sizeof(bench->results));
+    memset(bench->fuzz, 0, sizeof(bench->fuzz));
+    memset(bench->hopper, 0, sizeof(bench->hopper));
+    memset(bench->glitch, 0, sizeof(bench->glitch));
+    memset(bench->glitch_feed, 0, sizeof(bench->glitch_feed));
+    memset(bench->decoder_feed, 0, sizeof(bench->decoder_feed));
+    protopirate_receiver_get_decoders(bench->receiver, bench->decoders);
+    bench->hopper_done = false;
+    bench->scenarios_done = 0;
+    bench->glitch_done = 0;
+    bench->fuzz_done = 0;
+    bench->callback = callback;
+    bench->context = context;
+    bench->stop = false;
+    bench->running = true;
+
+    bench->thread = furi_thread_alloc_ex(
+        "ProtoPirateBench", DECODER_BENCH_STACK_SIZE, decoder_bench_thread, bench);
+    furi_thread_start(bench->thread);
+    return true;
+}
+
+void decoder_bench_stop(DecoderBench* bench) {
+    furi_check(bench);
+    if(!bench->thread) return;
+
+    bench->stop = true;
+    furi_thread_join(bench->thread);
+    furi_thread_free(bench->thread);
+    bench->thread = NULL;
+}
+
+bool decoder_bench_is_running(DecoderBench* bench) {
+    furi_check(bench);
+    return bench->running;
+}
+
+static uint32_t decoder_bench_us(uint64_t cycles) {
+    return cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+void decoder_bench_format(DecoderBench* bench, FuriString* output) {
+    furi_check(bench);
+    furi_check(output);
+
+    furi_string_reset(output);
+    if(bench->hopper_done) {
+        furi_string_cat_str(output, "Hopper, longest unvisited (ms):\n");
+        for(size_t i = 0; i < PROTOPIRATE_HOPPER_DWELL_COUNT; i++) {
+            const DecoderHopperResult* result = &bench->hopper[i];
+            furi_string_cat_printf(
+                output,
+                " %ums: %lu/%lu, sweep %lu/%lu %s\n",
+                protopirate_hopper_dwell_ms[i],
+                result->worst_gap,
+                result->bound,
+                result->sweep_gap,
+                result->max_revisit,
+                result->passed ? "OK" : "FAIL");
+        }
+    }
+
+    for(size_t i = 0; i < bench->scenarios_done; i++) {
+        const DecoderBenchResult* result = &bench->results[i];
+        const ProtoPirateRxTiming* feed = &result->feed;
+        // Hundredths of a microsecond, the average is usually a few us
+        uint32_t avg_cus = feed->calls ? decoder_bench_us(feed->total_cycles * 100) / feed->calls :
+                                         0;
+
+        furi_string_cat_printf(
+            output,
+            "%s: %lu pulses\n"
+            " %lu.%02luus/pulse, %lu/s\n"
+            " Max feed: %luus\n"
+            " False decodes: %lu\n",
+            decoder_bench_scenarios[i].name,
+            feed->calls,
+            avg_cus / 100,
+            avg_cus % 100,
+            avg_cus ? 100000000UL / avg_cus : 0,
+            decoder_bench_us(feed->max_cycles),
+            result->decodes);
+        if(result->trigger.calls) {
+            furi_string_cat_printf(
+                output,
+                " Per decode: %luus\n",
+                decoder_bench_us(result->trigger.total_cycles) / result->trigger.calls);
+        }
+    }
+    if(bench->scenarios_done == DECODER_BENCH_SCENARIOS) {
+        protopirate_rx_metrics_format_feed(bench->decoder_feed, output);
+    }
+
+    if(bench->glitch_done) {
+        furi_string_cat_printf(
+            output,
+            "Glitch filter, %s:\n",
+            decoder_bench_scenario_name(DECODER_GLITCH_SCENARIO));
+    }
+    for(size_t i = 0; i < bench->glitch_done; i++) {
+        const DecoderGlitchResult* result = &bench->glitch[i];
+        // Cost per generated pulse, so thresholds that feed fewer compare fairly
+        uint32_t avg_cus = decoder_bench_us(result->feed.total_cycles * 100) /
+                           DECODER_BENCH_PULSES;
+        furi_string_cat_printf(
+            output,
+            " %uus: %lu out, %lu runts\n"
+            "  %lu eaten, %lu dec, %lu.%02luus\n",
+            protopirate_glitch_filter_values[i],
+            result->delivered,
+            result->runts,
+            result->swallowed,
+            result->decodes,
+            avg_cus / 100,
+            avg_cus % 100);
+    }
+
+    if(bench->fuzz_done) furi_string_cat_str(output, "Fuzz, slowest feed (*new):\n");
+    for(size_t i = 0; i < bench->fuzz_done; i++) {
+        const DecoderFuzzResult* result = &bench->fuzz[i];
+        furi_string_cat_printf(
+            output,
+            " %s: %luus%s\n",
+            protopirate_protocol_name(i),
+            decoder_bench_us(result->worst_cycles),
+            result->saved ? "*" : "");
+    }
+
+    furi_string_cat_printf(
+        output,
+        "Heap free %zu, block %zu\n",
+        memmgr_get_free_heap(),
+        memmgr_heap_get_max_free_block());
+
+    if(bench->running) {
+        const char* step;
+        if(!bench->hopper_done) {
+            step = "hopper";
+        } else if(bench->scenarios_done < DECODER_BENCH_SCENARIOS) {
+            step = decoder_bench_scenario_name(bench->scenarios_done);
+        } else if(bench->glitch_done < PROTOPIRATE_GLITCH_FILTER_COUNT) {
+            step = "glitch filter";
+        } else {
+            step = protopirate_protocol_name(bench->fuzz_done);
+        }
+        furi_string_cat_printf(output, "Running %s...\n", step);
+    }
+}
+
+#endif // ENABLE_SUB_DECODE_SCENE
@@ -0,0 +1,106 @@
+// helpers/decoder_bench.h
+#pragma once
+
+#include "../protopirate_app_i.h"
+#ifdef ENABLE_SUB_DECODE_SCENE
+#include "pulse_generator.h"
+
+// Feeds synthetic pulse trains built from the registry timings through the
+// receiver on its own thread, one scenario after the other, and measures
+// the cost per pulse, overall and per decoder. The payloads are random, so
+// every decode is a false trigger.
+//
+// The Car park scenario is then replayed through SubGhzWorker's pulse merge
+// at every Glitch Filter option, OFF first, to show what each threshold does
+// to the short pulses reaching the decoders and to the legitimate ones.
+//
+// A fuzz pass follows: every decoder alone gets arbitrary (level, duration)
+// sequences and jittered trains of its own timing, and the slowest single
+// feed call is kept together with the pulses leading up to it. Those are
+// written as RAW captures to DECODER_FUZZ_FOLDER, one per protocol, replaced
+// only by a slower input, so the folder can be replayed with Batch Decode.
+//
+// Before either, the hopper scheduler is run through simulated traffic on
+// every hop dwell option, to check no slot goes unvisited for longer than
+// hopper_scheduler_revisit_bound and that an ordinary sweep never has to
+// fall back on the overdue ordering.
+
+#define DECODER_BENCH_PULSES 20000
+#define DECODER_BENCH_SEED   0x50524F54
+
+#define DECODER_FUZZ_FOLDER "/ext/apps_data/proto_pirate/fuzz"
+#define DECODER_FUZZ_ROUNDS 8
+#define DECODER_FUZZ_PULSES 4096
+// Pulses kept before the slowest feed, the feed itself last
+#define DECODER_FUZZ_WINDOW 256
+
+typedef struct {
+    uint32_t decodes;
+    // Every feed, and the feeds that ended in a decode
+    ProtoPirateRxTiming feed;
+    ProtoPirateRxTiming trigger;
+    PulseGeneratorStats generated;
+} DecoderBenchResult;
+
+typedef struct {
+    uint32_t worst_cycles;
+    // Where the slowest feed happened, to regenerate the input
+    uint32_t worst_seed;
+    uint32_t worst_pulse;
+    // A new corpus entry was written for it
+    bool saved;
+} DecoderFuzzResult;
+
+// Simulated minutes per hopper run, and the slot counts tried
+#define DECODER_HOPPER_RUN_MS (10 * 60 * 1000)
+#define DECODER_HOPPER_COUNTS 3
+
+typedef struct {
+    // With the largest slot count: the longest gap under any traffic and in
+    // an ordinary sweep, and the bound and max_revisit they are held to
+    uint32_t worst_gap;
+    uint32_t bound;
+    uint32_t sweep_gap;
+    uint32_t max_revisit;
+    // Every slot count stayed within both
+    bool passed;
+} DecoderHopperResult;
+
+typedef struct {
+    // Pulses out of the merge, those shorter than every protocol's shortest
+    // pulse, and input pulses at least that long the merge swallowed
+    uint32_t delivered;
+    uint32_t runts;
+    uint32_t swallowed;
+    uint32_t decodes;
+    ProtoPirateRxTiming feed;
+} DecoderGlitchResult;
+
+typedef struct DecoderBench DecoderBench;
+
+// Called on the bench thread after every scenario, glitch threshold and
+// fuzzed decoder, and once more when done
+typedef void (*DecoderBenchCallback)(void* context);
+
+size_t decoder_bench_scenario_count(void);
+const char* decoder_bench_scenario_name(size_t index);
+
+// Registry timings as generator families, returns how many were written
+size_t decoder_bench_families(PulseGeneratorFamily* families, size_t max);
+
+// The receiver is borrowed, its rx callback is taken over while running
+DecoderBench* decoder_bench_alloc(SubGhzReceiver* receiver);
+void decoder_bench_free(DecoderBench* bench);
+
+bool decoder_bench_start(DecoderBench* bench, DecoderBenchCallback callback, void* context);
+
+// Ask the thread to finish after the current pulse and wait for it
+void decoder_bench_stop(DecoderBench* bench);
+
+bool decoder_bench_is_running(DecoderBench* bench);
+
+// Results so far: hopper, one block per finished scenario, the glitch
+// filter, then the fuzz pass
+void decoder_bench_format(DecoderBench* bench, FuriString* output);
+
+#endif // ENABLE_SUB_DECODE_SCENE
@@ -0,0 +1,19 @@
+// helpers/draw_tables.c
+#include "draw_tables.h"
+
+// round(127 * sin(i * 90 / 64 degrees))
+const int8_t draw_sin_quarter[65] = {
+    0,   3,   6,   9,   12,  16,  19,  22,  25,  28,  31,  34,  37,  40,  43,  46,  49,
+    51,  54,  57,  60,  63,  65,  68,  71,  73,  76,  78,  81,  83,  85,  88,  90,  92,
+    94,  96,  98,  100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116, 117, 118, 120,
+    121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127, 127,
+};
+
+// Diagonal stripes, pixel (x, y) set when (x + y - frame) & 3 < 2. XBM rows,
+// least significant bit leftmost, indexed by frame & 3.
+const uint8_t draw_stripe_sprites[DRAW_STRIPE_PHASES][DRAW_STRIPE_HEIGHT] = {
+    {0x33, 0x99, 0xCC, 0x66, 0x33, 0x99},
+    {0x66, 0x33, 0x99, 0xCC, 0x66, 0x33},
+    {0xCC, 0x66, 0x33, 0x99, 0xCC, 0x66},
+    {0x99, 0xCC, 0x66, 0x33, 0x99, 0xCC},
+};
@@ -0,0 +1,49 @@
+// helpers/draw_tables.h
+#pragma once
+
+#include <stdint.h>
+
+// Lookup tables for the view animations, so draw callbacks don't call
+// sinf/cosf for every dot on every frame. Angles are binary: a full turn is
+// 256 steps and wraps for free in a uint8_t.
+
+// Value of sin/cos at a quarter turn
+#define DRAW_TRIG_ONE 127
+
+// Binary angle steps for a whole number of degrees
+#define DRAW_DEGREES(deg) ((uint8_t)((deg) * 256 / 360))
+
+// The progress bar stripe sprite: 8 pixels wide, one per frame phase
+#define DRAW_STRIPE_WIDTH  8
+#define DRAW_STRIPE_HEIGHT 6
+#define DRAW_STRIPE_PHASES 4
+
+extern const int8_t draw_sin_quarter[65];
+extern const uint8_t draw_stripe_sprites[DRAW_STRIPE_PHASES][DRAW_STRIPE_HEIGHT];
+
+static inline int8_t draw_sin(uint8_t angle) {
+    uint8_t step = angle & 63;
+    switch(angle >> 6) {
+    case 0:
+        return draw_sin_quarter[step];
+    case 1:
+        return draw_sin_quarter[64 - step];
+    case 2:
+        return -draw_sin_quarter[step];
+    default:
+        return -draw_sin_quarter[64 - step];
+    }
+}
+
+static inline int8_t draw_cos(uint8_t angle) {
+    return draw_sin(angle + 64);
+}
+
+// center + radius * cos(angle), truncated toward center like the float code
+static inline int draw_polar_x(int center, int radius, uint8_t angle) {
+    return center + radius * draw_cos(angle) / DRAW_TRIG_ONE;
+}
+
+static inline int draw_polar_y(int center, int radius, uint8_t angle) {
+    return center + radius * draw_sin(angle) / DRAW_TRIG_ONE;
+}
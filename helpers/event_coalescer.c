@@ -0,0 +1,46 @@
+// helpers/event_coalescer.c
+#include "event_coalescer.h"
+
+#include <furi.h>
+#include <string.h>
+
+void event_coalescer_init(EventCoalescer* coalescer, uint32_t interval) {
+    furi_check(coalescer);
+    memset(coalescer, 0, sizeof(EventCoalescer));
+    coalescer->interval = interval;
+}
+
+bool event_coalescer_post(EventCoalescer* coalescer, uint32_t latest, uint32_t now) {
+    furi_check(coalescer);
+    // Publish the counter before the flag, so whoever clears the flag sees it
+    __atomic_store_n(&coalescer->latest, latest, __ATOMIC_RELAXED);
+    __atomic_store_n(&coalescer->dirty, true, __ATOMIC_RELEASE);
+    coalescer->posts++;
+
+    // Anything inside the interval waits for the tick
+    if(now - coalescer->refreshed_at < coalescer->interval) return false;
+    return !__atomic_exchange_n(&coalescer->queued, true, __ATOMIC_ACQ_REL);
+}
+
+bool event_coalescer_flush(EventCoalescer* coalescer) {
+    furi_check(coalescer);
+    // The tick is already paced, a change older than one tick goes out now
+    if(!__atomic_load_n(&coalescer->dirty, __ATOMIC_ACQUIRE)) return false;
+    return !__atomic_exchange_n(&coalescer->queued, true, __ATOMIC_ACQ_REL);
+}
+
+bool event_coalescer_take(EventCoalescer* coalescer, uint32_t now, uint32_t* latest) {
+    furi_check(coalescer);
+    furi_check(latest);
+
+    // Clear queued first so a change landing while the handler runs gets its
+    // own event, then read and clear dirty in one step. A post that lands
+    // after the exchange leaves dirty set for the next tick's flush, so no
+    // change is ever left unshown
+    __atomic_store_n(&coalescer->queued, false, __ATOMIC_RELEASE);
+    if(!__atomic_exchange_n(&coalescer->dirty, false, __ATOMIC_ACQ_REL)) return false;
+    *latest = __atomic_load_n(&coalescer->latest, __ATOMIC_RELAXED);
+    coalescer->refreshed_at = now;
+    coalescer->refreshes++;
+    return true;
+}
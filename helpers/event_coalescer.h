@@ -0,0 +1,45 @@
+// helpers/event_coalescer.h
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Folds a burst of "something changed" notifications into one custom event
+// per frame interval. The producer posts the latest counter on every change;
+// only the first post of a quiet period sends an event, the rest are merged
+// and left for the scene's tick to flush. The handler takes the latest
+// counter when it runs, so nothing is lost, only redraws in between.
+// Pure bookkeeping like the burst filter: times are ticks in ms, and the
+// caller sends the event when told to.
+
+// The GUI doesn't get to draw more often than this anyway
+#define EVENT_COALESCER_FRAME_MS 100
+
+// The producer may be another thread than the handler: latest, dirty and
+// queued are only touched through atomic loads, stores and exchanges.
+typedef struct {
+    uint32_t interval;
+    uint32_t refreshed_at;
+    // Latest counter posted, read by the handler
+    uint32_t latest;
+    // A change the handler hasn't seen yet
+    bool dirty;
+    // An event is in the dispatcher queue
+    bool queued;
+    uint32_t posts;
+    uint32_t refreshes;
+} EventCoalescer;
+
+void event_coalescer_init(EventCoalescer* coalescer, uint32_t interval);
+
+// Record a change at time now. Returns true if the caller should send the
+// event now, false if it was merged into a pending refresh.
+bool event_coalescer_post(EventCoalescer* coalescer, uint32_t latest, uint32_t now);
+
+// Call from the scene tick. Returns true if a merged change still needs an
+// event, which the caller should send.
+bool event_coalescer_flush(EventCoalescer* coalescer);
+
+// Call from the event handler. Returns true if there is a change to show,
+// with the latest counter in *latest. A stale event returns false.
+bool event_coalescer_take(EventCoalescer* coalescer, uint32_t now, uint32_t* latest);
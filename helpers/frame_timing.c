@@ -0,0 +1,59 @@
+// helpers/frame_timing.c
+#include "frame_timing.h"
+
+static const char* const protopirate_frame_names[ProtoPirateFrameCount] = {
+    "Receiver",
+    "Sub Decode",
+    "Timing Tuner",
+};
+
+// Only ever written from the GUI thread
+static ProtoPirateFrameStats protopirate_frame_stats[ProtoPirateFrameCount];
+
+void protopirate_frame_end(ProtoPirateFrameView view, uint32_t start) {
+    furi_check(view < ProtoPirateFrameCount);
+    ProtoPirateFrameStats* stats = &protopirate_frame_stats[view];
+
+    uint32_t cycles = DWT->CYCCNT - start;
+    stats->frames++;
+    stats->total_cycles += cycles;
+    if(cycles > stats->max_cycles) stats->max_cycles = cycles;
+
+    if(cycles > PROTOPIRATE_FRAME_BUDGET_US * furi_hal_cortex_instructions_per_microsecond()) {
+        stats->over_budget++;
+        stats->lean_frames = PROTOPIRATE_FRAME_LEAN_FRAMES;
+    } else if(stats->lean_frames) {
+        stats->lean_frames--;
+    }
+}
+
+bool protopirate_frame_lean(ProtoPirateFrameView view) {
+    furi_check(view < ProtoPirateFrameCount);
+    return protopirate_frame_stats[view].lean_frames > 0;
+}
+
+void protopirate_frame_reset(void) {
+    memset(protopirate_frame_stats, 0, sizeof(protopirate_frame_stats));
+}
+
+void protopirate_frame_format(FuriString* output) {
+    furi_check(output);
+
+    uint32_t per_us = furi_hal_cortex_instructions_per_microsecond();
+    furi_string_cat_printf(
+        output, "Draw avg/max/>%luus:\n", (uint32_t)PROTOPIRATE_FRAME_BUDGET_US);
+    bool any = false;
+    for(size_t i = 0; i < ProtoPirateFrameCount; i++) {
+        const ProtoPirateFrameStats* stats = &protopirate_frame_stats[i];
+        if(!stats->frames) continue;
+        furi_string_cat_printf(
+            output,
+            " %s: %lu/%lu/%lu\n",
+            protopirate_frame_names[i],
+            (uint32_t)(stats->total_cycles / stats->frames / per_us),
+            stats->max_cycles / per_us,
+            stats->over_budget);
+        any = true;
+    }
+    if(!any) furi_string_cat_str(output, " none\n");
+}
@@ -0,0 +1,43 @@
+// helpers/frame_timing.h
+#pragma once
+
+#include <furi.h>
+#include <furi_hal.h>
+
+// Cost of each animated draw callback, measured on the GUI thread. A view
+// whose frame runs over PROTOPIRATE_FRAME_BUDGET_US draws lean (decorative
+// layers skipped) for the next PROTOPIRATE_FRAME_LEAN_FRAMES frames, so the
+// GUI keeps its share of the CPU while the decoders are busy.
+
+#define PROTOPIRATE_FRAME_BUDGET_US   2000
+#define PROTOPIRATE_FRAME_LEAN_FRAMES 8
+
+typedef enum {
+    ProtoPirateFrameReceiver,
+    ProtoPirateFrameSubDecode,
+    ProtoPirateFrameTimingTuner,
+    ProtoPirateFrameCount,
+} ProtoPirateFrameView;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t over_budget;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    // Frames left to draw lean after the last one over budget
+    uint8_t lean_frames;
+} ProtoPirateFrameStats;
+
+static inline uint32_t protopirate_frame_begin(void) {
+    return DWT->CYCCNT;
+}
+
+void protopirate_frame_end(ProtoPirateFrameView view, uint32_t start);
+
+// Skip the decorative layers this frame
+bool protopirate_frame_lean(ProtoPirateFrameView view);
+
+void protopirate_frame_reset(void);
+
+// Append "name: avg/max us, over" per view that drew
+void protopirate_frame_format(FuriString* output);
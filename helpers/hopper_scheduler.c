@@ -0,0 +1,204 @@
+// helpers/hopper_scheduler.c
+#include "hopper_scheduler.h"
+#include <string.h>
+
+// Score added per event; a decode is worth far more than a loud carrier,
+// which is only scored once per visit however long the hopper dwells on it
+#define HOPPER_SCORE_RSSI   1
+#define HOPPER_SCORE_DECODE 4
+
+const HopperSchedulerConfig hopper_scheduler_default_config = {
+    .base_dwell = 100,
+    .dwell_per_score = 50,
+    .max_dwell = 600,
+    .rssi_threshold = -90,
+    .rssi_hold = 1000,
+    .decode_hold = 1000,
+    .max_hold = 2000,
+    .max_revisit = 3000,
+    .decay_period = 10000,
+};
+
+// Active slots dwell up to this many times the base dwell
+#define HOPPER_DWELL_SCALE_MAX 6
+
+// Wrap-safe "a is at or after b"
+static inline bool hopper_time_reached(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) >= 0;
+}
+
+static size_t hopper_scheduler_clamp_count(size_t slot_count) {
+    return slot_count > HOPPER_SCHEDULER_MAX_SLOTS ? HOPPER_SCHEDULER_MAX_SLOTS : slot_count;
+}
+
+// Longest a visit can last before the hop is due: its dwell, or a hold
+static uint32_t hopper_scheduler_max_visit(const HopperSchedulerConfig* config) {
+    return config->max_hold > config->max_dwell ? config->max_hold : config->max_dwell;
+}
+
+void hopper_scheduler_config_for_dwell(
+    HopperSchedulerConfig* config,
+    uint32_t dwell,
+    size_t slot_count) {
+    *config = hopper_scheduler_default_config;
+    config->base_dwell = dwell;
+    config->dwell_per_score = dwell / 2;
+    config->max_dwell = dwell * HOPPER_DWELL_SCALE_MAX;
+    if(config->max_hold < config->max_dwell) config->max_hold = config->max_dwell;
+
+    // A cold slot waits for every other slot once, each followed by a
+    // return to the hottest slot
+    uint32_t sweep = hopper_scheduler_clamp_count(slot_count) *
+                     (config->base_dwell + hopper_scheduler_max_visit(config));
+    if(config->max_revisit < sweep) config->max_revisit = sweep;
+}
+
+uint32_t hopper_scheduler_revisit_bound(
+    const HopperSchedulerConfig* config,
+    size_t slot_count,
+    uint32_t tick_period) {
+    size_t count = hopper_scheduler_clamp_count(slot_count);
+    if(count < 2) return 0;
+
+    // A hop happens on the first tick after the visit is due
+    uint32_t visit = hopper_scheduler_max_visit(config) + tick_period;
+    return config->max_revisit + (count - 1) * visit;
+}
+
+static void hopper_scheduler_hold(HopperScheduler* scheduler, uint32_t until) {
+    uint32_t limit = scheduler->visit_start + scheduler->config.max_hold;
+    if(hopper_time_reached(until, limit)) until = limit;
+    if(hopper_time_reached(until, scheduler->dwell_until)) {
+        scheduler->dwell_until = until;
+    }
+}
+
+static void hopper_scheduler_add_score(HopperSchedulerSlot* slot, uint8_t amount) {
+    uint16_t score = slot->score + amount;
+    slot->score = score > HOPPER_SCHEDULER_SCORE_MAX ? HOPPER_SCHEDULER_SCORE_MAX : score;
+}
+
+static uint32_t hopper_scheduler_dwell(const HopperScheduler* scheduler, uint8_t index) {
+    const HopperSchedulerConfig* config = &scheduler->config;
+    uint32_t dwell = config->base_dwell + scheduler->slots[index].score * config->dwell_per_score;
+    return dwell > config->max_dwell ? config->max_dwell : dwell;
+}
+
+static void hopper_scheduler_decay(HopperScheduler* scheduler, uint32_t now) {
+    if(!scheduler->config.decay_period) return;
+
+    while(hopper_time_reached(now, scheduler->last_decay + scheduler->config.decay_period)) {
+        for(uint8_t i = 0; i < scheduler->count; i++) {
+            scheduler->slots[i].score >>= 1;
+        }
+        scheduler->last_decay += scheduler->config.decay_period;
+    }
+}
+
+static uint8_t hopper_scheduler_pick(HopperScheduler* scheduler, uint32_t now) {
+    uint8_t current = scheduler->current;
+
+    // Any slot left alone too long goes first, longest wait wins
+    uint8_t overdue = current;
+    uint32_t overdue_gap = 0;
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+        uint32_t gap = now - scheduler->slots[i].last_visit;
+        if(i != current && gap >= scheduler->config.max_revisit && gap >= overdue_gap) {
+            overdue = i;
+            overdue_gap = gap;
+        }
+    }
+    if(overdue != current) {
+        scheduler->from_sweep = false;
+        return overdue;
+    }
+
+    // After a sweep step, go back to the most active slot if there is one
+    if(scheduler->from_sweep) {
+        uint8_t hottest = current;
+        uint8_t hottest_score = 0;
+        for(uint8_t i = 0; i < scheduler->count; i++) {
+            if(i != current && scheduler->slots[i].score > hottest_score) {
+                hottest = i;
+                hottest_score = scheduler->slots[i].score;
+            }
+        }
+        if(hottest != current) {
+            scheduler->from_sweep = false;
+            return hottest;
+        }
+    }
+
+    // Otherwise continue the round-robin sweep
+    uint8_t next = scheduler->sweep;
+    do {
+        next = (next + 1) % scheduler->count;
+    } while(next == current);
+    scheduler->sweep = next;
+    scheduler->from_sweep = true;
+    return next;
+}
+
+void hopper_scheduler_init(
+    HopperScheduler* scheduler,
+    const HopperSchedulerConfig* config,
+    size_t slot_count,
+    uint32_t now) {
+    memset(scheduler, 0, sizeof(HopperScheduler));
+    scheduler->config = *config;
+    scheduler->count = hopper_scheduler_clamp_count(slot_count);
+
+    for(uint8_t i = 0; i < scheduler->count; i++) {
+        scheduler->slots[i].rssi_peak = INT8_MIN;
+        scheduler->slots[i].last_visit = now;
+    }
+
+    scheduler->from_sweep = true;
+    scheduler->last_decay = now;
+    scheduler->visit_start = now;
+    scheduler->dwell_until = now + scheduler->config.base_dwell;
+}
+
+void hopper_scheduler_on_rssi(HopperScheduler* scheduler, float rssi, uint32_t now) {
+    if(!scheduler->count) return;
+    HopperSchedulerSlot* slot = &scheduler->slots[scheduler->current];
+
+    int8_t dbm = rssi < INT8_MIN ? INT8_MIN : (rssi > 0.0f ? 0 : (int8_t)rssi);
+    if(dbm > slot->rssi_peak) slot->rssi_peak = dbm;
+
+    if(dbm > scheduler->config.rssi_threshold) {
+        slot->last_activity = now;
+        if(!scheduler->rssi_scored) {
+            scheduler->rssi_scored = true;
+            hopper_scheduler_add_score(slot, HOPPER_SCORE_RSSI);
+        }
+        hopper_scheduler_hold(scheduler, now + scheduler->config.rssi_hold);
+    }
+}
+
+void hopper_scheduler_on_decode(HopperScheduler* scheduler, uint32_t now) {
+    if(!scheduler->count) return;
+    HopperSchedulerSlot* slot = &scheduler->slots[scheduler->current];
+
+    if(slot->decode_hits < UINT16_MAX) slot->decode_hits++;
+    slot->last_activity = now;
+    hopper_scheduler_add_score(slot, HOPPER_SCORE_DECODE);
+    hopper_scheduler_hold(scheduler, now + scheduler->config.decode_hold);
+}
+
+bool hopper_scheduler_tick(HopperScheduler* scheduler, uint32_t now) {
+    if(scheduler->count < 2) return false;
+
+    hopper_scheduler_decay(scheduler, now);
+    scheduler->slots[scheduler->current].last_visit = now;
+
+    if(!hopper_time_reached(now, scheduler->dwell_until)) return false;
+
+    uint8_t next = hopper_scheduler_pick(scheduler, now);
+    scheduler->current = next;
+    scheduler->rssi_scored = false;
+    scheduler->slots[next].last_visit = now;
+    scheduler->visit_start = now;
+    scheduler->dwell_until = now + hopper_scheduler_dwell(scheduler, next);
+    return true;
+}
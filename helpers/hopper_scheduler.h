@@ -0,0 +1,107 @@
+// helpers/hopper_scheduler.h
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Activity-weighted frequency hopper. Pure bookkeeping: it never touches the
+// radio, it is told about RSSI samples and decodes and answers which hopper
+// slot to listen on next, so it can be driven by a simulated event source.
+// All times are in caller-defined units (the app uses milliseconds).
+
+#define HOPPER_SCHEDULER_MAX_SLOTS 16
+#define HOPPER_SCHEDULER_SCORE_MAX 15
+
+typedef struct {
+    // Minimum time spent on any slot
+    uint32_t base_dwell;
+    // Extra dwell per activity score point, and the cap on the total
+    uint32_t dwell_per_score;
+    uint32_t max_dwell;
+    // RSSI above this keeps the hopper on the slot for rssi_hold
+    int8_t rssi_threshold;
+    uint32_t rssi_hold;
+    // A decode keeps the hopper on the slot for decode_hold
+    uint32_t decode_hold;
+    // Holds never keep one visit longer than this, so a stuck carrier can't
+    // starve the other slots
+    uint32_t max_hold;
+    // A slot left alone this long goes before any other, so every slot is
+    // visited within hopper_scheduler_revisit_bound
+    uint32_t max_revisit;
+    // Activity scores halve once per this period
+    uint32_t decay_period;
+} HopperSchedulerConfig;
+
+typedef struct {
+    int8_t rssi_peak;
+    uint8_t score;
+    uint16_t decode_hits;
+    uint32_t last_activity;
+    uint32_t last_visit;
+} HopperSchedulerSlot;
+
+typedef struct {
+    HopperSchedulerConfig config;
+    HopperSchedulerSlot slots[HOPPER_SCHEDULER_MAX_SLOTS];
+    uint8_t count;
+    uint8_t current;
+    // Round-robin position, so cold slots keep being swept in order
+    uint8_t sweep;
+    // Current slot came from the sweep, so the next hop may return to the hottest
+    bool from_sweep;
+    // Current visit has already been scored for RSSI
+    bool rssi_scored;
+    uint32_t visit_start;
+    uint32_t dwell_until;
+    uint32_t last_decay;
+} HopperScheduler;
+
+// Defaults matching the old fixed hopper: 100ms per slot, 1s hold on signal
+extern const HopperSchedulerConfig hopper_scheduler_default_config;
+
+// The defaults scaled to a base dwell of dwell on slot_count slots. Active
+// slots stay up to 6x longer, holds may last as long as the longest dwell,
+// and max_revisit covers one sweep that alternates every cold slot with
+// the longest possible visit, so an ordinary sweep never runs overdue.
+void hopper_scheduler_config_for_dwell(
+    HopperSchedulerConfig* config,
+    uint32_t dwell,
+    size_t slot_count);
+
+// Longest any slot can go unvisited when hopper_scheduler_tick is called at
+// least every tick_period: max_revisit, then one longest visit for each
+// other slot that may have been overdue first.
+uint32_t hopper_scheduler_revisit_bound(
+    const HopperSchedulerConfig* config,
+    size_t slot_count,
+    uint32_t tick_period);
+
+// Start over with slot_count slots (clamped to HOPPER_SCHEDULER_MAX_SLOTS),
+// listening on slot 0 from now
+void hopper_scheduler_init(
+    HopperScheduler* scheduler,
+    const HopperSchedulerConfig* config,
+    size_t slot_count,
+    uint32_t now);
+
+// Feed an RSSI sample (dBm) taken on the current slot. Any number of loud
+// samples score a visit once, so only decodes build up a slot's score.
+void hopper_scheduler_on_rssi(HopperScheduler* scheduler, float rssi, uint32_t now);
+
+// Report a decoded frame on the current slot
+void hopper_scheduler_on_decode(HopperScheduler* scheduler, uint32_t now);
+
+// Advance time. Returns true when the radio should retune to the slot
+// returned by hopper_scheduler_current.
+bool hopper_scheduler_tick(HopperScheduler* scheduler, uint32_t now);
+
+static inline uint8_t hopper_scheduler_current(const HopperScheduler* scheduler) {
+    return scheduler->current;
+}
+
+static inline const HopperSchedulerSlot*
+    hopper_scheduler_slot(const HopperScheduler* scheduler, uint8_t index) {
+    return index < scheduler->count ? &scheduler->slots[index] : NULL;
+}
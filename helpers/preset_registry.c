@@ -0,0 +1,134 @@
+// helpers/preset_registry.c
+#include "preset_registry.h"
+
+#include <furi.h>
+#include <string.h>
+
+#define TAG "ProtoPiratePresets"
+
+typedef struct {
+    const char* furi_hal_name;
+    const char* setting_name;
+} PresetRegistryAlias;
+
+// Names the SubGhz app writes for its built in presets
+static const PresetRegistryAlias preset_registry_aliases[] = {
+    {"FuriHalSubGhzPresetOok270Async", "AM270"},
+    {"FuriHalSubGhzPresetOok650Async", "AM650"},
+    {"FuriHalSubGhzPreset2FSKDev238Async", "FM238"},
+    {"FuriHalSubGhzPreset2FSKDev12KAsync", "FM12K"},
+    {"FuriHalSubGhzPreset2FSKDev476Async", "FM476"},
+    {"FuriHalSubGhzPresetCustom", NULL},
+};
+
+// FNV-1a
+static uint32_t preset_registry_hash(const char* name) {
+    uint32_t hash = 2166136261UL;
+    while(*name) {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static size_t preset_registry_data_slot(const uint8_t* data) {
+    return ((uintptr_t)data >> 2) * 2654435761UL % PRESET_REGISTRY_DATA_SLOTS;
+}
+
+static const PresetRegistryNameSlot*
+    preset_registry_lookup(const PresetRegistry* registry, const char* name, uint32_t hash) {
+    size_t slot = hash % PRESET_REGISTRY_NAME_SLOTS;
+    for(size_t probe = 0; probe < PRESET_REGISTRY_NAME_SLOTS; probe++) {
+        const PresetRegistryNameSlot* entry = &registry->names[slot];
+        if(!entry->name) break;
+        if(entry->hash == hash && !strcmp(entry->name, name)) return entry;
+        slot = (slot + 1) % PRESET_REGISTRY_NAME_SLOTS;
+    }
+    return NULL;
+}
+
+static void
+    preset_registry_add_name(PresetRegistry* registry, const char* name, uint8_t index) {
+    uint32_t hash = preset_registry_hash(name);
+    // First one wins, like the scans this replaces
+    if(preset_registry_lookup(registry, name, hash)) return;
+
+    size_t slot = hash % PRESET_REGISTRY_NAME_SLOTS;
+    while(registry->names[slot].name) {
+        slot = (slot + 1) % PRESET_REGISTRY_NAME_SLOTS;
+    }
+    registry->names[slot] = (PresetRegistryNameSlot){name, hash, index};
+}
+
+void preset_registry_build(PresetRegistry* registry, SubGhzSetting* setting) {
+    furi_check(registry);
+    furi_check(setting);
+    memset(registry, 0, sizeof(PresetRegistry));
+    registry->setting = setting;
+
+    size_t count = subghz_setting_get_preset_count(setting);
+    if(count > PRESET_REGISTRY_MAX) {
+        FURI_LOG_W(TAG, "%zu presets, only the first %d are indexed", count, PRESET_REGISTRY_MAX);
+        count = PRESET_REGISTRY_MAX;
+    }
+    registry->count = count;
+
+    // Both tables stay under half full, so no probe run gets long
+    for(uint8_t i = 0; i < registry->count; i++) {
+        preset_registry_add_name(registry, subghz_setting_get_preset_name(setting, i), i);
+
+        const uint8_t* data = subghz_setting_get_preset_data(setting, i);
+        if(!data) continue;
+        size_t slot = preset_registry_data_slot(data);
+        while(registry->data[slot].data) {
+            slot = (slot + 1) % PRESET_REGISTRY_DATA_SLOTS;
+        }
+        registry->data[slot] = (PresetRegistryDataSlot){data, i};
+    }
+
+    for(size_t i = 0; i < COUNT_OF(preset_registry_aliases); i++) {
+        const PresetRegistryAlias* alias = &preset_registry_aliases[i];
+        uint8_t index = PRESET_REGISTRY_CUSTOM;
+        if(alias->setting_name) {
+            index = preset_registry_find(registry, alias->setting_name);
+            if(index == PRESET_REGISTRY_NONE) continue;
+        }
+        preset_registry_add_name(registry, alias->furi_hal_name, index);
+    }
+}
+
+uint8_t preset_registry_find(const PresetRegistry* registry, const char* name) {
+    furi_check(registry);
+    if(!name) return PRESET_REGISTRY_NONE;
+
+    const PresetRegistryNameSlot* entry =
+        preset_registry_lookup(registry, name, preset_registry_hash(name));
+    return entry ? entry->index : PRESET_REGISTRY_NONE;
+}
+
+uint8_t preset_registry_find_data(const PresetRegistry* registry, const uint8_t* data) {
+    furi_check(registry);
+    if(!data) return PRESET_REGISTRY_NONE;
+
+    size_t slot = preset_registry_data_slot(data);
+    for(size_t probe = 0; probe < PRESET_REGISTRY_DATA_SLOTS; probe++) {
+        const PresetRegistryDataSlot* entry = &registry->data[slot];
+        if(!entry->data) break;
+        if(entry->data == data) return entry->index;
+        slot = (slot + 1) % PRESET_REGISTRY_DATA_SLOTS;
+    }
+    return PRESET_REGISTRY_NONE;
+}
+
+const char* preset_registry_short_name(const PresetRegistry* registry, const char* name) {
+    uint8_t index = preset_registry_find(registry, name);
+    if(index == PRESET_REGISTRY_CUSTOM) return PRESET_REGISTRY_CUSTOM_NAME;
+    if(!preset_registry_is_valid(registry, index)) return NULL;
+    return subghz_setting_get_preset_name(registry->setting, index);
+}
+
+uint8_t* preset_registry_get_data(const PresetRegistry* registry, const char* name) {
+    uint8_t index = preset_registry_find(registry, name);
+    if(!preset_registry_is_valid(registry, index)) return NULL;
+    return subghz_setting_get_preset_data(registry->setting, index);
+}
@@ -0,0 +1,61 @@
+// helpers/preset_registry.h
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <lib/subghz/subghz_setting.h>
+
+// Preset lookups built once from SubGhzSetting. A preset is found by its
+// setting name ("AM650"), by the FuriHal name .sub files carry
+// ("FuriHalSubGhzPresetOok650Async") or by its data pointer, each through a
+// small hash table, so resolving one costs a hash and one compare instead of
+// a scan over every preset name.
+
+#define PRESET_REGISTRY_MAX        32
+#define PRESET_REGISTRY_NAME_SLOTS 64
+#define PRESET_REGISTRY_DATA_SLOTS 64
+#define PRESET_REGISTRY_NONE       UINT8_MAX
+// FuriHalSubGhzPresetCustom: the register values travel in the file itself
+#define PRESET_REGISTRY_CUSTOM      (UINT8_MAX - 1)
+#define PRESET_REGISTRY_CUSTOM_NAME "Custom"
+
+typedef struct {
+    const char* name;
+    uint32_t hash;
+    uint8_t index;
+} PresetRegistryNameSlot;
+
+typedef struct {
+    const uint8_t* data;
+    uint8_t index;
+} PresetRegistryDataSlot;
+
+typedef struct {
+    SubGhzSetting* setting;
+    uint8_t count;
+    // Open addressing, a NULL key marks a free slot
+    PresetRegistryNameSlot names[PRESET_REGISTRY_NAME_SLOTS];
+    PresetRegistryDataSlot data[PRESET_REGISTRY_DATA_SLOTS];
+} PresetRegistry;
+
+// Index every preset setting holds, plus the FuriHal names of the ones it
+// has. Call again after setting is reloaded.
+void preset_registry_build(PresetRegistry* registry, SubGhzSetting* setting);
+
+// Setting index for a setting or FuriHal name, PRESET_REGISTRY_CUSTOM for
+// the FuriHal custom preset, PRESET_REGISTRY_NONE when unknown
+uint8_t preset_registry_find(const PresetRegistry* registry, const char* name);
+
+// Setting index owning data, PRESET_REGISTRY_NONE for data from elsewhere
+uint8_t preset_registry_find_data(const PresetRegistry* registry, const uint8_t* data);
+
+// Setting name for a setting or FuriHal name, NULL when unknown
+const char* preset_registry_short_name(const PresetRegistry* registry, const char* name);
+
+// Register values for a setting or FuriHal name, NULL when unknown or custom
+uint8_t* preset_registry_get_data(const PresetRegistry* registry, const char* name);
+
+static inline bool preset_registry_is_valid(const PresetRegistry* registry, uint8_t index) {
+    return index < registry->count;
+}
@@ -0,0 +1,153 @@
+// helpers/protopirate_heap.c
+#include "protopirate_heap.h"
+
+#define TAG "ProtoPirateHeap"
+
+static const char* const protopirate_heap_names[ProtoPirateHeapCount] = {
+    [ProtoPirateHeapViews] = "Views",
+    [ProtoPirateHeapDecoders] = "Decoders",
+    [ProtoPirateHeapHistory] = "History",
+    [ProtoPirateHeapRawReader] = "RAW reader",
+    [ProtoPirateHeapStorage] = "Storage",
+    [ProtoPirateHeapSceneArena] = "Scene arena",
+};
+
+static struct {
+    ProtoPirateHeapAccount accounts[ProtoPirateHeapCount];
+    ProtoPirateHeapSample samples[PROTOPIRATE_HEAP_SAMPLES];
+    uint8_t sample_count;
+    uint32_t sample_interval_ms;
+    uint32_t last_sample_tick;
+    // Lowest free heap seen here, the kernel's own minimum covers since boot
+    size_t free_min;
+} protopirate_heap;
+
+static void protopirate_heap_note_free(size_t free) {
+    FURI_CRITICAL_ENTER();
+    if(!protopirate_heap.free_min || free < protopirate_heap.free_min) {
+        protopirate_heap.free_min = free;
+    }
+    FURI_CRITICAL_EXIT();
+}
+
+void* protopirate_heap_alloc(ProtoPirateHeapSubsystem subsystem, size_t size) {
+    furi_check(subsystem < ProtoPirateHeapCount);
+    void* block = malloc(size);
+
+    ProtoPirateHeapAccount* account = &protopirate_heap.accounts[subsystem];
+    FURI_CRITICAL_ENTER();
+    account->bytes += size;
+    account->allocs++;
+    if(account->bytes > account->peak) account->peak = account->bytes;
+    FURI_CRITICAL_EXIT();
+    return block;
+}
+
+void protopirate_heap_free(ProtoPirateHeapSubsystem subsystem, void* block, size_t size) {
+    furi_check(subsystem < ProtoPirateHeapCount);
+    if(!block) return;
+    free(block);
+
+    ProtoPirateHeapAccount* account = &protopirate_heap.accounts[subsystem];
+    FURI_CRITICAL_ENTER();
+    account->bytes -= size;
+    account->frees++;
+    FURI_CRITICAL_EXIT();
+}
+
+// Free heap plus the exact bytes already charged, so exact charges made
+// between mark and settle cancel out of the approximate figure
+static int32_t protopirate_heap_level(ProtoPirateHeapSubsystem subsystem, size_t free) {
+    return (int32_t)free + protopirate_heap.accounts[subsystem].bytes;
+}
+
+int32_t protopirate_heap_mark(ProtoPirateHeapSubsystem subsystem) {
+    furi_check(subsystem < ProtoPirateHeapCount);
+    return protopirate_heap_level(subsystem, memmgr_get_free_heap());
+}
+
+void protopirate_heap_settle(ProtoPirateHeapSubsystem subsystem, int32_t mark) {
+    furi_check(subsystem < ProtoPirateHeapCount);
+
+    size_t free = memmgr_get_free_heap();
+    FURI_CRITICAL_ENTER();
+    protopirate_heap.accounts[subsystem].approx += mark - protopirate_heap_level(subsystem, free);
+    FURI_CRITICAL_EXIT();
+    protopirate_heap_note_free(free);
+}
+
+void protopirate_heap_sample(void) {
+    uint32_t now = furi_get_tick();
+    if(!protopirate_heap.sample_interval_ms) {
+        protopirate_heap.sample_interval_ms = PROTOPIRATE_HEAP_SAMPLE_MS;
+    } else if(
+        protopirate_heap.sample_count &&
+        now - protopirate_heap.last_sample_tick <
+            furi_ms_to_ticks(protopirate_heap.sample_interval_ms)) {
+        return;
+    }
+
+    if(protopirate_heap.sample_count == PROTOPIRATE_HEAP_SAMPLES) {
+        // Keep every other sample at twice the interval
+        for(size_t i = 0; i < PROTOPIRATE_HEAP_SAMPLES / 2; i++) {
+            protopirate_heap.samples[i] = protopirate_heap.samples[i * 2 + 1];
+        }
+        protopirate_heap.sample_count = PROTOPIRATE_HEAP_SAMPLES / 2;
+        protopirate_heap.sample_interval_ms *= 2;
+    }
+
+    ProtoPirateHeapSample* sample = &protopirate_heap.samples[protopirate_heap.sample_count++];
+    sample->free = memmgr_get_free_heap();
+    sample->max_block = memmgr_heap_get_max_free_block();
+    protopirate_heap.last_sample_tick = now;
+    protopirate_heap_note_free(sample->free);
+}
+
+void protopirate_heap_reset_trend(void) {
+    protopirate_heap.sample_count = 0;
+    protopirate_heap.sample_interval_ms = PROTOPIRATE_HEAP_SAMPLE_MS;
+    protopirate_heap.free_min = 0;
+    protopirate_heap_sample();
+}
+
+void protopirate_heap_format(FuriString* output) {
+    furi_check(output);
+
+    size_t free = memmgr_get_free_heap();
+    protopirate_heap_note_free(free);
+
+    furi_string_printf(
+        output,
+        "Free: %zu of %zu\n"
+        "Min: %zu (boot %zu)\n"
+        "Max block: %zu\n"
+        "Subsystem: bytes/peak\n"
+        " allocs/frees, ~SDK objects\n",
+        free,
+        memmgr_get_total_heap(),
+        protopirate_heap.free_min,
+        memmgr_get_minimum_free_heap(),
+        memmgr_heap_get_max_free_block());
+
+    for(size_t i = 0; i < ProtoPirateHeapCount; i++) {
+        FURI_CRITICAL_ENTER();
+        ProtoPirateHeapAccount account = protopirate_heap.accounts[i];
+        FURI_CRITICAL_EXIT();
+        furi_string_cat_printf(
+            output,
+            " %s: %ld/%ld\n  %lu/%lu, ~%+ld\n",
+            protopirate_heap_names[i],
+            account.bytes,
+            account.peak,
+            account.allocs,
+            account.frees,
+            account.approx);
+    }
+
+    furi_string_cat_printf(
+        output, "Free/block every %lus:\n", protopirate_heap.sample_interval_ms / 1000);
+    for(size_t i = 0; i < protopirate_heap.sample_count; i++) {
+        const ProtoPirateHeapSample* sample = &protopirate_heap.samples[i];
+        furi_string_cat_printf(output, " %lu/%lu\n", sample->free, sample->max_block);
+    }
+}
@@ -0,0 +1,73 @@
+// helpers/protopirate_heap.h
+#pragma once
+
+#include <furi.h>
+
+// Heap accounting per subsystem. The allocator can't be hooked from an app,
+// so there are two kinds of figure:
+//
+// - Exact: blocks a subsystem allocates itself go through
+//   protopirate_heap_alloc / protopirate_heap_free, which count every
+//   allocation and free and the bytes requested.
+// - Approximate: SDK objects (strings, FlipperFormat, views, the receiver)
+//   are bracketed with protopirate_heap_mark / protopirate_heap_settle and
+//   charged the change in global free heap in between, less the exact
+//   charges made meanwhile. Other threads allocating at the same time land
+//   in that change, so these are deltas for spotting leaks and growth only.
+//
+// Accounts are updated inside a critical section, so concurrent updates
+// from the worker, radio and GUI threads are never lost.
+//
+// Free heap and the largest free block are also sampled into a trend that
+// halves its resolution whenever it fills up, so it always spans the whole
+// session. The largest block is what decides whether an allocation fails.
+
+#define PROTOPIRATE_HEAP_SAMPLES   24
+#define PROTOPIRATE_HEAP_SAMPLE_MS 5000
+
+typedef enum {
+    ProtoPirateHeapViews,
+    ProtoPirateHeapDecoders,
+    ProtoPirateHeapHistory,
+    ProtoPirateHeapRawReader,
+    ProtoPirateHeapStorage,
+    ProtoPirateHeapSceneArena,
+    ProtoPirateHeapCount,
+} ProtoPirateHeapSubsystem;
+
+typedef struct {
+    // Exact: bytes held in blocks from protopirate_heap_alloc, and the
+    // allocations and frees that moved them
+    int32_t bytes;
+    int32_t peak;
+    uint32_t allocs;
+    uint32_t frees;
+    // Approximate: sum of the free heap deltas of every settle
+    int32_t approx;
+} ProtoPirateHeapAccount;
+
+typedef struct {
+    uint32_t free;
+    uint32_t max_block;
+} ProtoPirateHeapSample;
+
+// malloc charged to subsystem. Free with protopirate_heap_free and the same
+// size.
+void* protopirate_heap_alloc(ProtoPirateHeapSubsystem subsystem, size_t size);
+void protopirate_heap_free(ProtoPirateHeapSubsystem subsystem, void* block, size_t size);
+
+// Start an approximate charge to subsystem
+int32_t protopirate_heap_mark(ProtoPirateHeapSubsystem subsystem);
+
+// Charge subsystem with whatever the heap gained or lost since mark, less
+// its exact charges in between
+void protopirate_heap_settle(ProtoPirateHeapSubsystem subsystem, int32_t mark);
+
+// Take a trend sample if one is due. Cheap to call often.
+void protopirate_heap_sample(void);
+
+// Start a new trend and minimum, keeping the per subsystem balances
+void protopirate_heap_reset_trend(void);
+
+// Human readable summary for the memory page
+void protopirate_heap_format(FuriString* output);
@@ -0,0 +1,319 @@
+// helpers/protopirate_rx_metrics.c
+#include "protopirate_rx_metrics.h"
+#include "../protocols/protocol_items.h"
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "ProtoPirateRxMetrics"
+
+#define METRICS_FILE_HEADER  "ProtoPirate RX Metrics"
+#define METRICS_FILE_VERSION 1
+
+void protopirate_rx_metrics_reset(ProtoPirateRxMetrics* metrics) {
+    furi_check(metrics);
+    memset(metrics, 0, sizeof(ProtoPirateRxMetrics));
+    metrics->started_tick = furi_get_tick();
+}
+
+static uint32_t protopirate_rx_metrics_avg_us(const ProtoPirateRxTiming* timing) {
+    if(!timing->calls) return 0;
+    return timing->total_cycles / timing->calls / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static uint32_t protopirate_rx_metrics_max_us(const ProtoPirateRxTiming* timing) {
+    return timing->max_cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static uint32_t protopirate_rx_metrics_gap_avg_us(const ProtoPirateRxMetrics* metrics) {
+    if(!metrics->overruns) return 0;
+    return metrics->overrun_gap_total_us / metrics->overruns;
+}
+
+// Decoder time not spent on repeats, at the average feed cost
+static uint32_t protopirate_rx_metrics_saved_ms(const ProtoPirateRxMetrics* metrics) {
+    return (uint64_t)metrics->pulses_suppressed * protopirate_rx_metrics_avg_us(&metrics->feed) /
+           1000;
+}
+
+static uint32_t protopirate_rx_metrics_uptime_s(const ProtoPirateRxMetrics* metrics) {
+    return (furi_get_tick() - metrics->started_tick) / furi_kernel_get_tick_frequency();
+}
+
+void protopirate_rx_metrics_feed_decoders(
+    ProtoPirateFeedStats stats[ProtoPirateProtocolIdCount],
+    SubGhzProtocolDecoderBase* const decoders[ProtoPirateProtocolIdCount],
+    bool level,
+    uint32_t duration) {
+    uint32_t budget = PROTOPIRATE_FEED_BUDGET_US * furi_hal_cortex_instructions_per_microsecond();
+
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        SubGhzProtocolDecoderBase* decoder = decoders[i];
+        if(!decoder) continue;
+        uint32_t start = protopirate_rx_metrics_now();
+        decoder->protocol->decoder->feed(decoder, level, duration);
+        protopirate_rx_metrics_feed_add(&stats[i], DWT->CYCCNT - start, budget);
+    }
+}
+
+uint32_t protopirate_rx_metrics_feed_p99_us(const ProtoPirateFeedStats* stats) {
+    furi_check(stats);
+    if(!stats->calls) return 0;
+
+    uint32_t tail = stats->calls / 100;
+    uint32_t seen = 0;
+    uint32_t cycles = stats->max_cycles;
+    for(size_t bucket = PROTOPIRATE_FEED_BUCKETS; bucket-- > 0;) {
+        seen += stats->histogram[bucket];
+        if(seen > tail) {
+            uint32_t top = 1UL << (bucket + PROTOPIRATE_FEED_BUCKET_SHIFT);
+            if(top < cycles) cycles = top;
+            break;
+        }
+    }
+    return cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+uint32_t protopirate_rx_metrics_feed_max_us(const ProtoPirateFeedStats* stats) {
+    furi_check(stats);
+    return stats->max_cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+void protopirate_rx_metrics_format_feed(
+    const ProtoPirateFeedStats stats[ProtoPirateProtocolIdCount],
+    FuriString* output) {
+    furi_check(stats);
+    furi_check(output);
+
+    furi_string_cat_printf(output, "Feed max/p99/>%luus:\n", (uint32_t)PROTOPIRATE_FEED_BUDGET_US);
+    bool any = false;
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        if(!stats[i].calls) continue;
+        furi_string_cat_printf(
+            output,
+            " %s: %lu/%lu/%lu\n",
+            protopirate_protocol_name(i),
+            protopirate_rx_metrics_feed_max_us(&stats[i]),
+            protopirate_rx_metrics_feed_p99_us(&stats[i]),
+            stats[i].over_budget);
+        any = true;
+    }
+    if(!any) furi_string_cat_str(output, " none\n");
+}
+
+static void protopirate_rx_metrics_cat_span(
+    FuriString* output,
+    const char* label,
+    uint32_t from,
+    uint32_t to) {
+    if(from && to) {
+        furi_string_cat_printf(output, " %s: %lu\n", label, to - from);
+    } else {
+        furi_string_cat_printf(output, " %s: -\n", label);
+    }
+}
+
+void protopirate_rx_metrics_format_startup(
+    const ProtoPirateStartupTimes* startup,
+    FuriString* output) {
+    furi_check(startup);
+    furi_check(output);
+
+    uint32_t start = startup->app_start;
+    furi_string_cat_str(output, "Startup ms:\n");
+    protopirate_rx_metrics_cat_span(output, "First frame", start, startup->first_frame);
+    protopirate_rx_metrics_cat_span(output, "Settings", start, startup->setting_ready);
+    protopirate_rx_metrics_cat_span(output, "Keystore", start, startup->keystore_ready);
+    protopirate_rx_metrics_cat_span(output, "Radio init", start, startup->radio_ready);
+    protopirate_rx_metrics_cat_span(output, "RX to 1st", startup->rx_start, startup->first_pulse);
+}
+
+void protopirate_rx_metrics_format(const ProtoPirateRxMetrics* metrics, FuriString* output) {
+    furi_check(metrics);
+    furi_check(output);
+
+    uint32_t uptime = protopirate_rx_metrics_uptime_s(metrics);
+
+    furi_string_printf(
+        output,
+        "Uptime: %lus\n"
+        "Pulses: %lu (%lu/s)\n"
+        "Overruns: %lu Resets: %lu\n"
+        "Lost frames: %lu\n"
+        "Gap: avg %luus max %luus\n"
+        "Duplicates: %lu\n"
+        "Repeats: %lu (%lu pulses)\n"
+        "Saved: ~%lums\n"
+        "Arbitration: %lu lost %lu reset\n"
+        "Feed: avg %luus max %luus\n"
+        "RX cb: %lu avg %luus max %luus\n"
+        "Decodes:\n",
+        uptime,
+        metrics->pulses,
+        uptime ? metrics->pulses / uptime : metrics->pulses,
+        metrics->overruns,
+        metrics->receiver_resets,
+        metrics->lost_frames,
+        protopirate_rx_metrics_gap_avg_us(metrics),
+        metrics->overrun_gap_max_us,
+        metrics->duplicates,
+        metrics->repeats_suppressed,
+        metrics->pulses_suppressed,
+        protopirate_rx_metrics_saved_ms(metrics),
+        metrics->arbitration_losses,
+        metrics->early_resets,
+        protopirate_rx_metrics_avg_us(&metrics->feed),
+        protopirate_rx_metrics_max_us(&metrics->feed),
+        metrics->rx_callback.calls,
+        protopirate_rx_metrics_avg_us(&metrics->rx_callback),
+        protopirate_rx_metrics_max_us(&metrics->rx_callback));
+
+    bool any = false;
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        if(!metrics->decodes[i]) continue;
+        furi_string_cat_printf(
+            output, " %s: %lu\n", protopirate_protocol_name(i), metrics->decodes[i]);
+        any = true;
+    }
+    if(!any) furi_string_cat_str(output, " none\n");
+
+    furi_string_cat_str(output, "Latency avg/max:\n");
+    any = false;
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        const ProtoPirateRxTiming* latency = &metrics->latency[i];
+        if(!latency->calls) continue;
+        furi_string_cat_printf(
+            output,
+            " %s: %lu/%luus\n",
+            protopirate_protocol_name(i),
+            protopirate_rx_metrics_avg_us(latency),
+            protopirate_rx_metrics_max_us(latency));
+        any = true;
+    }
+    if(!any) furi_string_cat_str(output, " none\n");
+
+    protopirate_rx_metrics_format_feed(metrics->decoder_feed, output);
+}
+
+bool protopirate_rx_metrics_save(const ProtoPirateRxMetrics* metrics, FuriString* out_path) {
+    furi_check(metrics);
+    furi_check(out_path);
+
+    DateTime date_time;
+    furi_hal_rtc_get_datetime(&date_time);
+    furi_string_printf(
+        out_path,
+        "%s/rx_%.4d%.2d%.2d_%.2d%.2d%.2d.txt",
+        PROTOPIRATE_METRICS_FOLDER,
+        date_time.year,
+        date_time.month,
+        date_time.day,
+        date_time.hour,
+        date_time.minute,
+        date_time.second);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, PROTOPIRATE_METRICS_FOLDER);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_always(ff, furi_string_get_cstr(out_path))) {
+            FURI_LOG_E(TAG, "Failed to open metrics file");
+            break;
+        }
+        if(!flipper_format_write_header_cstr(ff, METRICS_FILE_HEADER, METRICS_FILE_VERSION)) {
+            break;
+        }
+
+        uint32_t values[] = {
+            protopirate_rx_metrics_uptime_s(metrics),
+            metrics->pulses,
+            metrics->overruns,
+            metrics->receiver_resets,
+            metrics->lost_frames,
+            protopirate_rx_metrics_gap_avg_us(metrics),
+            metrics->overrun_gap_max_us,
+            metrics->duplicates,
+            metrics->repeats_suppressed,
+            metrics->pulses_suppressed,
+            protopirate_rx_metrics_saved_ms(metrics),
+            metrics->arbitration_losses,
+            metrics->early_resets,
+            metrics->feed.calls,
+            protopirate_rx_metrics_avg_us(&metrics->feed),
+            protopirate_rx_metrics_max_us(&metrics->feed),
+            metrics->rx_callback.calls,
+            protopirate_rx_metrics_avg_us(&metrics->rx_callback),
+            protopirate_rx_metrics_max_us(&metrics->rx_callback),
+        };
+        const char* keys[] = {
+            "Uptime",
+            "Pulses",
+            "Overruns",
+            "Resets",
+            "LostFrames",
+            "OverrunGapAvgUs",
+            "OverrunGapMaxUs",
+            "Duplicates",
+            "RepeatBursts",
+            "RepeatPulses",
+            "RepeatSavedMs",
+            "ArbitrationLosses",
+            "EarlyResets",
+            "FeedCalls",
+            "FeedAvgUs",
+            "FeedMaxUs",
+            "RxCallbackCalls",
+            "RxCallbackAvgUs",
+            "RxCallbackMaxUs",
+        };
+
+        bool written = true;
+        for(size_t i = 0; i < COUNT_OF(keys) && written; i++) {
+            written = flipper_format_write_uint32(ff, keys[i], &values[i], 1);
+        }
+        // One line per protocol, in registry order, so dumps diff cleanly
+        for(size_t i = 0; i < ProtoPirateProtocolIdCount && written; i++) {
+            written = flipper_format_write_uint32(
+                ff, protopirate_protocol_name(i), &metrics->decodes[i], 1);
+        }
+        // Then avg and max latency per protocol, same order
+        FuriString* key = furi_string_alloc();
+        for(size_t i = 0; i < ProtoPirateProtocolIdCount && written; i++) {
+            uint32_t latency[] = {
+                protopirate_rx_metrics_avg_us(&metrics->latency[i]),
+                protopirate_rx_metrics_max_us(&metrics->latency[i]),
+            };
+            furi_string_printf(key, "%s LatencyUs", protopirate_protocol_name(i));
+            written = flipper_format_write_uint32(
+                ff, furi_string_get_cstr(key), latency, COUNT_OF(latency));
+        }
+        // Feed max, p99 and over budget count, then the raw histogram
+        for(size_t i = 0; i < ProtoPirateProtocolIdCount && written; i++) {
+            const ProtoPirateFeedStats* stats = &metrics->decoder_feed[i];
+            uint32_t feed[] = {
+                protopirate_rx_metrics_feed_max_us(stats),
+                protopirate_rx_metrics_feed_p99_us(stats),
+                stats->over_budget,
+            };
+            furi_string_printf(key, "%s FeedUs", protopirate_protocol_name(i));
+            written = flipper_format_write_uint32(
+                ff, furi_string_get_cstr(key), feed, COUNT_OF(feed));
+            if(!written) break;
+            furi_string_printf(key, "%s FeedHistogram", protopirate_protocol_name(i));
+            written = flipper_format_write_uint32(
+                ff, furi_string_get_cstr(key), stats->histogram, PROTOPIRATE_FEED_BUCKETS);
+        }
+        furi_string_free(key);
+        if(!written) {
+            FURI_LOG_E(TAG, "Failed to write metrics");
+            break;
+        }
+
+        result = true;
+    } while(false);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
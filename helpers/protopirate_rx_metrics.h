@@ -0,0 +1,139 @@
+// helpers/protopirate_rx_metrics.h
+#pragma once
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <defines.h>
+#include <lib/subghz/protocols/base.h>
+
+#include "../protocols/protocol_ids.h"
+
+#ifdef BUILD_MAIN_APP
+#define PROTOPIRATE_METRICS_FOLDER APP_DATA_PATH("diagnostics")
+#else
+#define PROTOPIRATE_METRICS_FOLDER "/ext/apps_data/proto_pirate/diagnostics"
+#endif
+
+// Counters for the receive pipeline. Written from the worker and radio timer
+// threads without locking: a rare lost increment is fine for diagnostics.
+
+typedef struct {
+    uint32_t calls;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+} ProtoPirateRxTiming;
+
+// Per decoder feed cost as a log2 histogram of cycles: bucket 0 holds calls
+// under 2^PROTOPIRATE_FEED_BUCKET_SHIFT cycles, every next bucket is twice as
+// wide as the one before and the last one is open ended
+#define PROTOPIRATE_FEED_BUCKETS      16
+#define PROTOPIRATE_FEED_BUCKET_SHIFT 7
+// A feed slower than a short pulse lets the worker fall behind the air
+#define PROTOPIRATE_FEED_BUDGET_US    250
+
+typedef struct {
+    uint32_t calls;
+    uint32_t max_cycles;
+    uint32_t over_budget;
+    uint32_t histogram[PROTOPIRATE_FEED_BUCKETS];
+} ProtoPirateFeedStats;
+
+typedef struct {
+    uint32_t started_tick;
+    uint32_t pulses;
+    uint32_t overruns;
+    // Partial frames thrown away by overrun recovery
+    uint32_t lost_frames;
+    // Time from the last pulse fed to the overrun, bounding the dropped stretch
+    uint32_t overrun_gap_max_us;
+    uint64_t overrun_gap_total_us;
+    uint32_t last_pulse_cycles;
+    // Arrival of the pulse the worker is handling, where decode latency starts
+    uint32_t pulse_cycles;
+    uint32_t receiver_resets;
+    uint32_t duplicates;
+    // Repeat bursts dropped ahead of the decoders, and the pulses they held
+    uint32_t repeats_suppressed;
+    uint32_t pulses_suppressed;
+    // Decodes beaten by a better one on the same burst, and decoders reset
+    // once a burst was settled
+    uint32_t arbitration_losses;
+    uint32_t early_resets;
+    uint32_t decodes[ProtoPirateProtocolIdCount];
+    ProtoPirateRxTiming feed;
+    ProtoPirateRxTiming rx_callback;
+    // Per protocol, from the pulse that completed a frame to the frame being
+    // in history with the view told about it
+    ProtoPirateRxTiming latency[ProtoPirateProtocolIdCount];
+    ProtoPirateFeedStats decoder_feed[ProtoPirateProtocolIdCount];
+} ProtoPirateRxMetrics;
+
+// Startup milestones as furi ticks, 0 until reached. Not part of the
+// counters above, a metrics reset leaves them alone.
+typedef struct {
+    uint32_t app_start;
+    uint32_t first_frame;
+    uint32_t setting_ready;
+    uint32_t keystore_ready;
+    uint32_t radio_ready;
+    // First receiver RX start and the first pulse the worker handed over
+    uint32_t rx_start;
+    uint32_t first_pulse;
+} ProtoPirateStartupTimes;
+
+void protopirate_rx_metrics_reset(ProtoPirateRxMetrics* metrics);
+
+// Cycle counter snapshot for protopirate_rx_metrics_timing_add
+static inline uint32_t protopirate_rx_metrics_now(void) {
+    return DWT->CYCCNT;
+}
+
+static inline void protopirate_rx_metrics_timing_add(ProtoPirateRxTiming* timing, uint32_t start) {
+    uint32_t cycles = DWT->CYCCNT - start;
+    timing->calls++;
+    timing->total_cycles += cycles;
+    if(cycles > timing->max_cycles) timing->max_cycles = cycles;
+}
+
+static inline void protopirate_rx_metrics_feed_add(
+    ProtoPirateFeedStats* stats,
+    uint32_t cycles,
+    uint32_t budget) {
+    uint32_t bucket = cycles >> PROTOPIRATE_FEED_BUCKET_SHIFT ?
+                          32 - __builtin_clz(cycles) - PROTOPIRATE_FEED_BUCKET_SHIFT :
+                          0;
+    if(bucket >= PROTOPIRATE_FEED_BUCKETS) bucket = PROTOPIRATE_FEED_BUCKETS - 1;
+    stats->histogram[bucket]++;
+    stats->calls++;
+    if(cycles > stats->max_cycles) stats->max_cycles = cycles;
+    if(cycles > budget) stats->over_budget++;
+}
+
+// Feed one pulse to each decoder (indexed by protocol id, NULL skipped),
+// timing every call into the matching stats entry
+void protopirate_rx_metrics_feed_decoders(
+    ProtoPirateFeedStats stats[ProtoPirateProtocolIdCount],
+    SubGhzProtocolDecoderBase* const decoders[ProtoPirateProtocolIdCount],
+    bool level,
+    uint32_t duration);
+
+// 99th percentile estimate: top of the bucket the slowest 1% reaches into
+uint32_t protopirate_rx_metrics_feed_p99_us(const ProtoPirateFeedStats* stats);
+
+uint32_t protopirate_rx_metrics_feed_max_us(const ProtoPirateFeedStats* stats);
+
+// Append one "name: max/p99/over" line per decoder that was fed
+void protopirate_rx_metrics_format_feed(
+    const ProtoPirateFeedStats stats[ProtoPirateProtocolIdCount],
+    FuriString* output);
+
+// Append the startup milestones in ms, "-" for ones not reached yet
+void protopirate_rx_metrics_format_startup(
+    const ProtoPirateStartupTimes* startup,
+    FuriString* output);
+
+// Human readable summary for the diagnostics page
+void protopirate_rx_metrics_format(const ProtoPirateRxMetrics* metrics, FuriString* output);
+
+// Write a snapshot to a new file in PROTOPIRATE_METRICS_FOLDER
+bool protopirate_rx_metrics_save(const ProtoPirateRxMetrics* metrics, FuriString* out_path);
@@ -3,18 +3,89 @@
 #include <storage/storage.h>
 #include <flipper_format/flipper_format.h>
 #include <furi.h>
+#include <string.h>
 
 #define TAG "ProtoPirateSettings"
 
 #define SETTINGS_FILE_HEADER  "ProtoPirate Settings"
 #define SETTINGS_FILE_VERSION 1
 
+const uint16_t protopirate_hopper_dwell_ms[PROTOPIRATE_HOPPER_DWELL_COUNT] = {
+    50,
+    100,
+    200,
+    400,
+    800,
+};
+
+const uint16_t protopirate_glitch_filter_values[PROTOPIRATE_GLITCH_FILTER_COUNT] = {
+    PROTOPIRATE_GLITCH_FILTER_OFF_US,
+    60,
+    100,
+    150,
+    200,
+};
+
+static bool protopirate_settings_dwell_valid(uint32_t dwell) {
+    for(size_t i = 0; i < PROTOPIRATE_HOPPER_DWELL_COUNT; i++) {
+        if(protopirate_hopper_dwell_ms[i] == dwell) return true;
+    }
+    return false;
+}
+
+static ProtoPirateGlitchFilter*
+    protopirate_glitch_filter_find(const ProtoPirateGlitchFilter* filters, const char* preset) {
+    for(size_t i = 0; i < PROTOPIRATE_GLITCH_FILTER_PRESETS; i++) {
+        if(filters[i].preset[0] && strcmp(filters[i].preset, preset) == 0) {
+            return (ProtoPirateGlitchFilter*)&filters[i];
+        }
+    }
+    return NULL;
+}
+
+uint16_t
+    protopirate_glitch_filter_get(const ProtoPirateGlitchFilter* filters, const char* preset) {
+    furi_check(filters);
+    furi_check(preset);
+    const ProtoPirateGlitchFilter* filter = protopirate_glitch_filter_find(filters, preset);
+    return filter ? filter->threshold_us : PROTOPIRATE_GLITCH_FILTER_OFF_US;
+}
+
+bool protopirate_glitch_filter_set(
+    ProtoPirateGlitchFilter* filters,
+    const char* preset,
+    uint16_t threshold_us) {
+    furi_check(filters);
+    furi_check(preset);
+    ProtoPirateGlitchFilter* filter = protopirate_glitch_filter_find(filters, preset);
+
+    if(threshold_us == PROTOPIRATE_GLITCH_FILTER_OFF_US) {
+        if(filter) memset(filter, 0, sizeof(ProtoPirateGlitchFilter));
+        return true;
+    }
+
+    if(!filter) {
+        size_t length = strlen(preset);
+        if(!length || length >= PROTOPIRATE_GLITCH_FILTER_NAME_LEN) return false;
+        // Take the first free slot
+        for(size_t i = 0; !filter && i < PROTOPIRATE_GLITCH_FILTER_PRESETS; i++) {
+            if(!filters[i].preset[0]) filter = &filters[i];
+        }
+        if(!filter) return false;
+        memcpy(filter->preset, preset, length + 1);
+    }
+    filter->threshold_us = threshold_us;
+    return true;
+}
+
 void protopirate_settings_set_defaults(ProtoPirateSettings* settings) {
     settings->frequency = 433920000;
     settings->preset_index = 0;
     settings->tx_power = 0;
     settings->option_flags = 0;
     settings->hopping_enabled = false;
+    settings->hopper_dwell_ms = PROTOPIRATE_HOPPER_DWELL_DEFAULT_MS;
+    memset(settings->glitch_filter, 0, sizeof(settings->glitch_filter));
 }
 
 void protopirate_settings_load(ProtoPirateSettings* settings) {
@@ -91,6 +162,33 @@ void protopirate_settings_load(ProtoPirateSettings* settings) {
         }
         settings->hopping_enabled = (hopping_temp == 1);
 
+        // Read hopper dwell
+        uint32_t dwell_temp = 0;
+        if(!flipper_format_read_uint32(ff, "HopperDwell", &dwell_temp, 1) ||
+           !protopirate_settings_dwell_valid(dwell_temp)) {
+            FURI_LOG_W(TAG, "Failed to read hopper dwell, using default");
+            dwell_temp = PROTOPIRATE_HOPPER_DWELL_DEFAULT_MS;
+        }
+        settings->hopper_dwell_ms = (uint16_t)dwell_temp;
+
+        // Read glitch filter, GlitchPreset/GlitchFilter pairs in file order.
+        // The old positional GlitchFilter array has no preset and is dropped
+        FuriString* glitch_preset = furi_string_alloc();
+        size_t glitch_count = 0;
+        while(flipper_format_read_string(ff, "GlitchPreset", glitch_preset)) {
+            uint32_t glitch_temp = 0;
+            if(!flipper_format_read_uint32(ff, "GlitchFilter", &glitch_temp, 1)) break;
+            if(glitch_temp && glitch_temp <= UINT16_MAX &&
+               protopirate_glitch_filter_set(
+                   settings->glitch_filter,
+                   furi_string_get_cstr(glitch_preset),
+                   (uint16_t)glitch_temp)) {
+                glitch_count++;
+            }
+        }
+        furi_string_free(glitch_preset);
+        FURI_LOG_I(TAG, "Glitch filter set for %zu presets", glitch_count);
+
         FURI_LOG_I(
             TAG,
             "Settings loaded: freq=%lu, preset=%u, auto_save=%d, hopping=%d",
@@ -153,6 +251,27 @@ void protopirate_settings_save(ProtoPirateSettings* settings) {
             break;
         }
 
+        uint32_t dwell_temp = settings->hopper_dwell_ms;
+        if(!flipper_format_write_uint32(ff, "HopperDwell", &dwell_temp, 1)) {
+            FURI_LOG_E(TAG, "Failed to write hopper dwell");
+            break;
+        }
+
+        // Kept last, load reads the pairs until the end of the file
+        bool glitch_written = true;
+        for(size_t i = 0; glitch_written && i < PROTOPIRATE_GLITCH_FILTER_PRESETS; i++) {
+            const ProtoPirateGlitchFilter* filter = &settings->glitch_filter[i];
+            if(!filter->preset[0]) continue;
+            uint32_t glitch_temp = filter->threshold_us;
+            glitch_written =
+                flipper_format_write_string_cstr(ff, "GlitchPreset", filter->preset) &&
+                flipper_format_write_uint32(ff, "GlitchFilter", &glitch_temp, 1);
+        }
+        if(!glitch_written) {
+            FURI_LOG_E(TAG, "Failed to write glitch filter");
+            break;
+        }
+
         FURI_LOG_I(
             TAG,
             "Settings saved: freq=%lu, preset=%u, auto_save=%d, hopping=%d",
@@ -13,14 +13,38 @@
 #define PROTOPIRATE_SETTINGS_DIR  "/ext/apps_data/proto_pirate/"
 #endif
 
+// Glitch filter thresholds are kept for up to this many presets, keyed by
+// preset name so a reordered setting_user doesn't move them
+#define PROTOPIRATE_GLITCH_FILTER_PRESETS  8
+#define PROTOPIRATE_GLITCH_FILTER_NAME_LEN 24
+// SubGhzWorker's own merge threshold, used when the filter is off
+#define PROTOPIRATE_GLITCH_FILTER_OFF_US 30
+// Thresholds offered in the receiver config, the off value first
+#define PROTOPIRATE_GLITCH_FILTER_COUNT 5
+extern const uint16_t protopirate_glitch_filter_values[PROTOPIRATE_GLITCH_FILTER_COUNT];
+
+// An empty preset name marks a free slot
+typedef struct {
+    char preset[PROTOPIRATE_GLITCH_FILTER_NAME_LEN];
+    uint16_t threshold_us;
+} ProtoPirateGlitchFilter;
+
 typedef struct {
     uint32_t frequency;
     uint8_t preset_index;
     uint8_t tx_power;
     bool hopping_enabled;
     uint8_t option_flags;
+    uint16_t hopper_dwell_ms;
+    ProtoPirateGlitchFilter glitch_filter[PROTOPIRATE_GLITCH_FILTER_PRESETS];
 } ProtoPirateSettings;
 
+#define PROTOPIRATE_HOPPER_DWELL_DEFAULT_MS 100
+// Hop dwell choices offered in the receiver config, any other stored value
+// loads as the default
+#define PROTOPIRATE_HOPPER_DWELL_COUNT 5
+extern const uint16_t protopirate_hopper_dwell_ms[PROTOPIRATE_HOPPER_DWELL_COUNT];
+
 //AND Flags instead of a million booleans
 #define FLAG_AUTO_SAVE          1
 #define FLAG_DATETIME_FILENAMES 2
@@ -28,3 +52,13 @@ typedef struct {
 void protopirate_settings_load(ProtoPirateSettings* settings);
 void protopirate_settings_save(ProtoPirateSettings* settings);
 void protopirate_settings_set_defaults(ProtoPirateSettings* settings);
+
+// Threshold stored for preset, PROTOPIRATE_GLITCH_FILTER_OFF_US if none is
+uint16_t protopirate_glitch_filter_get(const ProtoPirateGlitchFilter* filters, const char* preset);
+
+// Store the threshold for preset, the off value frees its slot. Returns false
+// when every slot is taken or the name doesn't fit.
+bool protopirate_glitch_filter_set(
+    ProtoPirateGlitchFilter* filters,
+    const char* preset,
+    uint16_t threshold_us);
@@ -1,5 +1,7 @@
 // helpers/protopirate_storage.c
 #include "protopirate_storage.h"
+#include "protopirate_heap.h"
+#include "../protocols/protocol_items.h"
 
 #define TAG "ProtoPirateStorage"
 
@@ -286,6 +288,7 @@ bool protopirate_storage_save_temp(FlipperFormat* flipper_format) {
         return false;
     }
 
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapStorage);
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* save_file = flipper_format_file_alloc(storage);
     bool result = false;
@@ -315,6 +318,7 @@ bool protopirate_storage_save_temp(FlipperFormat* flipper_format) {
 
     flipper_format_free(save_file);
     furi_record_close(RECORD_STORAGE);
+    protopirate_heap_settle(ProtoPirateHeapStorage, heap_mark);
     return result;
 }
 
@@ -327,6 +331,33 @@ void protopirate_storage_delete_temp(void) {
     furi_record_close(RECORD_STORAGE);
 }
 
+void protopirate_storage_capture_name(
+    const ProtoPirateDecodeResult* result,
+    bool datetime_prefix,
+    FuriString* out_name) {
+    furi_check(result);
+    furi_check(out_name);
+    furi_string_reset(out_name);
+
+    if(datetime_prefix) {
+        DateTime date_time;
+        furi_hal_rtc_get_datetime(&date_time);
+        furi_string_printf(
+            out_name,
+            "%.2d%.2d%.2d_%.2d.%.2d.%.2d_",
+            date_time.year,
+            date_time.month,
+            date_time.day,
+            date_time.hour,
+            date_time.minute,
+            date_time.second);
+    }
+
+    // get_next_filename sanitizes the name, so spaces and slashes can stay
+    const char* protocol_name = protopirate_protocol_name(result->protocol_id);
+    furi_string_cat_str(out_name, protocol_name ? protocol_name : "Unknown");
+}
+
 bool protopirate_storage_save_capture(
     FlipperFormat* flipper_format,
     const char* protocol_name,
@@ -341,11 +372,13 @@ bool protopirate_storage_save_capture(
         return false;
     }
 
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapStorage);
     FuriString* file_path = furi_string_alloc();
 
     if(!protopirate_storage_get_next_filename(protocol_name, file_path, datetime_filenames)) {
         FURI_LOG_E(TAG, "Failed to get next filename");
         furi_string_free(file_path);
+        protopirate_heap_settle(ProtoPirateHeapStorage, heap_mark);
         return false;
     }
 
@@ -379,6 +412,7 @@ bool protopirate_storage_save_capture(
     flipper_format_free(save_file);
     furi_string_free(file_path);
     furi_record_close(RECORD_STORAGE);
+    protopirate_heap_settle(ProtoPirateHeapStorage, heap_mark);
     return result;
 }
 
@@ -6,6 +6,8 @@
 #include <flipper_format/flipper_format.h>
 #include <defines.h>
 
+#include "../protocols/decode_result.h"
+
 #ifdef BUILD_MAIN_APP
 #define PROTOPIRATE_APP_FOLDER APP_DATA_PATH("saved")
 #else
@@ -83,6 +85,13 @@
 // Initialize storage (create folder if needed)
 bool protopirate_storage_init(void);
 
+// Build the base file name for a capture from its decode result, optionally
+// prefixed with the current date and time
+void protopirate_storage_capture_name(
+    const ProtoPirateDecodeResult* result,
+    bool datetime_prefix,
+    FuriString* out_name);
+
 // Save a capture to a new file
 bool protopirate_storage_save_capture(
     FlipperFormat* flipper_format,
@@ -20,12 +20,19 @@ typedef enum {
     ProtoPirateCustomEventViewReceiverConfig,
     ProtoPirateCustomEventViewReceiverBack,
     ProtoPirateCustomEventViewReceiverUnlock,
+    ProtoPirateCustomEventViewReceiverDiagnostics,
     // Custom events for scenes
     ProtoPirateCustomEventSceneReceiverUpdate,
+    ProtoPirateCustomEventSceneReceiverRadio,
     ProtoPirateCustomEventSceneSettingLock,
     // File management
     ProtoPirateCustomEventReceiverInfoSave,
     ProtoPirateCustomEventReceiverInfoEmulate,
+    ProtoPirateCustomEventReceiverDiagnosticsSave,
+    ProtoPirateCustomEventReceiverDiagnosticsReset,
+    ProtoPirateCustomEventReceiverDiagnosticsMemory,
+    ProtoPirateCustomEventMemoryRefresh,
+    ProtoPirateCustomEventMemoryReset,
     ProtoPirateCustomEventSavedInfoDelete,
     // Emulator
     ProtoPirateCustomEventSavedInfoEmulate,
@@ -35,6 +42,10 @@ typedef enum {
     // Sub decode
     ProtoPirateCustomEventSubDecodeUpdate,
     ProtoPirateCustomEventSubDecodeSave,
+    // Batch decode
+    ProtoPirateCustomEventBatchDecodeProgress,
+    // Decoder bench
+    ProtoPirateCustomEventDecoderBenchProgress,
     // File Browser
     ProtoPirateCustomEventSavedFileSelected,
 } ProtoPirateCustomEvent;
@@ -54,8 +65,6 @@ typedef enum {
 typedef enum {
     ProtoPirateHopperStateOFF,
     ProtoPirateHopperStateRunning,
-    ProtoPirateHopperStatePause,
-    ProtoPirateHopperStateRSSITimeOut,
 } ProtoPirateHopperState;
 
 typedef enum {
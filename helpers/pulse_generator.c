@@ -0,0 +1,128 @@
+// helpers/pulse_generator.c
+#include "pulse_generator.h"
+#include <string.h>
+
+#define PULSE_GENERATOR_DEFAULT_SEED 0x9E3779B9
+
+// Glitches shorter than this are not worth splicing
+#define PULSE_GENERATOR_GLITCH_MIN_US 10
+
+void pulse_generator_init(
+    PulseGenerator* generator,
+    const PulseGeneratorConfig* config,
+    const PulseGeneratorFamily* families,
+    size_t family_count,
+    uint32_t seed) {
+    memset(generator, 0, sizeof(PulseGenerator));
+    generator->config = *config;
+    if(family_count > PULSE_GENERATOR_MAX_FAMILIES) family_count = PULSE_GENERATOR_MAX_FAMILIES;
+    memcpy(generator->families, families, family_count * sizeof(PulseGeneratorFamily));
+    generator->family_count = family_count;
+    generator->rng = seed ? seed : PULSE_GENERATOR_DEFAULT_SEED;
+    // Frames start high, so the train opens on the low side of a gap
+    generator->level = true;
+}
+
+// xorshift32: cheap and the same on every target
+static uint32_t pulse_generator_rand(PulseGenerator* generator) {
+    uint32_t x = generator->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    generator->rng = x;
+    return x;
+}
+
+uint32_t pulse_generator_random(PulseGenerator* generator, uint32_t min, uint32_t max) {
+    if(max <= min) return min;
+    return min + pulse_generator_rand(generator) % (max - min + 1);
+}
+
+static void pulse_generator_start_segment(PulseGenerator* generator) {
+    const PulseGeneratorConfig* config = &generator->config;
+
+    generator->index = 0;
+    generator->gap_us = pulse_generator_random(generator, config->gap_min_us, config->gap_max_us);
+    generator->noise = !generator->family_count ||
+                       pulse_generator_random(generator, 1, 100) <= config->noise_pct;
+
+    if(generator->noise) {
+        // Even length, so the stretch ends low and the gap extends it
+        generator->length = (config->noise_pulses + 1) & ~1;
+        if(!generator->length) generator->length = 2;
+        generator->stats.noise_stretches++;
+        return;
+    }
+
+    uint8_t family = config->interleave ?
+                         pulse_generator_random(generator, 0, generator->family_count - 1) :
+                         0;
+    generator->family = &generator->families[family];
+    generator->length = (PULSE_GENERATOR_PREAMBLE + generator->family->min_count_bit) * 2;
+    generator->stats.frames++;
+}
+
+static uint32_t pulse_generator_jitter(PulseGenerator* generator, uint32_t duration) {
+    uint32_t spread = duration * generator->config.jitter_pct / 100;
+    if(!spread) return duration;
+    return duration - spread + pulse_generator_random(generator, 0, spread * 2);
+}
+
+// Nominal duration of the current segment pulse, before jitter and gap
+static uint32_t pulse_generator_segment_pulse(PulseGenerator* generator) {
+    const PulseGeneratorConfig* config = &generator->config;
+
+    if(generator->noise) {
+        return pulse_generator_random(generator, config->noise_min_us, config->noise_max_us);
+    }
+
+    const PulseGeneratorFamily* family = generator->family;
+    if(generator->index < PULSE_GENERATOR_PREAMBLE * 2) return family->te_short;
+
+    // PWM: a one is long high then short low, a zero the other way round
+    bool high_half = !((generator->index - PULSE_GENERATOR_PREAMBLE * 2) & 1);
+    if(high_half) generator->bit = pulse_generator_rand(generator) & 1;
+    return (generator->bit == high_half) ? family->te_long : family->te_short;
+}
+
+void pulse_generator_next(PulseGenerator* generator, bool* level, uint32_t* duration) {
+    if(generator->pending_count) {
+        // Pending pulses are stored last first, each flips the level
+        *duration = generator->pending[--generator->pending_count];
+        *level = generator->level;
+        generator->level = !generator->level;
+        generator->stats.pulses++;
+        return;
+    }
+
+    if(generator->index >= generator->length) pulse_generator_start_segment(generator);
+
+    uint32_t pulse = pulse_generator_segment_pulse(generator);
+    bool last = ++generator->index >= generator->length;
+    if(!generator->noise) pulse = pulse_generator_jitter(generator, pulse);
+    if(!pulse) pulse = 1;
+
+    const PulseGeneratorConfig* config = &generator->config;
+    if(!last && !generator->noise && config->glitch_permille &&
+       pulse_generator_random(generator, 1, 1000) <= config->glitch_permille) {
+        uint32_t glitch =
+            pulse_generator_random(generator, PULSE_GENERATOR_GLITCH_MIN_US, config->glitch_max_us);
+        if(pulse > glitch * 3) {
+            // Split the pulse around a short one of the opposite level
+            uint32_t head = pulse_generator_random(generator, glitch, pulse - glitch * 2);
+            generator->pending[1] = glitch;
+            generator->pending[0] = pulse - head - glitch;
+            generator->pending_count = 2;
+            generator->stats.glitches++;
+            pulse = head;
+        }
+    }
+
+    // The last pulse of a segment is low and runs into the gap
+    if(last) pulse += generator->gap_us;
+
+    *level = generator->level;
+    *duration = pulse;
+    generator->level = !generator->level;
+    generator->stats.pulses++;
+}
@@ -0,0 +1,86 @@
+// helpers/pulse_generator.h
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Synthetic pulse trains for loading the decoders repeatably. Pure and
+// seeded: the same seed, families and config always give the same pulses.
+// Frames are a short preamble then min_count_bit PWM bits at the family's
+// te_short/te_long, closed by a gap; noise stretches and glitches are mixed
+// in as configured. Durations are in microseconds, levels alternate.
+
+#define PULSE_GENERATOR_MAX_FAMILIES 16
+#define PULSE_GENERATOR_PREAMBLE     8
+// Pulses a glitch can add to one frame pulse: first part, glitch, rest
+#define PULSE_GENERATOR_PENDING      2
+
+typedef struct {
+    uint16_t te_short;
+    uint16_t te_long;
+    uint16_t te_delta;
+    uint16_t min_count_bit;
+} PulseGeneratorFamily;
+
+typedef struct {
+    // Each frame pulse is moved by up to this percentage either way
+    uint8_t jitter_pct;
+    // Chance per frame pulse, in 1/1000, that a glitch is spliced into it
+    uint16_t glitch_permille;
+    uint16_t glitch_max_us;
+    // Chance, in percent, that a noise stretch takes a frame's place
+    uint8_t noise_pct;
+    uint16_t noise_pulses;
+    uint16_t noise_min_us;
+    uint16_t noise_max_us;
+    // Quiet time after every frame or noise stretch, uniform in this range
+    uint32_t gap_min_us;
+    uint32_t gap_max_us;
+    // Pick a random family per frame, else stay on the first one
+    bool interleave;
+} PulseGeneratorConfig;
+
+typedef struct {
+    uint32_t pulses;
+    uint32_t frames;
+    uint32_t noise_stretches;
+    uint32_t glitches;
+} PulseGeneratorStats;
+
+typedef struct {
+    PulseGeneratorConfig config;
+    PulseGeneratorFamily families[PULSE_GENERATOR_MAX_FAMILIES];
+    uint8_t family_count;
+    uint32_t rng;
+
+    // Segment being emitted: a frame of the current family or a noise stretch
+    const PulseGeneratorFamily* family;
+    bool noise;
+    uint16_t index;
+    uint16_t length;
+    uint32_t gap_us;
+    bool bit;
+    bool level;
+
+    uint32_t pending[PULSE_GENERATOR_PENDING];
+    uint8_t pending_count;
+
+    PulseGeneratorStats stats;
+} PulseGenerator;
+
+// family_count is clamped to PULSE_GENERATOR_MAX_FAMILIES. A zero seed is
+// replaced, the generator needs a non-zero state.
+void pulse_generator_init(
+    PulseGenerator* generator,
+    const PulseGeneratorConfig* config,
+    const PulseGeneratorFamily* families,
+    size_t family_count,
+    uint32_t seed);
+
+// Next pulse. Never fails, the train is endless.
+void pulse_generator_next(PulseGenerator* generator, bool* level, uint32_t* duration);
+
+// Uniform in [min, max] from the generator's sequence, for callers building
+// their own inputs on the same seed
+uint32_t pulse_generator_random(PulseGenerator* generator, uint32_t min, uint32_t max);
@@ -0,0 +1,251 @@
+// helpers/pulse_stream.c
+#include "pulse_stream.h"
+#include <defines.h>
+
+// Only the receiver reads a stream
+#ifdef ENABLE_RECEIVER_SCENE
+#include <storage/storage.h>
+#include <string.h>
+
+#define TAG "ProtoPiratePulseStream"
+
+// The decoders and the receiver callback run on this thread, as they do on
+// the SubGhzWorker one, on top of our own file reads
+#define PULSE_STREAM_STACK_SIZE (3 * 1024)
+#define PULSE_STREAM_FLAG_STOP  (1 << 0)
+
+#define PULSE_STREAM_DATA_KEY "RAW_Data"
+#define PULSE_STREAM_KEY_MAX  (sizeof(PULSE_STREAM_DATA_KEY) - 1)
+
+typedef enum {
+    PulseStreamLineStart,
+    // Reading a "Key:" prefix
+    PulseStreamLineKey,
+    PulseStreamLineSkip,
+    PulseStreamLineValues,
+} PulseStreamLine;
+
+struct PulseStream {
+    FuriThread* thread;
+    FuriString* path;
+    uint32_t gap_us;
+    PulseStreamCallback callback;
+    void* context;
+
+    // Parser state, carried from one chunk to the next
+    PulseStreamLine line;
+    char key[PULSE_STREAM_KEY_MAX];
+    uint8_t key_length;
+    uint32_t value;
+    bool negative;
+    bool digits;
+
+    uint64_t offset;
+    uint32_t last_data_tick;
+    // Pulses went out since the last quiet gap
+    bool open_frame;
+    PulseStreamStats stats;
+    uint8_t chunk[PULSE_STREAM_CHUNK];
+};
+
+static void pulse_stream_parser_reset(PulseStream* stream) {
+    stream->line = PulseStreamLineStart;
+    stream->key_length = 0;
+    stream->value = 0;
+    stream->negative = false;
+    stream->digits = false;
+}
+
+static void pulse_stream_emit(PulseStream* stream) {
+    if(stream->digits && stream->value) {
+        stream->callback(stream->context, !stream->negative, stream->value);
+        stream->stats.pulses++;
+        stream->open_frame = true;
+    }
+    stream->value = 0;
+    stream->negative = false;
+    stream->digits = false;
+}
+
+static void pulse_stream_parse(PulseStream* stream, char c) {
+    switch(stream->line) {
+    case PulseStreamLineStart:
+        if(c == '-' || (c >= '0' && c <= '9')) {
+            stream->line = PulseStreamLineValues;
+            pulse_stream_parse(stream, c);
+        } else if((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+            stream->line = PulseStreamLineKey;
+            stream->key_length = 0;
+            pulse_stream_parse(stream, c);
+        } else if(c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            stream->line = PulseStreamLineSkip;
+        }
+        break;
+
+    case PulseStreamLineKey:
+        if(c == ':') {
+            bool data = stream->key_length == PULSE_STREAM_KEY_MAX &&
+                        !memcmp(stream->key, PULSE_STREAM_DATA_KEY, PULSE_STREAM_KEY_MAX);
+            stream->line = data ? PulseStreamLineValues : PulseStreamLineSkip;
+        } else if(c == '\n') {
+            stream->line = PulseStreamLineStart;
+        } else if(stream->key_length < PULSE_STREAM_KEY_MAX) {
+            stream->key[stream->key_length++] = c;
+        } else {
+            stream->line = PulseStreamLineSkip;
+        }
+        break;
+
+    case PulseStreamLineSkip:
+        if(c == '\n') stream->line = PulseStreamLineStart;
+        break;
+
+    case PulseStreamLineValues:
+        if(c >= '0' && c <= '9') {
+            // Saturate rather than wrap on a runaway number
+            uint32_t digit = c - '0';
+            stream->value = stream->value > (UINT32_MAX - digit) / 10 ? UINT32_MAX :
+                                                                         stream->value * 10 + digit;
+            stream->digits = true;
+        } else if(c == '-' && !stream->digits && !stream->negative) {
+            stream->negative = true;
+        } else {
+            pulse_stream_emit(stream);
+            if(c == '\n') stream->line = PulseStreamLineStart;
+        }
+        break;
+    }
+}
+
+// Read whatever was appended since the last poll. Returns the bytes read.
+static size_t pulse_stream_poll(PulseStream* stream, Storage* storage, File* file) {
+    const char* path = furi_string_get_cstr(stream->path);
+
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        storage_file_close(file);
+        // Gone means the next file is a new stream; otherwise the writer
+        // has it open right now, so try again next poll
+        if(stream->offset && !storage_file_exists(storage, path)) {
+            stream->offset = 0;
+            pulse_stream_parser_reset(stream);
+            stream->stats.restarts++;
+        }
+        return 0;
+    }
+
+    uint64_t size = storage_file_size(file);
+    if(size < stream->offset) {
+        FURI_LOG_I(TAG, "File shrank, reading it from the start");
+        stream->offset = 0;
+        pulse_stream_parser_reset(stream);
+        stream->stats.restarts++;
+    }
+
+    size_t read = 0;
+    if(size > stream->offset && storage_file_seek(file, stream->offset, true)) {
+        read = storage_file_read(file, stream->chunk, sizeof(stream->chunk));
+    }
+    storage_file_close(file);
+
+    for(size_t i = 0; i < read; i++) {
+        pulse_stream_parse(stream, (char)stream->chunk[i]);
+    }
+    stream->offset += read;
+    stream->stats.bytes += read;
+    return read;
+}
+
+static int32_t pulse_stream_thread(void* context) {
+    PulseStream* stream = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    // Start at the current end, only what is written from now on is live
+    const char* path = furi_string_get_cstr(stream->path);
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        stream->offset = storage_file_size(file);
+    }
+    storage_file_close(file);
+    stream->last_data_tick = furi_get_tick();
+
+    while(true) {
+        if(pulse_stream_poll(stream, storage, file)) {
+            stream->last_data_tick = furi_get_tick();
+            // More may be waiting, only pause once caught up
+            uint32_t flags = furi_thread_flags_get();
+            if(flags & PULSE_STREAM_FLAG_STOP) break;
+            continue;
+        }
+
+        if((stream->open_frame || stream->digits) &&
+           furi_get_tick() - stream->last_data_tick >= furi_ms_to_ticks(PULSE_STREAM_IDLE_MS)) {
+            // The writer went quiet: finish the number and the frame it ended
+            pulse_stream_emit(stream);
+            stream->callback(stream->context, false, stream->gap_us);
+            stream->stats.gaps++;
+            stream->open_frame = false;
+        }
+
+        uint32_t flags = furi_thread_flags_wait(
+            PULSE_STREAM_FLAG_STOP, FuriFlagWaitAny, furi_ms_to_ticks(PULSE_STREAM_POLL_MS));
+        if(!(flags & FuriFlagError) && (flags & PULSE_STREAM_FLAG_STOP)) break;
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return 0;
+}
+
+PulseStream* pulse_stream_alloc(
+    const char* path,
+    uint32_t gap_us,
+    PulseStreamCallback callback,
+    void* context) {
+    furi_check(path);
+    furi_check(callback);
+
+    PulseStream* stream = malloc(sizeof(PulseStream));
+    memset(stream, 0, sizeof(PulseStream));
+    stream->path = furi_string_alloc_set_str(path);
+    stream->gap_us = gap_us;
+    stream->callback = callback;
+    stream->context = context;
+    return stream;
+}
+
+void pulse_stream_free(PulseStream* stream) {
+    furi_check(stream);
+    pulse_stream_stop(stream);
+    furi_string_free(stream->path);
+    free(stream);
+}
+
+void pulse_stream_start(PulseStream* stream) {
+    furi_check(stream);
+    if(stream->thread) return;
+
+    pulse_stream_parser_reset(stream);
+    stream->open_frame = false;
+    memset(&stream->stats, 0, sizeof(stream->stats));
+
+    stream->thread = furi_thread_alloc_ex(
+        "ProtoPirateStream", PULSE_STREAM_STACK_SIZE, pulse_stream_thread, stream);
+    furi_thread_start(stream->thread);
+}
+
+void pulse_stream_stop(PulseStream* stream) {
+    furi_check(stream);
+    if(!stream->thread) return;
+
+    furi_thread_flags_set(furi_thread_get_id(stream->thread), PULSE_STREAM_FLAG_STOP);
+    furi_thread_join(stream->thread);
+    furi_thread_free(stream->thread);
+    stream->thread = NULL;
+}
+
+PulseStreamStats pulse_stream_get_stats(const PulseStream* stream) {
+    furi_check(stream);
+    return stream->stats;
+}
+
+#endif // ENABLE_RECEIVER_SCENE
@@ -0,0 +1,56 @@
+// helpers/pulse_stream.h
+#pragma once
+
+#include <furi.h>
+
+// Live pulse input from a file that another process keeps appending to,
+// e.g. a Linux pulse source pushing chunks over the serial CLI with
+// "storage write_chunk". Values use the RAW_Data convention: signed
+// durations in us, positive for high and negative for low, separated by
+// whitespace. Lines starting with any key other than RAW_Data: are skipped,
+// so a .sub capture being appended works as well.
+//
+// A thread polls the file, reads only what was added since the last read
+// and hands every pulse to the callback as soon as it is parsed, so a match
+// fires with the pulse that completes it. Memory is fixed: one read chunk
+// and the parser state, however long the stream runs. A file that shrinks
+// is taken as a new stream and read from the start.
+
+#define PULSE_STREAM_FILE "/ext/apps_data/proto_pirate/stream.raw"
+
+// Bytes read per poll at most, and how often the file is checked for more
+#define PULSE_STREAM_CHUNK   512
+#define PULSE_STREAM_POLL_MS 20
+// After this long without new data, a pending number is taken as complete
+// and a quiet gap is fed so decoders finish the frame they are in
+#define PULSE_STREAM_IDLE_MS 200
+
+// Same shape as SubGhzWorkerPairCallback, so the receive path can be reused
+typedef void (*PulseStreamCallback)(void* context, bool level, uint32_t duration);
+
+typedef struct {
+    uint32_t bytes;
+    uint32_t pulses;
+    // Quiet gaps fed on idle, and times the file was started over
+    uint32_t gaps;
+    uint32_t restarts;
+} PulseStreamStats;
+
+typedef struct PulseStream PulseStream;
+
+// gap_us is the quiet gap fed on idle. Reading starts at the end of the file
+// as it is now, so only pulses written from here on are decoded.
+PulseStream* pulse_stream_alloc(
+    const char* path,
+    uint32_t gap_us,
+    PulseStreamCallback callback,
+    void* context);
+
+// Stops the thread first; the callback is not called after this returns
+void pulse_stream_free(PulseStream* stream);
+
+void pulse_stream_start(PulseStream* stream);
+void pulse_stream_stop(PulseStream* stream);
+
+// Counters so far, read from another thread they may be a pulse behind
+PulseStreamStats pulse_stream_get_stats(const PulseStream* stream);
@@ -17,17 +17,28 @@ struct FlipperFormat {
     bool strict_mode;
 };
 
-RawFileReader* raw_file_reader_alloc(void) {
-    RawFileReader* reader = malloc(sizeof(RawFileReader));
+void raw_file_reader_init(RawFileReader* reader) {
     furi_check(reader);
     memset(reader, 0, sizeof(RawFileReader));
+}
+
+void raw_file_reader_deinit(RawFileReader* reader) {
+    if(!reader) return;
+    raw_file_reader_close(reader);
+}
+
+RawFileReader* raw_file_reader_alloc(void) {
+    RawFileReader* reader =
+        protopirate_heap_alloc(ProtoPirateHeapRawReader, sizeof(RawFileReader));
+    furi_check(reader);
+    raw_file_reader_init(reader);
     return reader;
 }
 
 void raw_file_reader_free(RawFileReader* reader) {
     if(!reader) return;
-    raw_file_reader_close(reader);
-    free(reader);
+    raw_file_reader_deinit(reader);
+    protopirate_heap_free(ProtoPirateHeapRawReader, reader, sizeof(RawFileReader));
 }
 
 static inline bool local_flipper_format_stream_is_space(char c) {
@@ -238,10 +249,13 @@ bool raw_file_reader_open(RawFileReader* reader, const char* file_path) {
 
     raw_file_reader_close(reader);
 
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapRawReader);
     reader->storage = furi_record_open(RECORD_STORAGE);
     reader->storage_opened = true;
     reader->ff = flipper_format_file_alloc(reader->storage);
 
+    protopirate_heap_settle(ProtoPirateHeapRawReader, heap_mark);
+
     if(!flipper_format_file_open_existing(reader->ff, file_path)) {
         FURI_LOG_E(TAG, "Failed to open file: %s", file_path);
         raw_file_reader_close(reader);
@@ -306,6 +320,7 @@ bool raw_file_reader_open(RawFileReader* reader, const char* file_path) {
 void raw_file_reader_close(RawFileReader* reader) {
     if(!reader) return;
 
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapRawReader);
     if(reader->ff) {
         flipper_format_free(reader->ff);
         reader->ff = NULL;
@@ -315,6 +330,7 @@ void raw_file_reader_close(RawFileReader* reader) {
         furi_record_close(RECORD_STORAGE);
         reader->storage_opened = false;
     }
+    protopirate_heap_settle(ProtoPirateHeapRawReader, heap_mark);
 
     reader->storage = NULL;
     reader->buffer_count = 0;
@@ -326,14 +342,26 @@ void raw_file_reader_close(RawFileReader* reader) {
 static bool raw_file_reader_load_chunk(RawFileReader* reader) {
     if(reader->file_finished) return false;
 
+    if(memmgr_get_free_heap() < RAW_READER_MIN_FREE_HEAP) {
+        FURI_LOG_E(TAG, "Not enough memory to continue reading");
+        return false;
+    }
+
     size_t to_read = (reader->count < RAW_READER_BUFFER_SIZE) ? reader->count :
                                                                 RAW_READER_BUFFER_SIZE;
 
-    if(!flipper_format_read_int32(reader->ff, "RAW_Data", reader->buffer, to_read)) {
+    if(!flipper_format_read_int32(reader->ff, "RAW_Data", reader->buffer.raw, to_read)) {
         reader->file_finished = true;
         return false;
     }
 
+    // Same size and slot, so each value converts where it lies
+    for(size_t i = 0; i < to_read; i++) {
+        int32_t value = reader->buffer.raw[i];
+        reader->buffer.samples[i] = value >= 0 ? level_duration_make(true, (uint32_t)value) :
+                                                 level_duration_make(false, (uint32_t)(-value));
+    }
+
     reader->buffer_count = to_read;
     reader->buffer_index = 0;
     reader->count -= to_read;
@@ -344,28 +372,29 @@ static bool raw_file_reader_load_chunk(RawFileReader* reader) {
 bool raw_file_reader_get_next(RawFileReader* reader, bool* level, uint32_t* duration) {
     if(!reader || !level || !duration) return false;
 
-    if(memmgr_get_free_heap() < 1024) {
-        FURI_LOG_E(TAG, "Not enough memory to continue reading");
-        return false;
-    }
+    const LevelDuration* sample;
+    if(!raw_file_reader_get_span(reader, 1, &sample)) return false;
+
+    *level = level_duration_get_level(*sample);
+    *duration = level_duration_get_duration(*sample);
+    return true;
+}
+
+size_t raw_file_reader_get_span(RawFileReader* reader, size_t max, const LevelDuration** span) {
+    if(!reader || !span) return 0;
 
     if(reader->buffer_index >= reader->buffer_count) {
         if(!raw_file_reader_load_chunk(reader)) {
-            return false;
+            return 0;
         }
     }
 
-    int32_t value = reader->buffer[reader->buffer_index++];
+    size_t available = reader->buffer_count - reader->buffer_index;
+    if(available > max) available = max;
 
-    if(value >= 0) {
-        *level = true;
-        *duration = (uint32_t)value;
-    } else {
-        *level = false;
-        *duration = (uint32_t)(-value);
-    }
-
-    return true;
+    *span = &reader->buffer.samples[reader->buffer_index];
+    reader->buffer_index += available;
+    return available;
 }
 
 bool raw_file_reader_is_finished(RawFileReader* reader) {
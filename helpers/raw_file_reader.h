@@ -5,13 +5,20 @@
 #include <furi.h>
 #include <storage/storage.h>
 #include <flipper_format/flipper_format.h>
+#include <toolbox/level_duration.h>
 
 #define RAW_READER_BUFFER_SIZE 512
+// Reading stops when a chunk refill would leave less free heap than this
+#define RAW_READER_MIN_FREE_HEAP 1024
 
 typedef struct {
     Storage* storage;
     FlipperFormat* ff;
-    int32_t buffer[RAW_READER_BUFFER_SIZE];
+    // Chunks are read as signed RAW_Data and converted in place
+    union {
+        int32_t raw[RAW_READER_BUFFER_SIZE];
+        LevelDuration samples[RAW_READER_BUFFER_SIZE];
+    } buffer;
     size_t buffer_count;
     size_t buffer_index;
     uint32_t count;
@@ -22,8 +29,15 @@ typedef struct {
 
 RawFileReader* raw_file_reader_alloc(void);
 void raw_file_reader_free(RawFileReader* reader);
+// For a reader living in memory the caller owns (e.g. a scene arena)
+void raw_file_reader_init(RawFileReader* reader);
+void raw_file_reader_deinit(RawFileReader* reader);
 bool raw_file_reader_open(RawFileReader* reader, const char* file_path);
 void raw_file_reader_close(RawFileReader* reader);
 bool raw_file_reader_get_next(RawFileReader* reader, bool* level, uint32_t* duration);
+// Up to max samples straight from the chunk buffer, refilling it when it is
+// used up. span stays valid until the next read. Returns 0 at the end of the
+// data, on a read error or when the heap is too low to go on.
+size_t raw_file_reader_get_span(RawFileReader* reader, size_t max, const LevelDuration** span);
 bool raw_file_reader_is_finished(RawFileReader* reader);
 #endif // ENABLE_SUB_DECODE_SCENE
@@ -0,0 +1,48 @@
+// helpers/scene_arena.c
+#include "scene_arena.h"
+#include "protopirate_heap.h"
+#include <string.h>
+
+#define TAG "ProtoPirateSceneArena"
+
+bool scene_arena_reserve(SceneArena* arena, size_t size) {
+    furi_check(arena);
+    furi_check(!arena->block);
+
+    arena->block = protopirate_heap_alloc(ProtoPirateHeapSceneArena, size);
+    if(!arena->block) {
+        FURI_LOG_E(TAG, "Failed to reserve %zu bytes", size);
+        return false;
+    }
+
+    arena->size = size;
+    arena->used = 0;
+    return true;
+}
+
+void* scene_arena_alloc(SceneArena* arena, size_t size) {
+    furi_check(arena);
+    if(!arena->block) return NULL;
+
+    size = (size + SCENE_ARENA_ALIGN - 1) & ~(size_t)(SCENE_ARENA_ALIGN - 1);
+    if(size > arena->size - arena->used) {
+        FURI_LOG_E(TAG, "Out of space: %zu of %zu used", arena->used, arena->size);
+        return NULL;
+    }
+
+    void* object = arena->block + arena->used;
+    arena->used += size;
+    memset(object, 0, size);
+    return object;
+}
+
+void scene_arena_release(SceneArena* arena) {
+    furi_check(arena);
+    if(!arena->block) return;
+
+    protopirate_heap_free(ProtoPirateHeapSceneArena, arena->block, arena->size);
+
+    arena->block = NULL;
+    arena->size = 0;
+    arena->used = 0;
+}
@@ -0,0 +1,32 @@
+// helpers/scene_arena.h
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Bump allocator over one block a scene reserves on enter and releases on
+// exit. Its big transient objects then take a single hole in the heap that
+// is handed back whole, instead of several that small long lived strings
+// can settle between. Nothing is freed individually.
+
+#define SCENE_ARENA_ALIGN 8
+
+// Space one object of type takes in an arena, for sizing the reservation
+#define SCENE_ARENA_SIZE_OF(type) \
+    ((sizeof(type) + SCENE_ARENA_ALIGN - 1) & ~(size_t)(SCENE_ARENA_ALIGN - 1))
+
+typedef struct {
+    uint8_t* block;
+    size_t size;
+    size_t used;
+} SceneArena;
+
+// Reserve size bytes in one allocation. The arena must not hold a block.
+bool scene_arena_reserve(SceneArena* arena, size_t size);
+
+// Zeroed, aligned space from the block, NULL once the reservation is used up
+void* scene_arena_alloc(SceneArena* arena, size_t size);
+
+// Hand the block back; everything allocated from it is gone
+void scene_arena_release(SceneArena* arena);
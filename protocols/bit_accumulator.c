@@ -0,0 +1,67 @@
+#include "bit_accumulator.h"
+#include <string.h>
+
+void bit_accumulator_reset(BitAccumulator* acc) {
+    memset(acc->bytes, 0, sizeof(acc->bytes));
+    acc->count = 0;
+}
+
+bool bit_accumulator_push_bits(BitAccumulator* acc, uint64_t value, uint8_t bit_count) {
+    furi_check(bit_count <= 64);
+    for(uint8_t i = bit_count; i > 0; i--) {
+        if(!bit_accumulator_push(acc, (value >> (i - 1)) & 1)) return false;
+    }
+    return true;
+}
+
+uint64_t bit_accumulator_get_bits(const BitAccumulator* acc, uint16_t start, uint8_t bit_count) {
+    furi_check(bit_count <= 64);
+    furi_check(start + bit_count <= BIT_ACCUMULATOR_MAX_BITS);
+
+    uint64_t value = 0;
+    while(bit_count) {
+        // Take as much of the current byte as is wanted
+        uint8_t offset = start & 7;
+        uint8_t take = 8 - offset;
+        if(take > bit_count) take = bit_count;
+
+        uint8_t chunk = (acc->bytes[start >> 3] >> (8 - offset - take)) & ((1U << take) - 1);
+        value = (value << take) | chunk;
+
+        start += take;
+        bit_count -= take;
+    }
+    return value;
+}
+
+void bit_accumulator_export(
+    const BitAccumulator* acc,
+    size_t first_byte,
+    uint8_t* out,
+    size_t size) {
+    furi_check(first_byte + size <= sizeof(acc->bytes));
+    memcpy(out, &acc->bytes[first_byte], size);
+}
+
+void bit_accumulator_invert(BitAccumulator* acc) {
+    size_t full = acc->count >> 3;
+    for(size_t i = 0; i < full; i++) {
+        acc->bytes[i] = ~acc->bytes[i];
+    }
+    // Keep the bits past count zero so later pushes can OR into them
+    uint8_t tail = acc->count & 7;
+    if(tail) {
+        acc->bytes[full] ^= (uint8_t)(0xFF << (8 - tail));
+    }
+}
+
+uint8_t bit_accumulator_hash(const BitAccumulator* acc, size_t max_bytes) {
+    size_t size = bit_accumulator_byte_count(acc);
+    if(size > max_bytes) size = max_bytes;
+
+    uint8_t hash = 0;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= acc->bytes[i];
+    }
+    return hash;
+}
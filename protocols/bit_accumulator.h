@@ -0,0 +1,55 @@
+#pragma once
+
+#include <furi.h>
+
+// Fixed-capacity MSB-first bit buffer for frames wider than the 64-bit
+// SubGhzBlockDecoder. Bits land directly in their final byte, so the frame
+// can be read back as a byte array without repacking.
+
+#define BIT_ACCUMULATOR_MAX_BITS 144
+
+typedef struct {
+    uint8_t bytes[(BIT_ACCUMULATOR_MAX_BITS + 7) / 8];
+    uint16_t count;
+} BitAccumulator;
+
+void bit_accumulator_reset(BitAccumulator* acc);
+
+// Append one bit (0 or 1). Returns false once the buffer is full.
+static inline bool bit_accumulator_push(BitAccumulator* acc, uint8_t bit) {
+    if(acc->count >= BIT_ACCUMULATOR_MAX_BITS) return false;
+    acc->bytes[acc->count >> 3] |= (uint8_t)(bit << (7 - (acc->count & 7)));
+    acc->count++;
+    return true;
+}
+
+// Append the low bit_count bits of value, most significant first
+bool bit_accumulator_push_bits(BitAccumulator* acc, uint64_t value, uint8_t bit_count);
+
+static inline uint16_t bit_accumulator_count(const BitAccumulator* acc) {
+    return acc->count;
+}
+
+static inline size_t bit_accumulator_byte_count(const BitAccumulator* acc) {
+    return (acc->count + 7) / 8;
+}
+
+static inline const uint8_t* bit_accumulator_bytes(const BitAccumulator* acc) {
+    return acc->bytes;
+}
+
+// Read up to 64 bits starting at bit index start, most significant first
+uint64_t bit_accumulator_get_bits(const BitAccumulator* acc, uint16_t start, uint8_t bit_count);
+
+// Copy size bytes starting at byte index first_byte into out
+void bit_accumulator_export(
+    const BitAccumulator* acc,
+    size_t first_byte,
+    uint8_t* out,
+    size_t size);
+
+// Flip every accumulated bit, for protocols that transmit the frame inverted
+void bit_accumulator_invert(BitAccumulator* acc);
+
+// XOR of the first max_bytes accumulated bytes, for get_hash_data
+uint8_t bit_accumulator_hash(const BitAccumulator* acc, size_t max_bytes);
@@ -0,0 +1,34 @@
+#include "decode_result.h"
+#include <string.h>
+
+void protopirate_decode_result_from_generic(
+    ProtoPirateDecodeResult* result,
+    const SubGhzBlockGeneric* generic) {
+    result->bits = generic->data_count_bit;
+    result->serial = generic->serial;
+    result->btn = generic->btn;
+    result->cnt = generic->cnt;
+    protopirate_decode_result_set_key_u64(result, generic->data, generic->data_count_bit);
+}
+
+void protopirate_decode_result_set_key_u64(
+    ProtoPirateDecodeResult* result,
+    uint64_t value,
+    uint16_t bit_count) {
+    if(bit_count > 64) bit_count = 64;
+    uint8_t size = (bit_count + 7) / 8;
+
+    for(uint8_t i = 0; i < size; i++) {
+        result->key[i] = (uint8_t)(value >> ((size - 1 - i) * 8));
+    }
+    result->key_size = size;
+}
+
+void protopirate_decode_result_set_key_bytes(
+    ProtoPirateDecodeResult* result,
+    const uint8_t* bytes,
+    size_t size) {
+    if(size > PROTOPIRATE_RESULT_KEY_MAX) size = PROTOPIRATE_RESULT_KEY_MAX;
+    memcpy(result->key, bytes, size);
+    result->key_size = size;
+}
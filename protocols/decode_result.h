@@ -0,0 +1,48 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/blocks/generic.h>
+
+#include "protocol_ids.h"
+
+// Typed view of one decoded frame. Every decoder fills it from its own state
+// through the get_result column of PROTOPIRATE_PROTOCOL_LIST, so consumers
+// read fields instead of parsing get_string text or FlipperFormat keys.
+
+// Widest raw frame we keep (Kia V6 / VAG / PSA are up to 144 bits)
+#define PROTOPIRATE_RESULT_KEY_MAX 18
+
+typedef struct {
+    ProtoPirateProtocolId protocol_id;
+    uint16_t bits;
+    uint32_t serial;
+    uint8_t btn;
+    uint32_t cnt;
+    bool crc_valid;
+    bool decrypted;
+    // The whole frame was received. protopirate_decoder_get_result sets it
+    // when bits reaches the protocol's min_count_bit_for_found; a decoder
+    // whose frame on air is shorter than that sets it itself.
+    bool full;
+    // Raw frame, most significant byte first
+    uint8_t key[PROTOPIRATE_RESULT_KEY_MAX];
+    uint8_t key_size;
+} ProtoPirateDecodeResult;
+
+// Copy bit count, serial, button and counter from the generic block and
+// store data as the raw key
+void protopirate_decode_result_from_generic(
+    ProtoPirateDecodeResult* result,
+    const SubGhzBlockGeneric* generic);
+
+// Store the low bit_count bits of value as the raw key
+void protopirate_decode_result_set_key_u64(
+    ProtoPirateDecodeResult* result,
+    uint64_t value,
+    uint16_t bit_count);
+
+// Store size bytes as the raw key (truncated to PROTOPIRATE_RESULT_KEY_MAX)
+void protopirate_decode_result_set_key_bytes(
+    ProtoPirateDecodeResult* result,
+    const uint8_t* bytes,
+    size_t size);
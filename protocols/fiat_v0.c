@@ -1,10 +1,11 @@
 #include "fiat_v0.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 #include <lib/toolbox/manchester_decoder.h>
 
 #define TAG "FiatProtocolV0"
 
-static const SubGhzBlockConst subghz_protocol_fiat_v0_const = {
+const SubGhzBlockConst subghz_protocol_fiat_v0_const = {
     .te_short = 200,
     .te_long = 400,
     .te_delta = 100,
@@ -374,7 +375,6 @@ void subghz_protocol_decoder_fiat_v0_feed(void* context, bool level, uint32_t du
     furi_check(context);
     SubGhzProtocolDecoderFiatV0* instance = context;
     uint32_t te_short = (uint32_t)subghz_protocol_fiat_v0_const.te_short;
-    uint32_t te_long = (uint32_t)subghz_protocol_fiat_v0_const.te_long;
     uint32_t te_delta = (uint32_t)subghz_protocol_fiat_v0_const.te_delta;
     uint32_t gap_threshold = 800;
     uint32_t diff;
@@ -396,11 +396,7 @@ void subghz_protocol_decoder_fiat_v0_feed(void* context, bool level, uint32_t du
             instance->te_last = duration;
             instance->preamble_count = 0;
             instance->bit_count = 0;
-            manchester_advance(
-                instance->manchester_state,
-                ManchesterEventReset,
-                &instance->manchester_state,
-                NULL);
+            line_coding_manchester_reset(&instance->manchester_state);
         }
         break;
 
@@ -476,36 +472,16 @@ void subghz_protocol_decoder_fiat_v0_feed(void* context, bool level, uint32_t du
         break;
 
     case FiatV0DecoderStepData: {
-        ManchesterEvent event = ManchesterEventReset;
-        if(duration < te_short) {
-            diff = te_short - duration;
-            if(diff < te_delta) {
-                event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-            }
-        } else {
-            diff = duration - te_short;
-            if(diff < te_delta) {
-                event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-            } else {
-                if(duration < te_long) {
-                    diff = te_long - duration;
-                } else {
-                    diff = duration - te_long;
-                }
-                if(diff < te_delta) {
-                    event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-                }
-            }
-        }
+        LineCodingBit bit = line_coding_manchester_feed(
+            &instance->manchester_state,
+            &subghz_protocol_fiat_v0_const,
+            LineCodingPolarityNormal,
+            level,
+            duration);
 
-        if(event != ManchesterEventReset) {
-            bool data_bit_bool;
-            if(manchester_advance(
-                   instance->manchester_state,
-                   event,
-                   &instance->manchester_state,
-                   &data_bit_bool)) {
-                uint32_t new_bit = data_bit_bool ? 1 : 0;
+        if(bit != LineCodingBitInvalid) {
+            if(line_coding_is_bit(bit)) {
+                uint32_t new_bit = bit;
 
                 uint32_t carry = (instance->data_low >> 31) & 1;
                 instance->data_low = (instance->data_low << 1) | new_bit;
@@ -618,3 +594,19 @@ void subghz_protocol_decoder_fiat_v0_get_string(void* context, FuriString* outpu
         instance->btn,
         instance->cnt);
 }
+
+void subghz_protocol_decoder_fiat_v0_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderFiatV0* instance = context;
+
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    result->serial = instance->serial;
+    result->btn = instance->btn;
+    result->cnt = instance->cnt;
+}
+
+bool subghz_protocol_decoder_fiat_v0_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderFiatV0* instance = context;
+    return instance->decoder_state != FiatV0DecoderStepReset;
+}
@@ -10,6 +10,8 @@
 #include <lib/toolbox/manchester_decoder.h>
 #include <flipper_format/flipper_format.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define FIAT_PROTOCOL_V0_NAME "Fiat V0"
@@ -17,6 +19,7 @@
 typedef struct SubGhzProtocolDecoderFiatV0 SubGhzProtocolDecoderFiatV0;
 typedef struct SubGhzProtocolEncoderFiatV0 SubGhzProtocolEncoderFiatV0;
 
+extern const SubGhzBlockConst subghz_protocol_fiat_v0_const;
 extern const SubGhzProtocol subghz_protocol_fiat_v0;
 
 // Decoder functions
@@ -32,6 +35,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_fiat_v0_serialize(
 SubGhzProtocolStatus
     subghz_protocol_decoder_fiat_v0_deserialize(void* context, FlipperFormat* flipper_format);
 void subghz_protocol_decoder_fiat_v0_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_fiat_v0_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_fiat_v0_in_frame(void* context);
 
 // Encoder functions
 void* subghz_protocol_encoder_fiat_v0_alloc(SubGhzEnvironment* environment);
@@ -1,4 +1,5 @@
 #include "ford_v0.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 
 #define TAG "FordProtocolV0"
@@ -10,7 +11,7 @@
 // Uncomment to enable bit-level debug logging (WARNING: 80 log calls per signal)
 // #define FORD_V0_DEBUG_BITS
 
-static const SubGhzBlockConst subghz_protocol_ford_v0_const = {
+const SubGhzBlockConst subghz_protocol_ford_v0_const = {
     .te_short = 250,
     .te_long = 500,
     .te_delta = 100,
@@ -788,11 +789,7 @@ void subghz_protocol_decoder_ford_v0_feed(void* context, bool level, uint32_t du
             instance->decoder.te_last = duration;
             instance->header_count = 0;
             instance->bit_count = 0;
-            manchester_advance(
-                instance->manchester_state,
-                ManchesterEventReset,
-                &instance->manchester_state,
-                NULL);
+            line_coding_manchester_reset(&instance->manchester_state);
         }
         break;
 
@@ -833,21 +830,19 @@ void subghz_protocol_decoder_ford_v0_feed(void* context, bool level, uint32_t du
         break;
 
     case FordV0DecoderStepData: {
-        ManchesterEvent event;
-
-        if(DURATION_DIFF(duration, te_short) < te_delta) {
-            event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-        } else if(DURATION_DIFF(duration, te_long) < te_delta) {
-            event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-        } else {
+        LineCodingBit bit = line_coding_manchester_feed(
+            &instance->manchester_state,
+            &subghz_protocol_ford_v0_const,
+            LineCodingPolarityNormal,
+            level,
+            duration);
+        if(bit == LineCodingBitInvalid) {
             instance->decoder.parser_step = FordV0DecoderStepReset;
             break;
         }
 
-        bool data_bit;
-        if(manchester_advance(
-               instance->manchester_state, event, &instance->manchester_state, &data_bit)) {
-            ford_v0_add_bit(instance, data_bit);
+        if(line_coding_is_bit(bit)) {
+            ford_v0_add_bit(instance, bit);
 
             if(ford_v0_process_data(instance)) {
                 instance->generic.data = instance->key1;
@@ -994,3 +989,29 @@ void subghz_protocol_decoder_ford_v0_get_string(void* context, FuriString* outpu
         instance->button,
         button_name);
 }
+
+void subghz_protocol_decoder_ford_v0_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderFordV0* instance = context;
+
+    result->bits = instance->generic.data_count_bit;
+    result->serial = instance->serial;
+    result->btn = instance->button;
+    result->cnt = instance->count;
+    result->crc_valid = ford_v0_verify_crc(instance->key1, instance->key2);
+
+    // Key1 then the 16-bit Key2
+    uint8_t key[10];
+    for(uint8_t i = 0; i < 8; i++) {
+        key[i] = (uint8_t)(instance->key1 >> (56 - i * 8));
+    }
+    key[8] = instance->key2 >> 8;
+    key[9] = instance->key2 & 0xFF;
+    protopirate_decode_result_set_key_bytes(result, key, sizeof(key));
+}
+
+bool subghz_protocol_decoder_ford_v0_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderFordV0* instance = context;
+    return instance->decoder.parser_step != FordV0DecoderStepReset;
+}
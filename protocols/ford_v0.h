@@ -11,10 +11,13 @@
 #include <flipper_format/flipper_format.h>
 #include <lib/toolbox/manchester_decoder.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define FORD_PROTOCOL_V0_NAME "Ford V0"
 
+extern const SubGhzBlockConst subghz_protocol_ford_v0_const;
 extern const SubGhzProtocol subghz_protocol_ford_v0;
 
 // Decoder functions
@@ -30,6 +33,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_ford_v0_serialize(
 SubGhzProtocolStatus
     subghz_protocol_decoder_ford_v0_deserialize(void* context, FlipperFormat* flipper_format);
 void subghz_protocol_decoder_ford_v0_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_ford_v0_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_ford_v0_in_frame(void* context);
 
 // Encoder functions
 void* subghz_protocol_encoder_ford_v0_alloc(SubGhzEnvironment* environment);
@@ -1,9 +1,10 @@
 #include "kia_v0.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 
 #define TAG "KiaProtocolV0"
 
-static const SubGhzBlockConst subghz_protocol_kia_const = {
+const SubGhzBlockConst subghz_protocol_kia_const = {
     .te_short = 250,
     .te_long = 500,
     .te_delta = 100,
@@ -631,18 +632,10 @@ void subghz_protocol_decoder_kia_feed(void* context, bool level, uint32_t durati
 
     case KIADecoderStepCheckDuration:
         if(!level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_kia_const.te_short) <
-                subghz_protocol_kia_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_kia_const.te_short) <
-                subghz_protocol_kia_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = KIADecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_kia_const.te_long) <
-                 subghz_protocol_kia_const.te_delta) &&
-                (DURATION_DIFF(duration, subghz_protocol_kia_const.te_long) <
-                 subghz_protocol_kia_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
+            LineCodingBit bit = line_coding_pwm_pair(
+                &subghz_protocol_kia_const, instance->decoder.te_last, duration);
+            if(line_coding_is_bit(bit)) {
+                subghz_protocol_blocks_add_bit(&instance->decoder, bit);
                 instance->decoder.parser_step = KIADecoderStepSaveDuration;
             } else {
                 FURI_LOG_W(
@@ -756,3 +749,19 @@ void subghz_protocol_decoder_kia_get_string(void* context, FuriString* output) {
         received_crc,
         crc_valid ? "(OK)" : "(FAIL)");
 }
+
+void subghz_protocol_decoder_kia_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderKIA* instance = context;
+
+    subghz_protocol_kia_check_remote_controller(&instance->generic);
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    result->crc_valid = (instance->generic.data & 0xFF) ==
+                        kia_calculate_crc(instance->generic.data);
+}
+
+bool subghz_protocol_decoder_kia_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderKIA* instance = context;
+    return instance->decoder.parser_step != KIADecoderStepReset;
+}
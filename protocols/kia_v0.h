@@ -2,6 +2,8 @@
 
 #include "kia_generic.h"
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define KIA_PROTOCOL_V0_NAME "Kia V0"
@@ -11,6 +13,7 @@ typedef struct SubGhzProtocolEncoderKIA SubGhzProtocolEncoderKIA;
 
 extern const SubGhzProtocolDecoder subghz_protocol_kia_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_kia_encoder;
+extern const SubGhzBlockConst subghz_protocol_kia_const;
 extern const SubGhzProtocol subghz_protocol_kia_v0;
 
 // Decoder functions
@@ -26,6 +29,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_kia_serialize(
 SubGhzProtocolStatus
     subghz_protocol_decoder_kia_deserialize(void* context, FlipperFormat* flipper_format);
 void subghz_protocol_decoder_kia_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_kia_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_kia_in_frame(void* context);
 
 // Encoder helper functions
 void subghz_protocol_encoder_kia_set_button(void* context, uint8_t button);
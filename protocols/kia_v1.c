@@ -1,4 +1,5 @@
 #include "kia_v1.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 #include <lib/toolbox/manchester_decoder.h>
 
@@ -8,7 +9,7 @@
 #define KIA_V1_INTER_BURST_GAP_US 25000
 #define KIA_V1_HEADER_PULSES      90
 
-static const SubGhzBlockConst kia_protocol_v1_const = {
+const SubGhzBlockConst kia_protocol_v1_const = {
     .te_short = 800,
     .te_long = 1600,
     .te_delta = 200,
@@ -468,8 +469,6 @@ void kia_protocol_decoder_v1_feed(void* context, bool level, uint32_t duration)
     furi_check(context);
     SubGhzProtocolDecoderKiaV1* instance = context;
 
-    ManchesterEvent event = ManchesterEventReset;
-
     switch(instance->decoder.parser_step) {
     case KiaV1DecoderStepReset:
         if((level) && (DURATION_DIFF(duration, kia_protocol_v1_const.te_long) <
@@ -479,11 +478,7 @@ void kia_protocol_decoder_v1_feed(void* context, bool level, uint32_t duration)
             instance->header_count = 0;
             instance->decoder.decode_data = 0;
             instance->decoder.decode_count_bit = 0;
-            manchester_advance(
-                instance->manchester_saved_state,
-                ManchesterEventReset,
-                &instance->manchester_saved_state,
-                NULL);
+            line_coding_manchester_reset(&instance->manchester_saved_state);
         }
         break;
 
@@ -513,23 +508,15 @@ void kia_protocol_decoder_v1_feed(void* context, bool level, uint32_t duration)
         }
         break;
 
-    case KiaV1DecoderStepDecodeData:
-        if((DURATION_DIFF(duration, kia_protocol_v1_const.te_short) <
-            kia_protocol_v1_const.te_delta)) {
-            event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-        } else if((DURATION_DIFF(duration, kia_protocol_v1_const.te_long) <
-                   kia_protocol_v1_const.te_delta)) {
-            event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-        }
-
-        if(event != ManchesterEventReset) {
-            bool data;
-            bool data_ok = manchester_advance(
-                instance->manchester_saved_state, event, &instance->manchester_saved_state, &data);
-            if(data_ok) {
-                instance->decoder.decode_data = (instance->decoder.decode_data << 1) | data;
-                instance->decoder.decode_count_bit++;
-            }
+    case KiaV1DecoderStepDecodeData: {
+        LineCodingBit bit = line_coding_manchester_feed(
+            &instance->manchester_saved_state,
+            &kia_protocol_v1_const,
+            LineCodingPolarityNormal,
+            level,
+            duration);
+        if(line_coding_is_bit(bit)) {
+            subghz_protocol_blocks_add_bit(&instance->decoder, bit);
         }
 
         if(instance->decoder.decode_count_bit == kia_protocol_v1_const.min_count_bit_for_found) {
@@ -544,6 +531,7 @@ void kia_protocol_decoder_v1_feed(void* context, bool level, uint32_t duration)
         }
         break;
     }
+    }
 }
 
 uint8_t kia_protocol_decoder_v1_get_hash_data(void* context) {
@@ -632,3 +620,18 @@ void kia_protocol_decoder_v1_get_string(void* context, FuriString* output) {
         instance->generic.btn,
         kia_v1_get_button_name(instance->generic.btn));
 }
+
+void kia_protocol_decoder_v1_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV1* instance = context;
+
+    kia_v1_check_remote_controller(instance);
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    result->crc_valid = instance->crc_check;
+}
+
+bool kia_protocol_decoder_v1_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV1* instance = context;
+    return instance->decoder.parser_step != KiaV1DecoderStepReset;
+}
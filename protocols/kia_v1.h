@@ -2,6 +2,8 @@
 
 #include "kia_generic.h"
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define KIA_PROTOCOL_V1_NAME "Kia V1"
@@ -11,6 +13,7 @@ typedef struct SubGhzProtocolEncoderKiaV1 SubGhzProtocolEncoderKiaV1;
 
 extern const SubGhzProtocolDecoder kia_protocol_v1_decoder;
 extern const SubGhzProtocolEncoder kia_protocol_v1_encoder;
+extern const SubGhzBlockConst kia_protocol_v1_const;
 extern const SubGhzProtocol subghz_protocol_kia_v1;
 
 // Decoder functions
@@ -26,6 +29,8 @@ SubGhzProtocolStatus kia_protocol_decoder_v1_serialize(
 SubGhzProtocolStatus
     kia_protocol_decoder_v1_deserialize(void* context, FlipperFormat* flipper_format);
 void kia_protocol_decoder_v1_get_string(void* context, FuriString* output);
+void kia_protocol_decoder_v1_get_result(void* context, ProtoPirateDecodeResult* result);
+bool kia_protocol_decoder_v1_in_frame(void* context);
 
 // Encoder functions
 void* kia_protocol_encoder_v1_alloc(SubGhzEnvironment* environment);
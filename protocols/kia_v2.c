@@ -1,4 +1,5 @@
 #include "kia_v2.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 #include <lib/toolbox/manchester_encoder.h>
 #include <furi.h>
@@ -8,7 +9,7 @@
 #define KIA_V2_HEADER_PAIRS 252
 #define KIA_V2_TOTAL_BURSTS 2
 
-static const SubGhzBlockConst kia_protocol_v2_const = {
+const SubGhzBlockConst kia_protocol_v2_const = {
     .te_short = 500,
     .te_long = 1000,
     .te_delta = 150,
@@ -390,11 +391,7 @@ void kia_protocol_decoder_v2_feed(void* context, bool level, uint32_t duration)
             instance->decoder.parser_step = KiaV2DecoderStepCheckPreamble;
             instance->decoder.te_last = duration;
             instance->header_count = 0;
-            manchester_advance(
-                instance->manchester_state,
-                ManchesterEventReset,
-                &instance->manchester_state,
-                NULL);
+            line_coding_manchester_reset(&instance->manchester_state);
         }
         break;
 
@@ -436,25 +433,19 @@ void kia_protocol_decoder_v2_feed(void* context, bool level, uint32_t duration)
         break;
 
     case KiaV2DecoderStepCollectRawBits: {
-        ManchesterEvent event;
-
-        if(DURATION_DIFF(duration, kia_protocol_v2_const.te_short) <
-           kia_protocol_v2_const.te_delta) {
-            event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-        } else if(
-            DURATION_DIFF(duration, kia_protocol_v2_const.te_long) <
-            kia_protocol_v2_const.te_delta) {
-            event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-        } else {
+        LineCodingBit bit = line_coding_manchester_feed(
+            &instance->manchester_state,
+            &kia_protocol_v2_const,
+            LineCodingPolarityNormal,
+            level,
+            duration);
+        if(bit == LineCodingBitInvalid) {
             instance->decoder.parser_step = KiaV2DecoderStepReset;
             break;
         }
 
-        bool data_bit;
-        if(manchester_advance(
-               instance->manchester_state, event, &instance->manchester_state, &data_bit)) {
-            instance->decoder.decode_data = (instance->decoder.decode_data << 1) | data_bit;
-            instance->decoder.decode_count_bit++;
+        if(line_coding_is_bit(bit)) {
+            subghz_protocol_blocks_add_bit(&instance->decoder, bit);
 
             if(instance->decoder.decode_count_bit == 53) {
                 instance->generic.data = instance->decoder.decode_data;
@@ -501,9 +492,8 @@ SubGhzProtocolStatus kia_protocol_decoder_v2_serialize(
             break;
         }
 
-        const char* preset_name = furi_string_get_cstr(preset->name);
-        const char* short_preset = protopirate_get_short_preset_name(preset_name);
-        if(!flipper_format_write_string_cstr(flipper_format, "Preset", short_preset)) {
+        if(!flipper_format_write_string_cstr(
+               flipper_format, "Preset", furi_string_get_cstr(preset->name))) {
             break;
         }
 
@@ -583,3 +573,18 @@ void kia_protocol_decoder_v2_get_string(void* context, FuriString* output) {
         crc,
         crc_valid ? "OK" : "BAD");
 }
+
+void kia_protocol_decoder_v2_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV2* instance = context;
+
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    result->crc_valid = (instance->generic.data & 0x0F) ==
+                        kia_v2_calculate_crc(instance->generic.data);
+}
+
+bool kia_protocol_decoder_v2_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV2* instance = context;
+    return instance->decoder.parser_step != KiaV2DecoderStepReset;
+}
@@ -2,7 +2,8 @@
 
 #include "kia_generic.h"
 #include <lib/toolbox/manchester_decoder.h>
-#include "protocols_common.h"
+
+#include "decode_result.h"
 
 #include "../defines.h"
 
@@ -13,6 +14,7 @@ typedef struct SubGhzProtocolEncoderKiaV2 SubGhzProtocolEncoderKiaV2;
 
 extern const SubGhzProtocolDecoder kia_protocol_v2_decoder;
 extern const SubGhzProtocolEncoder kia_protocol_v2_encoder;
+extern const SubGhzBlockConst kia_protocol_v2_const;
 extern const SubGhzProtocol subghz_protocol_kia_v2;
 
 void* kia_protocol_decoder_v2_alloc(SubGhzEnvironment* environment);
@@ -27,6 +29,8 @@ SubGhzProtocolStatus kia_protocol_decoder_v2_serialize(
 SubGhzProtocolStatus
     kia_protocol_decoder_v2_deserialize(void* context, FlipperFormat* flipper_format);
 void kia_protocol_decoder_v2_get_string(void* context, FuriString* output);
+void kia_protocol_decoder_v2_get_result(void* context, ProtoPirateDecodeResult* result);
+bool kia_protocol_decoder_v2_in_frame(void* context);
 
 void* kia_protocol_encoder_v2_alloc(SubGhzEnvironment* environment);
 void kia_protocol_encoder_v2_free(void* context);
@@ -1,4 +1,5 @@
 #include "kia_v3_v4.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 #include "keys.h"
 
@@ -11,7 +12,7 @@ static const char* kia_version_names[] = {"Kia V4", "Kia V3"};
 #define KIA_V3_V4_INTER_BURST_GAP_US 10000
 #define KIA_V3_V4_SYNC_DURATION      1200
 
-static const SubGhzBlockConst kia_protocol_v3_v4_const = {
+const SubGhzBlockConst kia_protocol_v3_v4_const = {
     .te_short = 400,
     .te_long = 800,
     .te_delta = 150,
@@ -32,6 +33,8 @@ typedef struct SubGhzProtocolDecoderKiaV3V4 {
     uint32_t decrypted;
     uint8_t crc;
     uint8_t version;
+    // The KeeLoq hop decrypted to the frame's own button and serial
+    bool hop_valid;
 } SubGhzProtocolDecoderKiaV3V4;
 
 typedef struct SubGhzProtocolEncoderKiaV3V4 {
@@ -150,6 +153,7 @@ static bool kia_v3_v4_process_buffer(SubGhzProtocolDecoderKiaV3V4* instance) {
 
     instance->encrypted = encrypted;
     instance->decrypted = decrypted;
+    instance->hop_valid = true;
     instance->crc = crc;
     instance->generic.serial = serial;
     instance->generic.btn = btn;
@@ -757,16 +761,14 @@ void kia_protocol_decoder_v3_v4_feed(void* context, bool level, uint32_t duratio
                         instance->base.callback(&instance->base, instance->base.context);
                 }
                 instance->decoder.parser_step = KiaV3V4DecoderStepReset;
-            } else if(
-                DURATION_DIFF(duration, kia_protocol_v3_v4_const.te_short) <
-                kia_protocol_v3_v4_const.te_delta) {
-                kia_v3_v4_add_raw_bit(instance, false);
-            } else if(
-                DURATION_DIFF(duration, kia_protocol_v3_v4_const.te_long) <
-                kia_protocol_v3_v4_const.te_delta) {
-                kia_v3_v4_add_raw_bit(instance, true);
             } else {
-                instance->decoder.parser_step = KiaV3V4DecoderStepReset;
+                LineCodingBit bit = line_coding_pwm_width(
+                    &kia_protocol_v3_v4_const, LineCodingPolarityNormal, duration);
+                if(line_coding_is_bit(bit)) {
+                    kia_v3_v4_add_raw_bit(instance, bit);
+                } else {
+                    instance->decoder.parser_step = KiaV3V4DecoderStepReset;
+                }
             }
         } else {
             if(duration > 1000 && duration < 1500) {
@@ -881,6 +883,8 @@ SubGhzProtocolStatus
 
     SubGhzProtocolStatus ret =
         subghz_block_generic_deserialize_check_count_bit(&instance->generic, flipper_format, 64);
+    // A file's Decrypted value is taken as is, not checked against the key
+    instance->hop_valid = false;
 
     if(ret == SubGhzProtocolStatusOk) {
         uint32_t temp = 0;
@@ -959,3 +963,27 @@ void kia_protocol_decoder_v3_v4_get_string(void* context, FuriString* output) {
             instance->generic.cnt);
     }
 }
+
+void kia_protocol_decoder_v3_v4_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV3V4* instance = context;
+
+    protopirate_decode_result_from_generic(result, &instance->generic);
+
+    // 64 data bits followed by the CRC nibble
+    uint8_t key[9];
+    for(uint8_t i = 0; i < 8; i++) {
+        key[i] = (uint8_t)(instance->generic.data >> (56 - i * 8));
+    }
+    key[8] = instance->crc << 4;
+    protopirate_decode_result_set_key_bytes(result, key, sizeof(key));
+
+    result->crc_valid = kia_v3_v4_calculate_crc(key) == instance->crc;
+    result->decrypted = instance->hop_valid;
+}
+
+bool kia_protocol_decoder_v3_v4_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV3V4* instance = context;
+    return instance->decoder.parser_step != KiaV3V4DecoderStepReset;
+}
@@ -2,10 +2,13 @@
 
 #include "kia_generic.h"
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define KIA_PROTOCOL_V3_V4_NAME "Kia V3/V4"
 
+extern const SubGhzBlockConst kia_protocol_v3_v4_const;
 extern const SubGhzProtocol subghz_protocol_kia_v3_v4;
 
 // Decoder functions
@@ -21,6 +24,8 @@ SubGhzProtocolStatus kia_protocol_decoder_v3_v4_serialize(
 SubGhzProtocolStatus
     kia_protocol_decoder_v3_v4_deserialize(void* context, FlipperFormat* flipper_format);
 void kia_protocol_decoder_v3_v4_get_string(void* context, FuriString* output);
+void kia_protocol_decoder_v3_v4_get_result(void* context, ProtoPirateDecodeResult* result);
+bool kia_protocol_decoder_v3_v4_in_frame(void* context);
 
 // Encoder functions
 void* kia_protocol_encoder_v3_v4_alloc(SubGhzEnvironment* environment);
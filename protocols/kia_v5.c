@@ -1,10 +1,11 @@
 #include "kia_v5.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 #include "keys.h"
 
 #define TAG "KiaV5"
 
-static const SubGhzBlockConst kia_protocol_v5_const = {
+const SubGhzBlockConst kia_protocol_v5_const = {
     .te_short = 400,
     .te_long = 800,
     .te_delta = 150,
@@ -176,11 +177,7 @@ void kia_protocol_decoder_v5_feed(void* context, bool level, uint32_t duration)
             instance->header_count = 1;
             instance->bit_count = 0;
             instance->decoded_data = 0;
-            manchester_advance(
-                instance->manchester_state,
-                ManchesterEventReset,
-                &instance->manchester_state,
-                NULL);
+            line_coding_manchester_reset(&instance->manchester_state);
         }
         break;
 
@@ -228,16 +225,9 @@ void kia_protocol_decoder_v5_feed(void* context, bool level, uint32_t duration)
         break;
 
     case KiaV5DecoderStepData: {
-        ManchesterEvent event;
-
-        if(DURATION_DIFF(duration, kia_protocol_v5_const.te_short) <
-           kia_protocol_v5_const.te_delta) {
-            event = level ? ManchesterEventShortHigh : ManchesterEventShortLow;
-        } else if(
-            DURATION_DIFF(duration, kia_protocol_v5_const.te_long) <
-            kia_protocol_v5_const.te_delta) {
-            event = level ? ManchesterEventLongHigh : ManchesterEventLongLow;
-        } else {
+        LineCodingPulse pulse = line_coding_classify(&kia_protocol_v5_const, duration);
+
+        if(pulse == LineCodingPulseInvalid) {
             if(instance->bit_count >= kia_protocol_v5_const.min_count_bit_for_found) {
                 instance->generic.data = instance->saved_key;
                 instance->generic.data_count_bit =
@@ -279,11 +269,13 @@ void kia_protocol_decoder_v5_feed(void* context, bool level, uint32_t duration)
             break;
         }
 
-        bool data_bit;
-        if(instance->bit_count <= 66 &&
-           manchester_advance(
-               instance->manchester_state, event, &instance->manchester_state, &data_bit)) {
-            kia_v5_add_bit(instance, data_bit);
+        LineCodingBit bit = LineCodingBitNone;
+        if(instance->bit_count <= 66) {
+            bit = line_coding_manchester_step(
+                &instance->manchester_state, pulse, LineCodingPolarityInverted, level);
+        }
+        if(line_coding_is_bit(bit)) {
+            kia_v5_add_bit(instance, bit);
 
             if(instance->bit_count == 64) {
                 instance->saved_key = instance->decoded_data;
@@ -376,3 +368,18 @@ void kia_protocol_decoder_v5_get_string(void* context, FuriString* output) {
         instance->generic.cnt,
         instance->crc);
 }
+
+void kia_protocol_decoder_v5_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV5* instance = context;
+
+    // The mixer always yields a counter and the frame carries nothing to
+    // check it against, so it is never reported as decrypted
+    protopirate_decode_result_from_generic(result, &instance->generic);
+}
+
+bool kia_protocol_decoder_v5_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV5* instance = context;
+    return instance->decoder.parser_step != KiaV5DecoderStepReset;
+}
@@ -3,6 +3,8 @@
 #include "kia_generic.h"
 #include <lib/toolbox/manchester_decoder.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define KIA_PROTOCOL_V5_NAME "Kia V5"
@@ -12,6 +14,7 @@ typedef struct SubGhzProtocolEncoderKiaV5 SubGhzProtocolEncoderKiaV5;
 
 extern const SubGhzProtocolDecoder kia_protocol_v5_decoder;
 extern const SubGhzProtocolEncoder kia_protocol_v5_encoder;
+extern const SubGhzBlockConst kia_protocol_v5_const;
 extern const SubGhzProtocol subghz_protocol_kia_v5;
 
 void* kia_protocol_decoder_v5_alloc(SubGhzEnvironment* environment);
@@ -26,3 +29,5 @@ SubGhzProtocolStatus kia_protocol_decoder_v5_serialize(
 SubGhzProtocolStatus
     kia_protocol_decoder_v5_deserialize(void* context, FlipperFormat* flipper_format);
 void kia_protocol_decoder_v5_get_string(void* context, FuriString* output);
+void kia_protocol_decoder_v5_get_result(void* context, ProtoPirateDecodeResult* result);
+bool kia_protocol_decoder_v5_in_frame(void* context);
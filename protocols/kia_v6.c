@@ -1,4 +1,6 @@
 #include "kia_v6.h"
+#include "line_coding.h"
+#include "bit_accumulator.h"
 #include "../protopirate_app_i.h"
 #include "keys.h"
 #include <furi.h>
@@ -9,7 +11,13 @@
 #define KIA_V6_XOR_MASK_LOW  0x84AF25FB
 #define KIA_V6_XOR_MASK_HIGH 0x638766AB
 
-static const SubGhzBlockConst kia_protocol_v6_const = {
+// Frame is sent inverted and starts with a fixed 1101 sync nibble. After
+// inversion: bytes 0-1 carry Fx, bytes 2-17 the AES block.
+#define KIA_V6_SYNC_BITS       0xD
+#define KIA_V6_SYNC_BIT_COUNT  4
+#define KIA_V6_AES_BLOCK_START 2
+
+const SubGhzBlockConst kia_protocol_v6_const = {
     .te_short = 200,
     .te_long = 400,
     .te_delta = 100,
@@ -66,20 +74,16 @@ struct SubGhzProtocolDecoderKiaV6 {
 
     ManchesterState manchester_state;
 
-    uint32_t data_part1_low;
-    uint32_t data_part1_high;
-
-    uint32_t stored_part1_low;
-    uint32_t stored_part1_high;
-    uint32_t stored_part2_low;
-    uint32_t stored_part2_high;
-    uint16_t data_part3;
+    BitAccumulator bits;
 
-    uint8_t bit_count;
     uint8_t fx_field;
     uint8_t crc1_field;
     uint8_t crc2_field;
     bool keys_loaded;
+    // The AES block of the current frame has been decrypted, and whether its
+    // CRC matched, so get_result and get_string reuse it
+    bool decrypted;
+    bool crc_valid;
 };
 
 struct SubGhzProtocolEncoderKiaV6 {
@@ -299,29 +303,12 @@ static void get_kia_v6_aes_key(uint8_t* aes_key) {
 static bool kia_v6_decrypt(SubGhzProtocolDecoderKiaV6* instance) {
     uint8_t encrypted_data[16];
 
-    encrypted_data[0] = (instance->stored_part1_high >> 8) & 0xFF;
-    encrypted_data[1] = instance->stored_part1_high & 0xFF;
-
-    encrypted_data[2] = (instance->stored_part1_low >> 24) & 0xFF;
-    encrypted_data[3] = (instance->stored_part1_low >> 16) & 0xFF;
-    encrypted_data[4] = (instance->stored_part1_low >> 8) & 0xFF;
-    encrypted_data[5] = instance->stored_part1_low & 0xFF;
-
-    encrypted_data[6] = (instance->stored_part2_high >> 24) & 0xFF;
-    encrypted_data[7] = (instance->stored_part2_high >> 16) & 0xFF;
-    encrypted_data[8] = (instance->stored_part2_high >> 8) & 0xFF;
-    encrypted_data[9] = instance->stored_part2_high & 0xFF;
-
-    encrypted_data[10] = (instance->stored_part2_low >> 24) & 0xFF;
-    encrypted_data[11] = (instance->stored_part2_low >> 16) & 0xFF;
-    encrypted_data[12] = (instance->stored_part2_low >> 8) & 0xFF;
-    encrypted_data[13] = instance->stored_part2_low & 0xFF;
+    bit_accumulator_export(
+        &instance->bits, KIA_V6_AES_BLOCK_START, encrypted_data, sizeof(encrypted_data));
 
-    encrypted_data[14] = (instance->data_part3 >> 8) & 0xFF;
-    encrypted_data[15] = instance->data_part3 & 0xFF;
-
-    uint8_t fx_byte0 = (instance->stored_part1_high >> 24) & 0xFF;
-    uint8_t fx_byte1 = (instance->stored_part1_high >> 16) & 0xFF;
+    const uint8_t* frame = bit_accumulator_bytes(&instance->bits);
+    uint8_t fx_byte0 = frame[0];
+    uint8_t fx_byte1 = frame[1];
     instance->fx_field = ((fx_byte0 & 0xF) << 4) | (fx_byte1 & 0xF);
 
     uint8_t aes_key[16];
@@ -353,6 +340,14 @@ static bool kia_v6_decrypt(SubGhzProtocolDecoderKiaV6* instance) {
     return (calculated_crc ^ stored_crc) < 2;
 }
 
+static bool kia_v6_ensure_decrypted(SubGhzProtocolDecoderKiaV6* instance) {
+    if(!instance->decrypted) {
+        instance->crc_valid = kia_v6_decrypt(instance);
+        instance->decrypted = true;
+    }
+    return instance->crc_valid;
+}
+
 void* kia_protocol_decoder_v6_alloc(SubGhzEnvironment* environment) {
     UNUSED(environment);
     SubGhzProtocolDecoderKiaV6* instance = malloc(sizeof(SubGhzProtocolDecoderKiaV6));
@@ -372,18 +367,14 @@ void kia_protocol_decoder_v6_reset(void* context) {
     furi_check(context);
     SubGhzProtocolDecoderKiaV6* instance = context;
     instance->decoder.parser_step = KiaV6DecoderStepReset;
-    manchester_advance(
-        instance->manchester_state, ManchesterEventReset, &instance->manchester_state, NULL);
+    line_coding_manchester_reset(&instance->manchester_state);
 }
 
 void kia_protocol_decoder_v6_feed(void* context, bool level, uint32_t duration) {
     furi_check(context);
     SubGhzProtocolDecoderKiaV6* instance = context;
 
-    uint32_t uVar4, uVar5;
-    ManchesterEvent event;
-    bool data_bit;
-    uint8_t bit_count_inc;
+    LineCodingBit bit;
     uint32_t step_value;
 
     switch(instance->decoder.parser_step) {
@@ -396,11 +387,7 @@ void kia_protocol_decoder_v6_feed(void* context, bool level, uint32_t duration)
             instance->decoder.parser_step = KiaV6DecoderStepWaitFirstHigh;
             instance->decoder.te_last = duration;
             instance->header_count = 0;
-            manchester_advance(
-                instance->manchester_state,
-                ManchesterEventReset,
-                &instance->manchester_state,
-                NULL);
+            line_coding_manchester_reset(&instance->manchester_state);
         }
         return;
 
@@ -457,82 +444,44 @@ void kia_protocol_decoder_v6_feed(void* context, bool level, uint32_t duration)
             step_value = KiaV6DecoderStepReset;
             goto LAB_reset;
         }
-        instance->decoder.decode_data = 0;
-        instance->decoder.decode_count_bit = 0;
-
-        subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-        subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-        subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-        subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-
-        instance->data_part1_low = (uint32_t)(instance->decoder.decode_data & 0xFFFFFFFF);
-        instance->data_part1_high = (uint32_t)((instance->decoder.decode_data >> 32) & 0xFFFFFFFF);
-        instance->bit_count = instance->decoder.decode_count_bit;
+        bit_accumulator_reset(&instance->bits);
+        bit_accumulator_push_bits(&instance->bits, KIA_V6_SYNC_BITS, KIA_V6_SYNC_BIT_COUNT);
+        instance->decrypted = false;
 
         instance->decoder.parser_step = KiaV6DecoderStepData;
         return;
 
     case KiaV6DecoderStepData: // case 3
-        if(DURATION_DIFF(duration, kia_protocol_v6_const.te_short) <
-           kia_protocol_v6_const.te_delta) {
-            event = (level & 0x7F) << 1;
-            goto manchester_process;
-        } else if(
-            DURATION_DIFF(duration, kia_protocol_v6_const.te_long) <
-            kia_protocol_v6_const.te_delta) {
-            event = level ? 6 : 4;
-            goto manchester_process;
+        bit = line_coding_manchester_feed(
+            &instance->manchester_state,
+            &kia_protocol_v6_const,
+            LineCodingPolarityInverted,
+            level,
+            duration);
+        if(bit == LineCodingBitInvalid) {
+            step_value = KiaV6DecoderStepReset;
+            goto LAB_reset;
         }
-        step_value = KiaV6DecoderStepReset;
-        goto LAB_reset;
 
-    manchester_process:
-        if(manchester_advance(
-               instance->manchester_state, event, &instance->manchester_state, &data_bit)) {
-            uVar4 = instance->data_part1_low;
-            uVar5 = (uVar4 << 1) | (data_bit ? 1 : 0);
-
-            uint32_t carry = (uVar4 >> 31) & 1;
-            uVar4 = (instance->data_part1_high << 1) | carry;
-
-            instance->data_part1_low = uVar5;
-            instance->data_part1_high = uVar4;
-
-            instance->decoder.decode_data = ((uint64_t)uVar4 << 32) | uVar5;
-
-            bit_count_inc = instance->bit_count + 1;
-            instance->bit_count = bit_count_inc;
-
-            if(bit_count_inc == 0x40) {
-                instance->stored_part1_low = ~uVar5;
-                instance->stored_part1_high = ~uVar4;
-                instance->data_part1_low = 0;
-                instance->data_part1_high = 0;
-            } else if(bit_count_inc == 0x80) {
-                instance->stored_part2_low = ~uVar5;
-                instance->stored_part2_high = ~uVar4;
-                instance->data_part1_low = 0;
-                instance->data_part1_high = 0;
-            }
+        if(line_coding_is_bit(bit)) {
+            bit_accumulator_push(&instance->bits, bit);
         }
 
         instance->decoder.te_last = duration;
 
-        if(instance->bit_count != kia_protocol_v6_const.min_count_bit_for_found) {
+        if(bit_accumulator_count(&instance->bits) !=
+           kia_protocol_v6_const.min_count_bit_for_found) {
             return;
         }
         instance->generic.data_count_bit = kia_protocol_v6_const.min_count_bit_for_found;
-        instance->data_part3 = ~((uint16_t)instance->data_part1_low);
+        bit_accumulator_invert(&instance->bits);
 
-        kia_v6_decrypt(instance);
+        kia_v6_ensure_decrypted(instance);
 
         if(instance->base.callback) {
             instance->base.callback(&instance->base, instance->base.context);
         }
 
-        instance->data_part1_low = 0;
-        instance->data_part1_high = 0;
-        instance->bit_count = 0;
         step_value = KiaV6DecoderStepReset;
         goto LAB_reset;
 
@@ -549,19 +498,8 @@ uint8_t kia_protocol_decoder_v6_get_hash_data(void* context) {
     furi_check(context);
     SubGhzProtocolDecoderKiaV6* instance = context;
 
-    uint8_t hash = 0;
-    uint8_t* data = (uint8_t*)&instance->data_part1_low;
-    size_t data_size = (instance->bit_count + 7) / 8;
-    size_t max_size = (kia_protocol_v6_const.min_count_bit_for_found + 7) / 8;
-    if(data_size > max_size) {
-        data_size = max_size;
-    }
-
-    for(size_t i = 0; i < data_size; i++) {
-        hash ^= data[i];
-    }
-
-    return hash;
+    return bit_accumulator_hash(
+        &instance->bits, (kia_protocol_v6_const.min_count_bit_for_found + 7) / 8);
 }
 
 SubGhzProtocolStatus kia_protocol_decoder_v6_serialize(
@@ -586,8 +524,7 @@ SubGhzProtocolStatus kia_protocol_decoder_v6_serialize(
         uint32_t bits = kia_protocol_v6_const.min_count_bit_for_found;
         if(!flipper_format_write_uint32(flipper_format, "Bit", &bits, 1)) break;
 
-        uint64_t key_data = ((uint64_t)instance->stored_part1_high << 32) |
-                            instance->stored_part1_low;
+        uint64_t key_data = bit_accumulator_get_bits(&instance->bits, 0, 64);
         char key_str[20];
         snprintf(key_str, sizeof(key_str), "%016llX", key_data);
         if(!flipper_format_write_string_cstr(flipper_format, "Key", key_str)) break;
@@ -601,13 +538,13 @@ SubGhzProtocolStatus kia_protocol_decoder_v6_serialize(
         uint32_t cnt = instance->generic.cnt;
         if(!flipper_format_write_uint32(flipper_format, "Cnt", &cnt, 1)) break;
 
-        uint32_t key2_low = instance->stored_part2_low;
+        uint32_t key2_low = bit_accumulator_get_bits(&instance->bits, 96, 32);
         if(!flipper_format_write_uint32(flipper_format, "Key_2", &key2_low, 1)) break;
 
-        uint32_t key2_high = instance->stored_part2_high;
+        uint32_t key2_high = bit_accumulator_get_bits(&instance->bits, 64, 32);
         if(!flipper_format_write_uint32(flipper_format, "Key_3", &key2_high, 1)) break;
 
-        uint32_t key3 = instance->data_part3;
+        uint32_t key3 = bit_accumulator_get_bits(&instance->bits, 128, 16);
         if(!flipper_format_write_uint32(flipper_format, "Key_4", &key3, 1)) break;
 
         ret = SubGhzProtocolStatusOk;
@@ -660,19 +597,21 @@ SubGhzProtocolStatus
             hex_pos++;
         }
 
-        instance->stored_part1_low = (uint32_t)(key & 0xFFFFFFFF);
-        instance->stored_part1_high = (uint32_t)((key >> 32) & 0xFFFFFFFF);
+        uint32_t key2_low = 0;
+        uint32_t key2_high = 0;
+        uint32_t key3 = 0;
+        flipper_format_read_uint32(flipper_format, "Key_2", &key2_low, 1);
+        flipper_format_read_uint32(flipper_format, "Key_3", &key2_high, 1);
+        flipper_format_read_uint32(flipper_format, "Key_4", &key3, 1);
+
+        bit_accumulator_reset(&instance->bits);
+        bit_accumulator_push_bits(&instance->bits, key, 64);
+        bit_accumulator_push_bits(&instance->bits, key2_high, 32);
+        bit_accumulator_push_bits(&instance->bits, key2_low, 32);
+        bit_accumulator_push_bits(&instance->bits, key3, 16);
+        instance->decrypted = false;
 
         uint32_t temp;
-        if(flipper_format_read_uint32(flipper_format, "Key_2", &temp, 1)) {
-            instance->stored_part2_low = temp;
-        }
-        if(flipper_format_read_uint32(flipper_format, "Key_3", &temp, 1)) {
-            instance->stored_part2_high = temp;
-        }
-        if(flipper_format_read_uint32(flipper_format, "Key_4", &temp, 1)) {
-            instance->data_part3 = (uint16_t)temp;
-        }
 
         if(flipper_format_read_uint32(flipper_format, "Serial", &temp, 1)) {
             instance->generic.serial = temp;
@@ -695,20 +634,15 @@ void kia_protocol_decoder_v6_get_string(void* context, FuriString* output) {
     furi_check(context);
     SubGhzProtocolDecoderKiaV6* instance = context;
 
-    kia_v6_decrypt(instance);
-
-    uint32_t key1_hi = instance->stored_part1_high;
-    uint32_t key1_lo = instance->stored_part1_low;
-    uint32_t key2_hi = instance->stored_part2_high;
-    uint32_t key2_lo = instance->stored_part2_low;
-
-    uint32_t key2_uVar4 = key2_hi << 16;
-    uint32_t key2_uVar2 = key2_lo >> 16;
-    uint32_t key2_uVar1 = key2_hi >> 16;
-    uint32_t key2_combined = key2_uVar4 | key2_uVar2;
+    kia_v6_ensure_decrypted(instance);
 
-    uint32_t key2_uVar3 = key2_lo << 16;
-    uint32_t key2_second = (instance->data_part3 & 0xFFFF) | key2_uVar3;
+    // 144-bit frame shown as 80 + 64 bits
+    const BitAccumulator* bits = &instance->bits;
+    uint32_t line1_hi = bit_accumulator_get_bits(bits, 0, 32);
+    uint32_t line1_mid = bit_accumulator_get_bits(bits, 32, 32);
+    uint32_t line1_lo = bit_accumulator_get_bits(bits, 64, 16);
+    uint32_t line2_hi = bit_accumulator_get_bits(bits, 80, 32);
+    uint32_t line2_lo = bit_accumulator_get_bits(bits, 112, 32);
 
     uint32_t serial_6 = instance->generic.serial & 0xFFFFFF;
 
@@ -721,11 +655,11 @@ void kia_protocol_decoder_v6_get_string(void* context, FuriString* output) {
         "Cnt:%08lX CRC2:%02X",
         instance->generic.protocol_name,
         instance->generic.data_count_bit,
-        key1_hi,
-        key1_lo,
-        key2_uVar1,
-        key2_combined,
-        key2_second,
+        line1_hi,
+        line1_mid,
+        line1_lo,
+        line2_hi,
+        line2_lo,
         instance->fx_field,
         serial_6,
         instance->generic.btn & 0x0F,
@@ -733,3 +667,23 @@ void kia_protocol_decoder_v6_get_string(void* context, FuriString* output) {
         instance->generic.cnt,
         instance->crc2_field);
 }
+
+void kia_protocol_decoder_v6_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV6* instance = context;
+
+    // The inner CRC only matches when the AES key was right
+    result->crc_valid = kia_v6_ensure_decrypted(instance);
+    result->decrypted = result->crc_valid;
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    protopirate_decode_result_set_key_bytes(
+        result,
+        bit_accumulator_bytes(&instance->bits),
+        bit_accumulator_byte_count(&instance->bits));
+}
+
+bool kia_protocol_decoder_v6_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderKiaV6* instance = context;
+    return instance->decoder.parser_step != KiaV6DecoderStepReset;
+}
@@ -12,6 +12,8 @@
 #include <flipper_format/flipper_format.h>
 #include "kia_generic.h"
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define KIA_PROTOCOL_V6_NAME "Kia V6"
@@ -21,6 +23,7 @@ typedef struct SubGhzProtocolEncoderKiaV6 SubGhzProtocolEncoderKiaV6;
 
 extern const SubGhzProtocolDecoder kia_protocol_v6_decoder;
 extern const SubGhzProtocolEncoder kia_protocol_v6_encoder;
+extern const SubGhzBlockConst kia_protocol_v6_const;
 extern const SubGhzProtocol subghz_protocol_kia_v6;
 
 // Decoder functions
@@ -36,3 +39,5 @@ SubGhzProtocolStatus kia_protocol_decoder_v6_serialize(
 SubGhzProtocolStatus
     kia_protocol_decoder_v6_deserialize(void* context, FlipperFormat* flipper_format);
 void kia_protocol_decoder_v6_get_string(void* context, FuriString* output);
+void kia_protocol_decoder_v6_get_result(void* context, ProtoPirateDecodeResult* result);
+bool kia_protocol_decoder_v6_in_frame(void* context);
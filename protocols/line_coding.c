@@ -0,0 +1,80 @@
+#include "line_coding.h"
+
+// [polarity][pulse][level]
+static const ManchesterEvent line_coding_manchester_events[2][2][2] = {
+    [LineCodingPolarityNormal] =
+        {
+            [LineCodingPulseShort] = {ManchesterEventShortHigh, ManchesterEventShortLow},
+            [LineCodingPulseLong] = {ManchesterEventLongHigh, ManchesterEventLongLow},
+        },
+    [LineCodingPolarityInverted] =
+        {
+            [LineCodingPulseShort] = {ManchesterEventShortLow, ManchesterEventShortHigh},
+            [LineCodingPulseLong] = {ManchesterEventLongLow, ManchesterEventLongHigh},
+        },
+};
+
+// [high][low]
+static const LineCodingBit line_coding_pwm_pairs[3][3] = {
+    [LineCodingPulseShort] = {LineCodingBit0, LineCodingBitInvalid, LineCodingBitInvalid},
+    [LineCodingPulseLong] = {LineCodingBitInvalid, LineCodingBit1, LineCodingBitInvalid},
+    [LineCodingPulseInvalid] = {LineCodingBitInvalid, LineCodingBitInvalid, LineCodingBitInvalid},
+};
+
+// [polarity][high]
+static const LineCodingBit line_coding_pwm_widths[2][3] = {
+    [LineCodingPolarityNormal] = {LineCodingBit0, LineCodingBit1, LineCodingBitInvalid},
+    [LineCodingPolarityInverted] = {LineCodingBit1, LineCodingBit0, LineCodingBitInvalid},
+};
+
+LineCodingPulse line_coding_classify(const SubGhzBlockConst* timing, uint32_t duration) {
+    if(DURATION_DIFF(duration, timing->te_short) < timing->te_delta) {
+        return LineCodingPulseShort;
+    }
+    if(DURATION_DIFF(duration, timing->te_long) < timing->te_delta) {
+        return LineCodingPulseLong;
+    }
+    return LineCodingPulseInvalid;
+}
+
+void line_coding_manchester_reset(ManchesterState* state) {
+    manchester_advance(*state, ManchesterEventReset, state, NULL);
+}
+
+LineCodingBit line_coding_manchester_step(
+    ManchesterState* state,
+    LineCodingPulse pulse,
+    LineCodingPolarity polarity,
+    bool level) {
+    if(pulse == LineCodingPulseInvalid) return LineCodingBitInvalid;
+
+    bool data;
+    if(!manchester_advance(
+           *state, line_coding_manchester_events[polarity][pulse][level], state, &data)) {
+        return LineCodingBitNone;
+    }
+    return data ? LineCodingBit1 : LineCodingBit0;
+}
+
+LineCodingBit line_coding_manchester_feed(
+    ManchesterState* state,
+    const SubGhzBlockConst* timing,
+    LineCodingPolarity polarity,
+    bool level,
+    uint32_t duration) {
+    return line_coding_manchester_step(
+        state, line_coding_classify(timing, duration), polarity, level);
+}
+
+LineCodingBit
+    line_coding_pwm_pair(const SubGhzBlockConst* timing, uint32_t high, uint32_t low) {
+    return line_coding_pwm_pairs[line_coding_classify(timing, high)]
+                                [line_coding_classify(timing, low)];
+}
+
+LineCodingBit line_coding_pwm_width(
+    const SubGhzBlockConst* timing,
+    LineCodingPolarity polarity,
+    uint32_t high) {
+    return line_coding_pwm_widths[polarity][line_coding_classify(timing, high)];
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <furi.h>
+#include <lib/subghz/blocks/const.h>
+#include <lib/toolbox/manchester_decoder.h>
+
+// Shared pulse slicers for the decoders. Each protocol keeps its own
+// preamble/sync handling and hands data-phase pulses to one of these.
+
+typedef enum {
+    LineCodingPulseShort,
+    LineCodingPulseLong,
+    LineCodingPulseInvalid,
+} LineCodingPulse;
+
+// Bit0/Bit1 double as the bit value, so callers can pass the result straight
+// to an add_bit helper once line_coding_is_bit() says it is one
+typedef enum {
+    LineCodingBit0 = 0,
+    LineCodingBit1 = 1,
+    LineCodingBitNone, // Valid pulse, no bit completed yet
+    LineCodingBitInvalid, // Pulse does not fit the timing family
+} LineCodingBit;
+
+typedef enum {
+    // Manchester: high pulse -> ManchesterEvent*Low. PWM width: short = 0
+    LineCodingPolarityNormal,
+    // Manchester: high pulse -> ManchesterEvent*High. PWM width: short = 1
+    LineCodingPolarityInverted,
+} LineCodingPolarity;
+
+static inline bool line_coding_is_bit(LineCodingBit bit) {
+    return bit <= LineCodingBit1;
+}
+
+// Match duration against te_short, then te_long (both strictly within te_delta)
+LineCodingPulse line_coding_classify(const SubGhzBlockConst* timing, uint32_t duration);
+
+void line_coding_manchester_reset(ManchesterState* state);
+
+// Advance the Manchester state with an already classified pulse. Invalid
+// pulses leave the state untouched and return LineCodingBitInvalid.
+LineCodingBit line_coding_manchester_step(
+    ManchesterState* state,
+    LineCodingPulse pulse,
+    LineCodingPolarity polarity,
+    bool level);
+
+// Classify and advance in one call
+LineCodingBit line_coding_manchester_feed(
+    ManchesterState* state,
+    const SubGhzBlockConst* timing,
+    LineCodingPolarity polarity,
+    bool level,
+    uint32_t duration);
+
+// PWM where both halves have the same width: short+short = 0, long+long = 1
+LineCodingBit
+    line_coding_pwm_pair(const SubGhzBlockConst* timing, uint32_t high, uint32_t low);
+
+// PWM/PPM where only the high pulse width carries the bit
+LineCodingBit line_coding_pwm_width(
+    const SubGhzBlockConst* timing,
+    LineCodingPolarity polarity,
+    uint32_t high);
@@ -0,0 +1,86 @@
+#pragma once
+
+// Single source of truth for the registry order. Each entry is
+// X(id, protocol, timing, get_result, in_frame) where timing is the decoder's
+// own SubGhzBlockConst, so the timing table can never drift from the decoders,
+// get_result fills a ProtoPirateDecodeResult from a live decoder and in_frame
+// tells whether a live decoder is partway through a frame.
+// Kept free of includes so decoder headers can use the ids.
+#define PROTOPIRATE_PROTOCOL_LIST(X)                 \
+    X(ScherKhan,                                     \
+      subghz_protocol_scher_khan,                    \
+      subghz_protocol_scher_khan_const,              \
+      subghz_protocol_decoder_scher_khan_get_result, \
+      subghz_protocol_decoder_scher_khan_in_frame)   \
+    X(KiaV0,                                         \
+      subghz_protocol_kia_v0,                        \
+      subghz_protocol_kia_const,                     \
+      subghz_protocol_decoder_kia_get_result,        \
+      subghz_protocol_decoder_kia_in_frame)          \
+    X(KiaV1,                                         \
+      subghz_protocol_kia_v1,                        \
+      kia_protocol_v1_const,                         \
+      kia_protocol_decoder_v1_get_result,            \
+      kia_protocol_decoder_v1_in_frame)              \
+    X(KiaV2,                                         \
+      subghz_protocol_kia_v2,                        \
+      kia_protocol_v2_const,                         \
+      kia_protocol_decoder_v2_get_result,            \
+      kia_protocol_decoder_v2_in_frame)              \
+    X(KiaV3V4,                                       \
+      subghz_protocol_kia_v3_v4,                     \
+      kia_protocol_v3_v4_const,                      \
+      kia_protocol_decoder_v3_v4_get_result,         \
+      kia_protocol_decoder_v3_v4_in_frame)           \
+    X(KiaV5,                                         \
+      subghz_protocol_kia_v5,                        \
+      kia_protocol_v5_const,                         \
+      kia_protocol_decoder_v5_get_result,            \
+      kia_protocol_decoder_v5_in_frame)              \
+    X(KiaV6,                                         \
+      subghz_protocol_kia_v6,                        \
+      kia_protocol_v6_const,                         \
+      kia_protocol_decoder_v6_get_result,            \
+      kia_protocol_decoder_v6_in_frame)              \
+    X(FordV0,                                        \
+      subghz_protocol_ford_v0,                       \
+      subghz_protocol_ford_v0_const,                 \
+      subghz_protocol_decoder_ford_v0_get_result,    \
+      subghz_protocol_decoder_ford_v0_in_frame)      \
+    X(FiatV0,                                        \
+      subghz_protocol_fiat_v0,                       \
+      subghz_protocol_fiat_v0_const,                 \
+      subghz_protocol_decoder_fiat_v0_get_result,    \
+      subghz_protocol_decoder_fiat_v0_in_frame)      \
+    X(Subaru,                                        \
+      subghz_protocol_subaru,                        \
+      subghz_protocol_subaru_const,                  \
+      subghz_protocol_decoder_subaru_get_result,     \
+      subghz_protocol_decoder_subaru_in_frame)       \
+    X(Suzuki,                                        \
+      subghz_protocol_suzuki,                        \
+      subghz_protocol_suzuki_const,                  \
+      subghz_protocol_decoder_suzuki_get_result,     \
+      subghz_protocol_decoder_suzuki_in_frame)       \
+    X(Vag,                                           \
+      subghz_protocol_vag,                           \
+      subghz_protocol_vag_const,                     \
+      subghz_protocol_decoder_vag_get_result,        \
+      subghz_protocol_decoder_vag_in_frame)          \
+    X(StarLine,                                      \
+      subghz_protocol_star_line,                     \
+      subghz_protocol_star_line_const,               \
+      subghz_protocol_decoder_star_line_get_result,  \
+      subghz_protocol_decoder_star_line_in_frame)    \
+    X(Psa,                                           \
+      subghz_protocol_psa,                           \
+      subghz_protocol_psa_const,                     \
+      subghz_protocol_decoder_psa_get_result,        \
+      subghz_protocol_decoder_psa_in_frame)
+
+// Registry index of each protocol
+#define PROTOPIRATE_PROTOCOL_ID(id, proto, block, result, in_frame) ProtoPirateProtocolId##id,
+typedef enum {
+    PROTOPIRATE_PROTOCOL_LIST(PROTOPIRATE_PROTOCOL_ID) ProtoPirateProtocolIdCount,
+} ProtoPirateProtocolId;
+#undef PROTOPIRATE_PROTOCOL_ID
@@ -1,22 +1,15 @@
 #include "protocol_items.h"
 #include <string.h>
 
+// Heap: free figures per protocol, measured with only that protocol enabled
+// ScherKhan 16320, KiaV0 16976, KiaV1 17192, KiaV2 16944, KiaV3V4 18432,
+// KiaV5 16528, KiaV6 18296, FordV0 19456, FiatV0 16864, Subaru 17280,
+// Suzuki 16064, Vag 29352, StarLine 18632, Psa 25408
+#define PROTOPIRATE_REGISTRY_ITEM(id, proto, block, result, in_frame) \
+    [ProtoPirateProtocolId##id] = &proto,
 const SubGhzProtocol* protopirate_protocol_registry_items[] = {
-    &subghz_protocol_scher_khan, // Heap: free 16320
-    &subghz_protocol_kia_v0, // Heap: free 16976
-    &subghz_protocol_kia_v1, // Heap: free 17192
-    &subghz_protocol_kia_v2, // Heap: free 16944
-    &subghz_protocol_kia_v3_v4, // Heap: free 18432
-    &subghz_protocol_kia_v5, // Heap: free 16528
-    &subghz_protocol_kia_v6, // Heap: free 18296
-    &subghz_protocol_ford_v0, // Heap: free 19456
-    &subghz_protocol_fiat_v0, // Heap: free 16864
-    &subghz_protocol_subaru, // Heap: free 17280
-    &subghz_protocol_suzuki, // Heap: free 16064
-    &subghz_protocol_vag, // Heap: free 29352
-    &subghz_protocol_star_line, // Heap: free 18632
-    &subghz_protocol_psa, // Heap: free 25408
-};
+    PROTOPIRATE_PROTOCOL_LIST(PROTOPIRATE_REGISTRY_ITEM)};
+#undef PROTOPIRATE_REGISTRY_ITEM
 // TODO: See above
 // Current HEAP situation:
 // All enabled
@@ -31,212 +24,151 @@ const SubGhzProtocolRegistry protopirate_protocol_registry = {
     .size = COUNT_OF(protopirate_protocol_registry_items),
 };
 
-// Protocol timing definitions - mirrors the SubGhzBlockConst in each protocol
+// Protocol timing definitions - points at the SubGhzBlockConst in each protocol
+#define PROTOPIRATE_TIMING_ITEM(id, proto, block, result, in_frame) \
+    [ProtoPirateProtocolId##id] = {.protocol = &proto, .timing = &block},
 static const ProtoPirateProtocolTiming protocol_timings[] = {
-    // Kia V0: PWM encoding, 250/500µs
-    {
-        .name = "Kia V0",
-        .te_short = 250,
-        .te_long = 500,
-        .te_delta = 100,
-        .min_count_bit = 61,
-    },
-    // Kia V1: OOK PCM 800µs timing
-    {
-        .name = "Kia V1",
-        .te_short = 800,
-        .te_long = 1600,
-        .te_delta = 200,
-        .min_count_bit = 56,
-    },
-    // Kia V2: Manchester 500/1000µs
-    {
-        .name = "Kia V2",
-        .te_short = 500,
-        .te_long = 1000,
-        .te_delta = 150,
-        .min_count_bit = 51,
-    },
-    // Kia V3/V4: PWM 400/800µs
-    {
-        .name = "Kia V3/V4",
-        .te_short = 400,
-        .te_long = 800,
-        .te_delta = 150,
-        .min_count_bit = 64,
-    },
-    // Kia V5: PWM 400/800µs (same as V3/V4)
-    {
-        .name = "Kia V5",
-        .te_short = 400,
-        .te_long = 800,
-        .te_delta = 150,
-        .min_count_bit = 64,
-    },
-    // Kia V6: Manchester 200/400µs
-    {
-        .name = "Kia V6",
-        .te_short = 200,
-        .te_long = 400,
-        .te_delta = 100,
-        .min_count_bit = 144,
-    },
-    // Ford V0: Manchester 250/500µs
-    {
-        .name = "Ford V0",
-        .te_short = 250,
-        .te_long = 500,
-        .te_delta = 100,
-        .min_count_bit = 64,
-    },
-    // Fiat V0: Manchester 200/400µs
-    {
-        .name = "Fiat V0",
-        .te_short = 200,
-        .te_long = 400,
-        .te_delta = 100,
-        .min_count_bit = 64,
-    },
-    // Subaru: PPM 800/1600µs
-    {
-        .name = "Subaru",
-        .te_short = 800,
-        .te_long = 1600,
-        .te_delta = 200,
-        .min_count_bit = 64,
-    },
-    // Suzuki: PWM 250/500µs
-    {
-        .name = "Suzuki",
-        .te_short = 250,
-        .te_long = 500,
-        .te_delta = 100,
-        .min_count_bit = 64,
-    },
-    // VW: Manchester 500/1000µs
-    {
-        .name = "VW",
-        .te_short = 500,
-        .te_long = 1000,
-        .te_delta = 120,
-        .min_count_bit = 80,
-    },
-    // Scher-Khan: PWM 750/1100µs
-    {
-        .name = "Scher-Khan",
-        .te_short = 750,
-        .te_long = 1100,
-        .te_delta = 180,
-        .min_count_bit = 35,
-    },
-    // Star Line: PWM 250/500µs
-    {
-        .name = "Star Line",
-        .te_short = 250,
-        .te_long = 500,
-        .te_delta = 120,
-        .min_count_bit = 64,
-    },
-    // PSA: Manchester 250/500µs (Pattern 1) or 125/250µs (Pattern 2)
-    {
-        .name = "PSA",
-        .te_short = 250,
-        .te_long = 500,
-        .te_delta = 100,
-        .min_count_bit = 128,
-    },
-};
-
-static const size_t protocol_timings_count = COUNT_OF(protocol_timings);
+    PROTOPIRATE_PROTOCOL_LIST(PROTOPIRATE_TIMING_ITEM)};
+#undef PROTOPIRATE_TIMING_ITEM
+
+_Static_assert(
+    COUNT_OF(protocol_timings) == ProtoPirateProtocolIdCount,
+    "timing table must cover the registry");
+
+ProtoPirateProtocolId protopirate_protocol_id(const SubGhzProtocol* protocol) {
+    // Pointer identity only, no string matching
+    size_t i = 0;
+    while(i < ProtoPirateProtocolIdCount && protopirate_protocol_registry_items[i] != protocol) {
+        i++;
+    }
+    return i;
+}
 
-const ProtoPirateProtocolTiming* protopirate_get_protocol_timing(const char* protocol_name) {
-    if(!protocol_name) return NULL;
+const ProtoPirateProtocolTiming* protopirate_get_protocol_timing(const SubGhzProtocol* protocol) {
+    if(!protocol) return NULL;
+    return protopirate_get_protocol_timing_by_index(protopirate_protocol_id(protocol));
+}
 
-    for(size_t i = 0; i < protocol_timings_count; i++) {
-        // Check for exact match or if the protocol name contains our timing name
-        if(strcmp(protocol_name, protocol_timings[i].name) == 0 ||
-           strstr(protocol_name, protocol_timings[i].name) != NULL) {
-            return &protocol_timings[i];
-        }
-    }
+const ProtoPirateProtocolTiming* protopirate_get_protocol_timing_by_index(size_t index) {
+    if(index >= ProtoPirateProtocolIdCount) return NULL;
+    return &protocol_timings[index];
+}
 
-    // Try partial matching for version variants
-    for(size_t i = 0; i < protocol_timings_count; i++) {
-        // Match "Kia" protocols
-        if(strstr(protocol_name, "Kia") != NULL || strstr(protocol_name, "KIA") != NULL ||
-           strstr(protocol_name, "HYU") != NULL) {
-            // Try to match version number
-            if(strstr(protocol_name, "V0") != NULL &&
-               strstr(protocol_timings[i].name, "V0") != NULL) {
-                return &protocol_timings[i];
-            }
-            if(strstr(protocol_name, "V1") != NULL &&
-               strstr(protocol_timings[i].name, "V1") != NULL) {
-                return &protocol_timings[i];
-            }
-            if(strstr(protocol_name, "V2") != NULL &&
-               strstr(protocol_timings[i].name, "V2") != NULL) {
-                return &protocol_timings[i];
-            }
-            if((strstr(protocol_name, "V3") != NULL || strstr(protocol_name, "V4") != NULL) &&
-               strstr(protocol_timings[i].name, "V3/V4") != NULL) {
-                return &protocol_timings[i];
-            }
-            if(strstr(protocol_name, "V5") != NULL &&
-               strstr(protocol_timings[i].name, "V5") != NULL) {
-                return &protocol_timings[i];
-            }
-        }
+size_t protopirate_get_protocol_timing_count(void) {
+    return ProtoPirateProtocolIdCount;
+}
 
-        // Match Ford
-        if(strstr(protocol_name, "Ford") != NULL &&
-           strstr(protocol_timings[i].name, "Ford") != NULL) {
-            return &protocol_timings[i];
-        }
+// Result fillers, indexed like the registry
+typedef void (*ProtoPirateGetResult)(void* context, ProtoPirateDecodeResult* result);
+#define PROTOPIRATE_RESULT_ITEM(id, proto, block, result, in_frame) \
+    [ProtoPirateProtocolId##id] = result,
+static const ProtoPirateGetResult protocol_results[] = {
+    PROTOPIRATE_PROTOCOL_LIST(PROTOPIRATE_RESULT_ITEM)};
+#undef PROTOPIRATE_RESULT_ITEM
+
+_Static_assert(
+    COUNT_OF(protocol_results) == ProtoPirateProtocolIdCount,
+    "result table must cover the registry");
+
+bool protopirate_decoder_get_result(
+    SubGhzProtocolDecoderBase* decoder,
+    ProtoPirateDecodeResult* result) {
+    furi_check(result);
+    memset(result, 0, sizeof(*result));
+    if(!decoder) return false;
+
+    ProtoPirateProtocolId id = protopirate_protocol_id(decoder->protocol);
+    if(id >= ProtoPirateProtocolIdCount) return false;
+
+    result->protocol_id = id;
+    protocol_results[id](decoder, result);
+    if(result->bits >= protocol_timings[id].timing->min_count_bit_for_found) result->full = true;
+    return true;
+}
 
-        // Match Fiat
-        if(strstr(protocol_name, "Fiat") != NULL &&
-           strstr(protocol_timings[i].name, "Fiat") != NULL) {
-            return &protocol_timings[i];
+// Mid-frame probes, indexed like the registry
+typedef bool (*ProtoPirateInFrame)(void* context);
+#define PROTOPIRATE_IN_FRAME_ITEM(id, proto, block, result, in_frame) \
+    [ProtoPirateProtocolId##id] = in_frame,
+static const ProtoPirateInFrame protocol_in_frame[] = {
+    PROTOPIRATE_PROTOCOL_LIST(PROTOPIRATE_IN_FRAME_ITEM)};
+#undef PROTOPIRATE_IN_FRAME_ITEM
+
+_Static_assert(
+    COUNT_OF(protocol_in_frame) == ProtoPirateProtocolIdCount,
+    "in_frame table must cover the registry");
+
+size_t protopirate_receiver_recover(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* const decoders[ProtoPirateProtocolIdCount],
+    uint32_t gap_us) {
+    furi_check(receiver);
+    furi_check(decoders);
+
+    // A long quiet gap is how every decoder sees the end of a frame, so most
+    // of them drop back to their idle step on their own, and any that had
+    // enough of a frame report it through the receiver callback
+    subghz_receiver_decode(receiver, false, gap_us);
+
+    // Whatever is still partway through a frame now has lost its tail
+    size_t lost = 0;
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        SubGhzProtocolDecoderBase* decoder = decoders[i];
+        if(decoder && protocol_in_frame[i](decoder)) {
+            decoder->protocol->decoder->reset(decoder);
+            lost++;
         }
+    }
 
-        // Match Subaru
-        if(strstr(protocol_name, "Subaru") != NULL &&
-           strstr(protocol_timings[i].name, "Subaru") != NULL) {
-            return &protocol_timings[i];
-        }
+    return lost;
+}
 
-        // Match Suzuki
-        if(strstr(protocol_name, "Suzuki") != NULL &&
-           strstr(protocol_timings[i].name, "Suzuki") != NULL) {
-            return &protocol_timings[i];
-        }
+void protopirate_receiver_get_decoders(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoders[ProtoPirateProtocolIdCount]) {
+    furi_check(receiver);
+    furi_check(decoders);
 
-        // Match VW
-        if(strstr(protocol_name, "VW") != NULL && strstr(protocol_timings[i].name, "VW") != NULL) {
-            return &protocol_timings[i];
-        }
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        decoders[i] = subghz_receiver_search_decoder_base_by_name(
+            receiver, protopirate_protocol_registry_items[i]->name);
+    }
+}
 
-        // Match Scher-Khan
-        if(strstr(protocol_name, "Scher-Khan") != NULL &&
-           strstr(protocol_timings[i].name, "Scher-Khan") != NULL) {
-            return &protocol_timings[i];
-        }
-        // Match Star Line
-        if(strstr(protocol_name, "Star Line") != NULL &&
-           strstr(protocol_timings[i].name, "Star Line") != NULL) {
-            return &protocol_timings[i];
+size_t protopirate_receiver_reset_others(
+    SubGhzProtocolDecoderBase* const decoders[ProtoPirateProtocolIdCount],
+    ProtoPirateProtocolId keep) {
+    furi_check(decoders);
+
+    size_t reset = 0;
+    for(size_t i = 0; i < ProtoPirateProtocolIdCount; i++) {
+        SubGhzProtocolDecoderBase* decoder = decoders[i];
+        if(i == keep || !decoder) continue;
+        if(protocol_in_frame[i](decoder)) {
+            decoder->protocol->decoder->reset(decoder);
+            reset++;
         }
     }
+    return reset;
+}
+
+uint8_t protopirate_decode_result_score(const ProtoPirateDecodeResult* result) {
+    furi_check(result);
 
-    return NULL;
+    uint8_t score = 0;
+    if(result->crc_valid) score += PROTOPIRATE_SCORE_CRC;
+    if(result->decrypted) score += PROTOPIRATE_SCORE_DECRYPTED;
+    if(result->full) score += PROTOPIRATE_SCORE_FULL;
+    return score;
 }
 
-const ProtoPirateProtocolTiming* protopirate_get_protocol_timing_by_index(size_t index) {
-    if(index >= protocol_timings_count) return NULL;
-    return &protocol_timings[index];
+const char* protopirate_protocol_name(ProtoPirateProtocolId protocol_id) {
+    if(protocol_id >= ProtoPirateProtocolIdCount) return NULL;
+    return protopirate_protocol_registry_items[protocol_id]->name;
 }
 
-size_t protopirate_get_protocol_timing_count(void) {
-    return protocol_timings_count;
+bool protopirate_protocol_can_emulate(ProtoPirateProtocolId protocol_id) {
+    if(protocol_id >= ProtoPirateProtocolIdCount) return false;
+    const SubGhzProtocolEncoder* encoder = protopirate_protocol_registry_items[protocol_id]->encoder;
+    return encoder && encoder->alloc;
 }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <lib/subghz/types.h>
+#include <lib/subghz/receiver.h>
 
 #include "kia_generic.h"
 #include "scher_khan.h"
@@ -19,22 +20,67 @@
 #include "star_line.h"
 #include "psa.h"
 
+#include "protocol_ids.h"
+#include "decode_result.h"
+
 extern const SubGhzProtocolRegistry protopirate_protocol_registry;
 
-// Timing information for protocol analysis
+// Timing information for protocol analysis, one entry per registry index
 typedef struct {
-    const char* name;
-    uint32_t te_short;
-    uint32_t te_long;
-    uint32_t te_delta;
-    uint32_t min_count_bit;
+    const SubGhzProtocol* protocol;
+    const SubGhzBlockConst* timing;
 } ProtoPirateProtocolTiming;
 
-// Get timing info for a protocol by name (returns NULL if not found)
-const ProtoPirateProtocolTiming* protopirate_get_protocol_timing(const char* protocol_name);
+// Get timing info for a protocol (returns NULL if it is not in the registry)
+const ProtoPirateProtocolTiming* protopirate_get_protocol_timing(const SubGhzProtocol* protocol);
 
-// Get timing info by index (for iteration)
+// Get timing info by registry index (for iteration)
 const ProtoPirateProtocolTiming* protopirate_get_protocol_timing_by_index(size_t index);
 
 // Get number of protocols with timing info
 size_t protopirate_get_protocol_timing_count(void);
+
+// Registry id of a protocol (ProtoPirateProtocolIdCount if it is not ours)
+ProtoPirateProtocolId protopirate_protocol_id(const SubGhzProtocol* protocol);
+
+// Fill result from a live decoder of one of our protocols. Returns false for
+// foreign protocols, leaving result zeroed.
+bool protopirate_decoder_get_result(
+    SubGhzProtocolDecoderBase* decoder,
+    ProtoPirateDecodeResult* result);
+
+// Recover from dropped samples without a full receiver reset: feed a quiet
+// gap of gap_us so decoders resynchronise the normal way, then reset only the
+// ones in decoders (see protopirate_receiver_get_decoders) still partway
+// through a frame. Returns how many were reset, i.e. how many partial frames
+// the drop cost; frames the gap completed are not counted.
+size_t protopirate_receiver_recover(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* const decoders[ProtoPirateProtocolIdCount],
+    uint32_t gap_us);
+
+// Our decoders inside the receiver, indexed by protocol id (NULL for any the
+// receiver does not have)
+void protopirate_receiver_get_decoders(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoders[ProtoPirateProtocolIdCount]);
+
+// Reset every decoder in decoders (see protopirate_receiver_get_decoders) that
+// is partway through a frame, except the one with id keep. Returns how many
+// were reset.
+size_t protopirate_receiver_reset_others(
+    SubGhzProtocolDecoderBase* const decoders[ProtoPirateProtocolIdCount],
+    ProtoPirateProtocolId keep);
+
+// Arbitration score of a decode: CRC valid beats decrypted beats a full
+// length frame
+#define PROTOPIRATE_SCORE_CRC       4
+#define PROTOPIRATE_SCORE_DECRYPTED 2
+#define PROTOPIRATE_SCORE_FULL      1
+uint8_t protopirate_decode_result_score(const ProtoPirateDecodeResult* result);
+
+// Registry name of a protocol id (NULL when out of range)
+const char* protopirate_protocol_name(ProtoPirateProtocolId protocol_id);
+
+// Whether the protocol has an encoder we can transmit with
+bool protopirate_protocol_can_emulate(ProtoPirateProtocolId protocol_id);
@@ -1,5 +0,0 @@
-#pragma once
-
-#include <lib/subghz/types.h>
-
-const char* protopirate_get_short_preset_name(const char* preset_name);
@@ -1,8 +1,10 @@
 #include "psa.h"
+#include "line_coding.h"
+#include "bit_accumulator.h"
 
 #define TAG "PSAProtocol"
 
-static const SubGhzBlockConst subghz_protocol_psa_const = {
+const SubGhzBlockConst subghz_protocol_psa_const = {
     .te_short = 250,
     .te_long = 500,
     .te_delta = 100,
@@ -63,9 +65,7 @@ struct SubGhzProtocolDecoderPSA {
     uint32_t state;
     uint32_t prev_duration;
 
-    uint32_t decode_data_low;
-    uint32_t decode_data_high;
-    uint8_t decode_count_bit;
+    BitAccumulator bits;
 
     uint32_t seed;
     uint32_t key1_low;
@@ -87,6 +87,9 @@ struct SubGhzProtocolDecoderPSA {
     uint16_t decrypted_crc;
     uint32_t decrypted_seed;
     uint8_t decrypted_type;
+    // The router has run for the latched frame, successful or not, so
+    // get_result and get_string don't brute force it again
+    bool decrypt_tried;
 };
 
 #ifdef ENABLE_EMULATE_FEATURE
@@ -1136,9 +1139,7 @@ void subghz_protocol_decoder_psa_reset(void* context) {
     instance->key1_high = 0;
     instance->key2_low = 0;
     instance->key2_high = 0;
-    instance->decode_data_low = 0;
-    instance->decode_data_high = 0;
-    instance->decode_count_bit = 0;
+    bit_accumulator_reset(&instance->bits);
     instance->pattern_counter = 0;
     instance->manchester_state = ManchesterStateMid1;
     instance->decrypted_button = 0;
@@ -1147,6 +1148,24 @@ void subghz_protocol_decoder_psa_reset(void* context) {
     instance->decrypted_crc = 0;
     instance->decrypted_seed = 0;
     instance->decrypted_type = 0;
+    instance->decrypt_tried = false;
+}
+
+// Key1 carries 0xA in bits 12-15 (bits 19-16 of key1_high)
+static bool psa_frame_type_valid(const SubGhzProtocolDecoderPSA* instance) {
+    return bit_accumulator_get_bits(&instance->bits, 12, 4) == 0xA;
+}
+
+// Copy a completed frame into the Key1/Key2 words used by decrypt and serialize
+static void psa_latch_keys(SubGhzProtocolDecoderPSA* instance) {
+    uint64_t key1 = bit_accumulator_get_bits(&instance->bits, 0, PSA_KEY1_BITS);
+    instance->key1_low = (uint32_t)key1;
+    instance->key1_high = (uint32_t)(key1 >> 32);
+    instance->key2_low = (uint32_t)bit_accumulator_get_bits(
+        &instance->bits, PSA_KEY1_BITS, PSA_KEY2_BITS - PSA_KEY1_BITS);
+    instance->key2_high = 0;
+    instance->validation_field = (uint16_t)instance->key2_low;
+    instance->decrypt_tried = false;
 }
 
 void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t duration) {
@@ -1191,10 +1210,8 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
             new_state = PSADecoderState1;
         }
 
-        instance->decode_data_low = 0;
-        instance->decode_data_high = 0;
+        bit_accumulator_reset(&instance->bits);
         instance->pattern_counter = 0;
-        instance->decode_count_bit = 0;
         instance->mode_serialize = 0;
         instance->prev_duration = duration;
         instance->decrypted_type = 0;
@@ -1204,8 +1221,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
         instance->decrypted_crc = 0;
         instance->decrypted_seed = 0;
         instance->decrypted = 0x00;
-        manchester_advance(
-            instance->manchester_state, ManchesterEventReset, &instance->manchester_state, NULL);
+        line_coding_manchester_reset(&instance->manchester_state);
         break;
 
     case PSADecoderState1:
@@ -1246,14 +1262,8 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                             "[State1->State2] Transition detected with pattern_cnt=%lu",
                             (unsigned long)instance->pattern_counter);
                         new_state = PSADecoderState2;
-                        instance->decode_data_low = 0;
-                        instance->decode_data_high = 0;
-                        instance->decode_count_bit = 0;
-                        manchester_advance(
-                            instance->manchester_state,
-                            ManchesterEventReset,
-                            &instance->manchester_state,
-                            NULL);
+                        bit_accumulator_reset(&instance->bits);
+                        line_coding_manchester_reset(&instance->manchester_state);
                         instance->state = new_state;
                     }
                     instance->pattern_counter = 0;
@@ -1268,12 +1278,12 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
         break;
 
     case PSADecoderState2:
-        if(instance->decode_count_bit >= PSA_MAX_BITS) {
+        if(bit_accumulator_count(&instance->bits) >= PSA_MAX_BITS) {
             new_state = PSADecoderState0;
             break;
         }
 
-        if(level && instance->decode_count_bit == PSA_KEY2_BITS) {
+        if(level && bit_accumulator_count(&instance->bits) == PSA_KEY2_BITS) {
             if(duration >= 800) {
                 uint32_t end_diff;
                 if(duration < PSA_TE_END_1000) {
@@ -1282,18 +1292,13 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                     end_diff = duration - PSA_TE_END_1000;
                 }
                 if(end_diff <= 199) {
-                    if(((instance->key1_high >> 16) & 0xF) != 0xA) {
-                        instance->decode_data_low = 0;
-                        instance->decode_data_high = 0;
-                        instance->decode_count_bit = 0;
+                    if(!psa_frame_type_valid(instance)) {
+                        bit_accumulator_reset(&instance->bits);
                         new_state = PSADecoderState0;
                         instance->state = new_state;
                         return;
                     }
 
-                    uint32_t new_key2_low = instance->decode_data_low;
-                    instance->validation_field = (uint16_t)(instance->decode_data_low & 0xFFFF);
-
                     instance->decrypted_type = 0;
                     instance->decrypted_button = 0;
                     instance->decrypted_serial = 0;
@@ -1302,8 +1307,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                     instance->decrypted_seed = 0;
                     instance->decrypted = 0x00;
 
-                    instance->key2_low = new_key2_low;
-                    instance->key2_high = instance->decode_data_high;
+                    psa_latch_keys(instance);
                     instance->mode_serialize = 1;
                     instance->status_flag = 0x80;
 
@@ -1339,9 +1343,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                         instance->base.callback(&instance->base, instance->base.context);
                     }
 
-                    instance->decode_data_low = 0;
-                    instance->decode_data_high = 0;
-                    instance->decode_count_bit = 0;
+                    bit_accumulator_reset(&instance->bits);
                     new_state = PSADecoderState0;
                     instance->state = new_state;
                     return;
@@ -1349,7 +1351,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
             }
         }
 
-        uint8_t manchester_input = 0;
+        LineCodingPulse pulse = LineCodingPulseInvalid;
         bool should_process = false;
 
         if(duration < te_short) {
@@ -1357,26 +1359,22 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
             if(tolerance >= PSA_TOLERANCE_100) {
                 return;
             }
-            manchester_input = ((level ^ 1) & 0x7f) << 1;
+            pulse = LineCodingPulseShort;
             should_process = true;
         } else {
             tolerance = duration - te_short;
             if(tolerance < PSA_TOLERANCE_100) {
-                manchester_input = ((level ^ 1) & 0x7f) << 1;
+                pulse = LineCodingPulseShort;
                 should_process = true;
             } else if(duration < te_long) {
                 uint32_t diff_from_250 = duration - te_short;
                 uint32_t diff_from_500 = te_long - duration;
 
                 if(diff_from_500 < 150 || diff_from_250 > diff_from_500) {
-                    if(level == 0) {
-                        manchester_input = 6;
-                    } else {
-                        manchester_input = 4;
-                    }
+                    pulse = LineCodingPulseLong;
                     should_process = true;
                 } else if(diff_from_250 < 150) {
-                    manchester_input = ((level ^ 1) & 0x7f) << 1;
+                    pulse = LineCodingPulseShort;
                     should_process = true;
                 } else {
                     if(duration > 10000) {
@@ -1385,11 +1383,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                         return;
                     }
                     if(duration >= 350 && duration <= 400) {
-                        if(level == 0) {
-                            manchester_input = 6;
-                        } else {
-                            manchester_input = 4;
-                        }
+                        pulse = LineCodingPulseLong;
                         should_process = true;
                     } else {
                         return;
@@ -1398,11 +1392,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
             } else {
                 uint32_t long_diff = duration - te_long;
                 if(long_diff < 100) {
-                    if(level == 0) {
-                        manchester_input = 6;
-                    } else {
-                        manchester_input = 4;
-                    }
+                    pulse = LineCodingPulseLong;
                     should_process = true;
                 } else {
                     if(!level) {
@@ -1418,26 +1408,12 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
             }
         }
 
-        if(should_process && instance->decode_count_bit < PSA_KEY2_BITS) {
-            bool decoded_bit = false;
-
-            if(manchester_advance(
-                   instance->manchester_state,
-                   (ManchesterEvent)manchester_input,
-                   &instance->manchester_state,
-                   &decoded_bit)) {
-                uint32_t carry = (instance->decode_data_low >> 31) & 1;
-                instance->decode_data_low = (instance->decode_data_low << 1) |
-                                            (decoded_bit ? 1 : 0);
-                instance->decode_data_high = (instance->decode_data_high << 1) | carry;
-                instance->decode_count_bit++;
-
-                if(instance->decode_count_bit == PSA_KEY1_BITS) {
-                    instance->key1_low = instance->decode_data_low;
-                    instance->key1_high = instance->decode_data_high;
-                    instance->decode_data_low = 0;
-                    instance->decode_data_high = 0;
-                }
+        if(should_process && bit_accumulator_count(&instance->bits) < PSA_KEY2_BITS) {
+            LineCodingBit bit = line_coding_manchester_step(
+                &instance->manchester_state, pulse, LineCodingPolarityNormal, level);
+
+            if(line_coding_is_bit(bit)) {
+                bit_accumulator_push(&instance->bits, bit);
             }
         }
 
@@ -1453,14 +1429,11 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                 end_diff = duration - PSA_TE_END_1000;
             }
             if(end_diff <= 199) {
-                if(instance->decode_count_bit != PSA_KEY2_BITS) {
+                if(bit_accumulator_count(&instance->bits) != PSA_KEY2_BITS) {
                     return;
                 }
 
-                if(((instance->key1_high >> 16) & 0xF) == 0xA) {
-                    uint32_t new_key2_low = instance->decode_data_low;
-                    instance->validation_field = (uint16_t)(instance->decode_data_low & 0xFFFF);
-
+                if(psa_frame_type_valid(instance)) {
                     instance->decrypted_type = 0;
                     instance->decrypted_button = 0;
                     instance->decrypted_serial = 0;
@@ -1469,8 +1442,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                     instance->decrypted_seed = 0;
                     instance->decrypted = 0x00;
 
-                    instance->key2_low = new_key2_low;
-                    instance->key2_high = instance->decode_data_high;
+                    psa_latch_keys(instance);
                     instance->status_flag = 0x80;
 
                     FURI_LOG_I(
@@ -1505,9 +1477,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                         instance->base.callback(&instance->base, instance->base.context);
                     }
 
-                    instance->decode_data_low = 0;
-                    instance->decode_data_high = 0;
-                    instance->decode_count_bit = 0;
+                    bit_accumulator_reset(&instance->bits);
                     new_state = PSADecoderState0;
                 } else {
                     return;
@@ -1527,14 +1497,8 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                         "[State3->State4] Transition detected with pattern_cnt=%lu",
                         (unsigned long)instance->pattern_counter);
                     new_state = PSADecoderState4;
-                    instance->decode_data_low = 0;
-                    instance->decode_data_high = 0;
-                    instance->decode_count_bit = 0;
-                    manchester_advance(
-                        instance->manchester_state,
-                        ManchesterEventReset,
-                        &instance->manchester_state,
-                        NULL);
+                    bit_accumulator_reset(&instance->bits);
+                    line_coding_manchester_reset(&instance->manchester_state);
                     instance->state = new_state;
                     instance->pattern_counter = 0;
                     instance->prev_duration = duration;
@@ -1568,53 +1532,36 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
         break;
 
     case PSADecoderState4:
-        if(instance->decode_count_bit >= PSA_MAX_BITS) {
+        if(bit_accumulator_count(&instance->bits) >= PSA_MAX_BITS) {
             new_state = PSADecoderState0;
             break;
         }
 
         if(!level) {
-            uint8_t manchester_input;
-            bool decoded_bit = false;
+            LineCodingPulse pulse;
 
             if(duration < PSA_TE_SHORT_125) {
                 tolerance = PSA_TE_SHORT_125 - duration;
                 if(tolerance > PSA_TOLERANCE_49) {
                     return;
                 }
-                manchester_input = ((level ^ 1) & 0x7f) << 1;
+                pulse = LineCodingPulseShort;
             } else {
                 tolerance = duration - PSA_TE_SHORT_125;
                 if(tolerance < PSA_TOLERANCE_50) {
-                    manchester_input = ((level ^ 1) & 0x7f) << 1;
+                    pulse = LineCodingPulseShort;
                 } else if(duration >= PSA_TE_LONG_250 && duration < 0x12c) {
-                    if(level == 0) {
-                        manchester_input = 6;
-                    } else {
-                        manchester_input = 4;
-                    }
+                    pulse = LineCodingPulseLong;
                 } else {
                     return;
                 }
             }
 
-            if(manchester_advance(
-                   instance->manchester_state,
-                   (ManchesterEvent)manchester_input,
-                   &instance->manchester_state,
-                   &decoded_bit)) {
-                uint32_t carry = (instance->decode_data_low >> 31) & 1;
-                instance->decode_data_low = (instance->decode_data_low << 1) |
-                                            (decoded_bit ? 1 : 0);
-                instance->decode_data_high = (instance->decode_data_high << 1) | carry;
-                instance->decode_count_bit++;
-
-                if(instance->decode_count_bit == PSA_KEY1_BITS) {
-                    instance->key1_low = instance->decode_data_low;
-                    instance->key1_high = instance->decode_data_high;
-                    instance->decode_data_low = 0;
-                    instance->decode_data_high = 0;
-                }
+            LineCodingBit bit = line_coding_manchester_step(
+                &instance->manchester_state, pulse, LineCodingPolarityNormal, level);
+
+            if(line_coding_is_bit(bit)) {
+                bit_accumulator_push(&instance->bits, bit);
             }
         } else if(level) {
             uint32_t end_diff;
@@ -1624,22 +1571,17 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                 end_diff = duration - PSA_TE_END_500;
             }
             if(end_diff <= 99) {
-                if(instance->decode_count_bit != PSA_KEY2_BITS) {
+                if(bit_accumulator_count(&instance->bits) != PSA_KEY2_BITS) {
                     return;
                 }
 
-                if(((instance->key1_high >> 16) & 0xF) != 0xA) {
-                    instance->decode_data_low = 0;
-                    instance->decode_data_high = 0;
-                    instance->decode_count_bit = 0;
+                if(!psa_frame_type_valid(instance)) {
+                    bit_accumulator_reset(&instance->bits);
                     new_state = PSADecoderState0;
                     instance->state = new_state;
                     return;
                 }
 
-                uint32_t new_key2_low = instance->decode_data_low;
-                instance->validation_field = (uint16_t)(instance->decode_data_low & 0xFFFF);
-
                 instance->decrypted_type = 0;
                 instance->decrypted_button = 0;
                 instance->decrypted_serial = 0;
@@ -1648,8 +1590,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                 instance->decrypted_seed = 0;
                 instance->decrypted = 0x00;
 
-                instance->key2_low = new_key2_low;
-                instance->key2_high = instance->decode_data_high;
+                psa_latch_keys(instance);
                 instance->mode_serialize = 2;
                 instance->status_flag = 0x80;
 
@@ -1685,9 +1626,7 @@ void subghz_protocol_decoder_psa_feed(void* context, bool level, uint32_t durati
                     instance->base.callback(&instance->base, instance->base.context);
                 }
 
-                instance->decode_data_low = 0;
-                instance->decode_data_high = 0;
-                instance->decode_count_bit = 0;
+                bit_accumulator_reset(&instance->bits);
                 new_state = PSADecoderState0;
                 instance->state = new_state;
                 return;
@@ -1832,6 +1771,7 @@ SubGhzProtocolStatus
         instance->status_flag = 0x80;
 
         psa_decrypt_router(instance);
+        instance->decrypt_tried = true;
 
         ret = SubGhzProtocolStatusOk;
     } while(false);
@@ -1840,21 +1780,27 @@ SubGhzProtocolStatus
     return ret;
 }
 
-void subghz_protocol_decoder_psa_get_string(void* context, FuriString* output) {
-    furi_check(context);
-    SubGhzProtocolDecoderPSA* instance = context;
-
+// Run the decryption router once for a freshly received frame
+static void psa_ensure_decrypted(SubGhzProtocolDecoderPSA* instance) {
     if(instance->status_flag == 0x80 && (instance->key1_low != 0 || instance->key1_high != 0) &&
-       instance->decrypted_type == 0) {
-        FURI_LOG_I(TAG, "get_string: Calling decryption router (decrypted_type=0)");
+       instance->decrypted_type == 0 && !instance->decrypt_tried) {
+        FURI_LOG_I(TAG, "Calling decryption router (decrypted_type=0)");
         psa_decrypt_router(instance);
+        instance->decrypt_tried = true;
     } else {
         FURI_LOG_D(
             TAG,
-            "get_string: Skipping router - status_flag=0x%08lX decrypted_type=0x%02X",
+            "Skipping router - status_flag=0x%08lX decrypted_type=0x%02X",
             (unsigned long)instance->status_flag,
             (unsigned int)instance->decrypted_type);
     }
+}
+
+void subghz_protocol_decoder_psa_get_string(void* context, FuriString* output) {
+    furi_check(context);
+    SubGhzProtocolDecoderPSA* instance = context;
+
+    psa_ensure_decrypted(instance);
 
     uint16_t key2_value = (uint16_t)(instance->key2_low & 0xFFFF);
 
@@ -1866,8 +1812,7 @@ void subghz_protocol_decoder_psa_get_string(void* context, FuriString* output) {
                 "Key1:%08lX%08lX\r\n"
                 "Key2:%04X\r\n"
                 "Btn:%01X\r\n"
-                "Ser:%06lX\r\n"
-                "Cnt:%04lX\r\n"
+                "Ser:%06lX Cnt:%04lX\r\n"
                 "CRC:%02X\r\n"
                 "Type:%02X\r\n"
                 "Sd:%06lX",
@@ -1889,8 +1834,7 @@ void subghz_protocol_decoder_psa_get_string(void* context, FuriString* output) {
                 "Key1:%08lX%08lX\r\n"
                 "Key2:%04X\r\n"
                 "Btn:%02X\r\n"
-                "Ser:%06lX\r\n"
-                "Cnt:%08lX\r\n"
+                "Ser:%06lX Cnt:%08lX\r\n"
                 "CRC:%02X\r\n"
                 "Type:%02X\r\n"
                 "Sd:%06lX",
@@ -1930,3 +1874,36 @@ void subghz_protocol_decoder_psa_get_string(void* context, FuriString* output) {
             key2_value);
     }
 }
+
+void subghz_protocol_decoder_psa_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderPSA* instance = context;
+
+    psa_ensure_decrypted(instance);
+
+    // Key1 and the 16 bit Key2 are all that is on air; files still say 128,
+    // so whether the frame is whole is reported directly
+    result->bits = PSA_KEY2_BITS;
+    result->full = instance->status_flag == 0x80;
+    if(instance->decrypted == 0x50 && instance->decrypted_type != 0) {
+        result->serial = instance->decrypted_serial;
+        result->btn = instance->decrypted_button;
+        result->cnt = instance->decrypted_counter;
+        // Decryption is only accepted once the embedded checksum matches
+        result->crc_valid = true;
+        result->decrypted = true;
+    }
+
+    const uint32_t words[] = {instance->key1_high, instance->key1_low, instance->key2_low << 16};
+    uint8_t key[PSA_KEY2_BITS / 8];
+    for(uint8_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(words[i / 4] >> (24 - (i % 4) * 8));
+    }
+    protopirate_decode_result_set_key_bytes(result, key, sizeof(key));
+}
+
+bool subghz_protocol_decoder_psa_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderPSA* instance = context;
+    return instance->state != PSADecoderState0;
+}
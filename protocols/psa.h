@@ -10,6 +10,8 @@
 #include <lib/toolbox/manchester_decoder.h>
 #include <flipper_format/flipper_format.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define PSA_PROTOCOL_NAME "PSA"
@@ -17,6 +19,7 @@
 typedef struct SubGhzProtocolDecoderPSA SubGhzProtocolDecoderPSA;
 typedef struct SubGhzProtocolEncoderPSA SubGhzProtocolEncoderPSA;
 
+extern const SubGhzBlockConst subghz_protocol_psa_const;
 extern const SubGhzProtocol subghz_protocol_psa;
 
 // Decoder functions
@@ -32,6 +35,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_psa_serialize(
 SubGhzProtocolStatus
     subghz_protocol_decoder_psa_deserialize(void* context, FlipperFormat* flipper_format);
 void subghz_protocol_decoder_psa_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_psa_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_psa_in_frame(void* context);
 
 // Encoder functions (not implemented yet)
 void* subghz_protocol_encoder_psa_alloc(SubGhzEnvironment* environment);
@@ -1,8 +1,7 @@
 #include "scher_khan.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 
-#include "protocols_common.h"
-
 //https://phreakerclub.com/72
 //https://phreakerclub.com/forum/showthread.php?t=7&page=2
 //https://phreakerclub.com/forum/showthread.php?t=274&highlight=magicar
@@ -10,7 +9,7 @@
 
 #define TAG "SubGhzProtocolScherKhan"
 
-static const SubGhzBlockConst subghz_protocol_scher_khan_const = {
+const SubGhzBlockConst subghz_protocol_scher_khan_const = {
     .te_short = 750,
     .te_long = 1100,
     .te_delta = 160,
@@ -173,20 +172,10 @@ void subghz_protocol_decoder_scher_khan_feed(void* context, bool level, uint32_t
         break;
     case ScherKhanDecoderStepCheckDuration:
         if(!level) {
-            if((DURATION_DIFF(
-                    instance->decoder.te_last, subghz_protocol_scher_khan_const.te_short) <
-                subghz_protocol_scher_khan_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_scher_khan_const.te_short) <
-                subghz_protocol_scher_khan_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = ScherKhanDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(
-                     instance->decoder.te_last, subghz_protocol_scher_khan_const.te_long) <
-                 subghz_protocol_scher_khan_const.te_delta) &&
-                (DURATION_DIFF(duration, subghz_protocol_scher_khan_const.te_long) <
-                 subghz_protocol_scher_khan_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
+            LineCodingBit bit = line_coding_pwm_pair(
+                &subghz_protocol_scher_khan_const, instance->decoder.te_last, duration);
+            if(line_coding_is_bit(bit)) {
+                subghz_protocol_blocks_add_bit(&instance->decoder, bit);
                 instance->decoder.parser_step = ScherKhanDecoderStepSaveDuration;
             } else {
                 instance->decoder.parser_step = ScherKhanDecoderStepReset;
@@ -285,10 +274,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_scher_khan_serialize(
                 break;
             }
 
-            const char* preset_name = furi_string_get_cstr(preset->name);
-            const char* short_preset = protopirate_get_short_preset_name(preset_name);
             if(!flipper_format_insert_or_update_string_cstr(
-                   flipper_format, "Preset", short_preset)) {
+                   flipper_format, "Preset", furi_string_get_cstr(preset->name))) {
                 break;
             }
         }
@@ -360,3 +347,18 @@ void subghz_protocol_decoder_scher_khan_get_string(void* context, FuriString* ou
         instance->generic.cnt,
         instance->protocol_name);
 }
+
+void subghz_protocol_decoder_scher_khan_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderScherKhan* instance = context;
+
+    subghz_protocol_scher_khan_check_remote_controller(
+        &instance->generic, &instance->protocol_name);
+    protopirate_decode_result_from_generic(result, &instance->generic);
+}
+
+bool subghz_protocol_decoder_scher_khan_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderScherKhan* instance = context;
+    return instance->decoder.parser_step != ScherKhanDecoderStepReset;
+}
@@ -10,6 +10,8 @@
 #include <lib/toolbox/manchester_decoder.h>
 #include <flipper_format/flipper_format.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define SUBGHZ_PROTOCOL_SCHER_KHAN_NAME "Scher-Khan"
@@ -19,6 +21,7 @@ typedef struct SubGhzProtocolEncoderScherKhan SubGhzProtocolEncoderScherKhan;
 
 extern const SubGhzProtocolDecoder subghz_protocol_scher_khan_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_scher_khan_encoder;
+extern const SubGhzBlockConst subghz_protocol_scher_khan_const;
 extern const SubGhzProtocol subghz_protocol_scher_khan;
 
 /**
@@ -82,3 +85,5 @@ SubGhzProtocolStatus
  * @param output Resulting text
  */
 void subghz_protocol_decoder_scher_khan_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_scher_khan_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_scher_khan_in_frame(void* context);
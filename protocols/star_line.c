@@ -1,14 +1,13 @@
 #include "star_line.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 #include "keeloq_common.h"
 
 #include <lib/subghz/subghz_keystore.h>
 
-#include "protocols_common.h"
-
 #define TAG "SubGhzProtocolStarLine"
 
-static const SubGhzBlockConst subghz_protocol_star_line_const = {
+const SubGhzBlockConst subghz_protocol_star_line_const = {
     .te_short = 250,
     .te_long = 500,
     .te_delta = 120,
@@ -580,25 +579,12 @@ void subghz_protocol_decoder_star_line_feed(void* context, bool level, uint32_t
         break;
     case StarLineDecoderStepCheckDuration:
         if(!level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_star_line_const.te_short) <
-                subghz_protocol_star_line_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_star_line_const.te_short) <
-                subghz_protocol_star_line_const.te_delta)) {
+            LineCodingBit bit = line_coding_pwm_pair(
+                &subghz_protocol_star_line_const, instance->decoder.te_last, duration);
+            if(line_coding_is_bit(bit)) {
                 if(instance->decoder.decode_count_bit <
                    subghz_protocol_star_line_const.min_count_bit_for_found) {
-                    subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                } else {
-                    instance->decoder.decode_count_bit++;
-                }
-                instance->decoder.parser_step = StarLineDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_star_line_const.te_long) <
-                 subghz_protocol_star_line_const.te_delta) &&
-                (DURATION_DIFF(duration, subghz_protocol_star_line_const.te_long) <
-                 subghz_protocol_star_line_const.te_delta)) {
-                if(instance->decoder.decode_count_bit <
-                   subghz_protocol_star_line_const.min_count_bit_for_found) {
-                    subghz_protocol_blocks_add_bit(&instance->decoder, 1);
+                    subghz_protocol_blocks_add_bit(&instance->decoder, bit);
                 } else {
                     instance->decoder.decode_count_bit++;
                 }
@@ -800,10 +786,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_star_line_serialize(
                 break;
             }
 
-            const char* preset_name = furi_string_get_cstr(preset->name);
-            const char* short_preset = protopirate_get_short_preset_name(preset_name);
             if(!flipper_format_insert_or_update_string_cstr(
-                   flipper_format, "Preset", short_preset)) {
+                   flipper_format, "Preset", furi_string_get_cstr(preset->name))) {
                 break;
             }
         }
@@ -1008,3 +992,19 @@ void subghz_protocol_decoder_star_line_get_string(void* context, FuriString* out
         instance->generic.btn,
         instance->manufacture_name);
 }
+
+void subghz_protocol_decoder_star_line_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderStarLine* instance = context;
+
+    subghz_protocol_star_line_check_remote_controller(
+        &instance->generic, instance->keystore, &instance->manufacture_name);
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    result->decrypted = strcmp(instance->manufacture_name, "Unknown") != 0;
+}
+
+bool subghz_protocol_decoder_star_line_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderStarLine* instance = context;
+    return instance->decoder.parser_step != StarLineDecoderStepReset;
+}
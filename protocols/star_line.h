@@ -10,6 +10,8 @@
 #include <lib/toolbox/manchester_decoder.h>
 #include <flipper_format/flipper_format.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define SUBGHZ_PROTOCOL_STAR_LINE_NAME "Star Line"
@@ -19,6 +21,7 @@ typedef struct SubGhzProtocolEncoderStarLine SubGhzProtocolEncoderStarLine;
 
 extern const SubGhzProtocolDecoder subghz_protocol_star_line_decoder;
 extern const SubGhzProtocolEncoder subghz_protocol_star_line_encoder;
+extern const SubGhzBlockConst subghz_protocol_star_line_const;
 extern const SubGhzProtocol subghz_protocol_star_line;
 
 /**
@@ -117,3 +120,5 @@ SubGhzProtocolStatus
  * @param output Resulting text
  */
 void subghz_protocol_decoder_star_line_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_star_line_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_star_line_in_frame(void* context);
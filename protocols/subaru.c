@@ -1,9 +1,10 @@
 #include "subaru.h"
+#include "line_coding.h"
 #include "../protopirate_app_i.h"
 
 #define TAG "SubaruProtocol"
 
-static const SubGhzBlockConst subghz_protocol_subaru_const = {
+const SubGhzBlockConst subghz_protocol_subaru_const = {
     .te_short = 800,
     .te_long = 1600,
     .te_delta = 200,
@@ -483,14 +484,11 @@ void subghz_protocol_decoder_subaru_feed(void* context, bool level, uint32_t dur
 
     case SubaruDecoderStepSaveDuration:
         if(level) {
-            if(DURATION_DIFF(duration, te_short) < te_delta) {
-                // Short HIGH = bit 1
-                subaru_add_bit(instance, true);
-                instance->decoder.te_last = duration;
-                instance->decoder.parser_step = SubaruDecoderStepCheckDuration;
-            } else if(DURATION_DIFF(duration, te_long) < te_delta) {
-                // Long HIGH = bit 0
-                subaru_add_bit(instance, false);
+            // Short HIGH = bit 1, long HIGH = bit 0
+            LineCodingBit bit = line_coding_pwm_width(
+                &subghz_protocol_subaru_const, LineCodingPolarityInverted, duration);
+            if(line_coding_is_bit(bit)) {
+                subaru_add_bit(instance, bit);
                 instance->decoder.te_last = duration;
                 instance->decoder.parser_step = SubaruDecoderStepCheckDuration;
             } else if(duration > 3000) {
@@ -630,3 +628,20 @@ void subghz_protocol_decoder_subaru_get_string(void* context, FuriString* output
         instance->btn,
         instance->cnt);
 }
+
+void subghz_protocol_decoder_subaru_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderSubaru* instance = context;
+
+    protopirate_decode_result_from_generic(result, &instance->generic);
+    result->serial = instance->serial;
+    result->btn = instance->btn;
+    result->cnt = instance->cnt;
+    protopirate_decode_result_set_key_u64(result, instance->key, 64);
+}
+
+bool subghz_protocol_decoder_subaru_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderSubaru* instance = context;
+    return instance->decoder.parser_step != SubaruDecoderStepReset;
+}
@@ -1,4 +1,5 @@
 #include "suzuki.h"
+#include "line_coding.h"
 
 #define TAG "SuzukiProtocol"
 
@@ -6,10 +7,10 @@
 // PROTOCOL CONSTANTS
 // ============================================================================
 
-static const SubGhzBlockConst subghz_protocol_suzuki_const = {
+const SubGhzBlockConst subghz_protocol_suzuki_const = {
     .te_short = 250,
     .te_long = 500,
-    .te_delta = 99,
+    .te_delta = 100,
     .min_count_bit_for_found = 64,
 };
 
@@ -139,7 +140,7 @@ void subghz_protocol_decoder_suzuki_feed(void* context, bool level, uint32_t dur
             return;
         }
 
-        if(DURATION_DIFF(duration, subghz_protocol_suzuki_const.te_short) >
+        if(DURATION_DIFF(duration, subghz_protocol_suzuki_const.te_short) >=
            subghz_protocol_suzuki_const.te_delta) {
             return;
         }
@@ -154,14 +155,14 @@ void subghz_protocol_decoder_suzuki_feed(void* context, bool level, uint32_t dur
         if(level) {
             // HIGH pulse
             if(instance->header_count >= 300) {
-                if(DURATION_DIFF(duration, subghz_protocol_suzuki_const.te_long) <=
+                if(DURATION_DIFF(duration, subghz_protocol_suzuki_const.te_long) <
                    subghz_protocol_suzuki_const.te_delta) {
                     instance->decoder.parser_step = SuzukiDecoderStepDecodeData;
                     suzuki_add_bit(instance, 1);
                 }
             }
         } else {
-            if(DURATION_DIFF(duration, subghz_protocol_suzuki_const.te_short) <=
+            if(DURATION_DIFF(duration, subghz_protocol_suzuki_const.te_short) <
                subghz_protocol_suzuki_const.te_delta) {
                 instance->decoder.te_last = duration;
                 instance->header_count++;
@@ -174,27 +175,10 @@ void subghz_protocol_decoder_suzuki_feed(void* context, bool level, uint32_t dur
     case SuzukiDecoderStepDecodeData:
         if(level) {
             // HIGH pulse - determines bit value
-            if(duration < subghz_protocol_suzuki_const.te_long) {
-                uint32_t diff_long = 500 - duration;
-                if(diff_long > 99) {
-                    uint32_t diff_short;
-                    if(duration < 250) {
-                        diff_short = 250 - duration;
-                    } else {
-                        diff_short = duration - 250;
-                    }
-
-                    if(diff_short <= 99) {
-                        suzuki_add_bit(instance, 0);
-                    }
-                } else {
-                    suzuki_add_bit(instance, 1);
-                }
-            } else {
-                uint32_t diff_long = duration - 500;
-                if(diff_long <= 99) {
-                    suzuki_add_bit(instance, 1);
-                }
+            LineCodingBit bit = line_coding_pwm_width(
+                &subghz_protocol_suzuki_const, LineCodingPolarityNormal, duration);
+            if(line_coding_is_bit(bit)) {
+                suzuki_add_bit(instance, bit);
             }
         } else {
             // LOW pulse - check for gap (end of transmission)
@@ -300,6 +284,19 @@ void subghz_protocol_decoder_suzuki_get_string(void* context, FuriString* output
         crc);
 }
 
+void subghz_protocol_decoder_suzuki_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderSuzuki* instance = context;
+
+    protopirate_decode_result_from_generic(result, &instance->generic);
+}
+
+bool subghz_protocol_decoder_suzuki_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderSuzuki* instance = context;
+    return instance->decoder.parser_step != SuzukiDecoderStepReset;
+}
+
 // ============================================================================
 // ENCODER IMPLEMENTATION
 // ============================================================================
@@ -10,10 +10,13 @@
 #include <lib/subghz/blocks/math.h>
 #include <flipper_format/flipper_format.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define SUZUKI_PROTOCOL_NAME "Suzuki"
 
+extern const SubGhzBlockConst subghz_protocol_suzuki_const;
 extern const SubGhzProtocol subghz_protocol_suzuki;
 
 // Decoder functions
@@ -29,6 +32,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_suzuki_serialize(
 SubGhzProtocolStatus
     subghz_protocol_decoder_suzuki_deserialize(void* context, FlipperFormat* flipper_format);
 void subghz_protocol_decoder_suzuki_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_suzuki_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_suzuki_in_frame(void* context);
 
 // Encoder functions
 void* subghz_protocol_encoder_suzuki_alloc(SubGhzEnvironment* environment);
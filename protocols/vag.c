@@ -1,17 +1,33 @@
 #include "vag.h"
+#include "line_coding.h"
+#include "bit_accumulator.h"
 #include "aut64.h"
 #include <string.h>
 #include <lib/subghz/subghz_keystore.h>
 
 #define TAG "VAGProtocol"
 
-static const SubGhzBlockConst subghz_protocol_vag_const = {
+const SubGhzBlockConst subghz_protocol_vag_const = {
     .te_short = 500,
     .te_long = 1000,
     .te_delta = 80,
     .min_count_bit_for_found = 80,
 };
 
+// Data-phase slicer windows: Type 1/2 run at 300/600us, Type 3 at 500/1000us
+// with a wider +/-120us window than the preamble checks
+static const SubGhzBlockConst vag_data1_timing = {
+    .te_short = 300,
+    .te_long = 600,
+    .te_delta = 80,
+};
+
+static const SubGhzBlockConst vag_data2_timing = {
+    .te_short = 500,
+    .te_long = 1000,
+    .te_delta = 121,
+};
+
 #define VAG_KEYS_COUNT 3
 
 static int8_t protocol_vag_keys_loaded = -1;
@@ -91,13 +107,7 @@ typedef struct SubGhzProtocolDecoderVAG {
 
     uint32_t parser_step;
     uint32_t te_last;
-    uint32_t data_low;
-    uint32_t data_high;
-    uint8_t bit_count;
-    uint32_t key1_low;
-    uint32_t key1_high;
-    uint32_t key2_low;
-    uint32_t key2_high;
+    BitAccumulator bits; // Key1 (64 bits) then Key2 (16 bits)
     uint16_t data_count_bit;
     uint8_t vag_type;
     uint16_t header_count;
@@ -112,6 +122,16 @@ typedef struct SubGhzProtocolDecoderVAG {
     bool decrypted;
 } SubGhzProtocolDecoderVAG;
 
+#define VAG_KEY2_BYTE 8
+
+static inline uint64_t vag_key1(const SubGhzProtocolDecoderVAG* instance) {
+    return bit_accumulator_get_bits(&instance->bits, 0, 64);
+}
+
+static inline uint16_t vag_key2(const SubGhzProtocolDecoderVAG* instance) {
+    return bit_accumulator_get_bits(&instance->bits, 64, 16);
+}
+
 typedef enum {
     VAGDecoderStepReset = 0,
     VAGDecoderStepPreamble1 = 1,
@@ -209,8 +229,8 @@ static void vag_parse_data(SubGhzProtocolDecoderVAG* instance) {
     instance->cnt = 0;
     instance->btn = 0;
 
-    uint8_t dispatch_byte = (uint8_t)(instance->key2_low & 0xFF);
-    uint8_t key2_high = (uint8_t)((instance->key2_low >> 8) & 0xFF);
+    const uint8_t* frame = bit_accumulator_bytes(&instance->bits);
+    uint8_t dispatch_byte = frame[VAG_KEY2_BYTE + 1];
 
     FURI_LOG_I(
         TAG,
@@ -219,31 +239,12 @@ static void vag_parse_data(SubGhzProtocolDecoderVAG* instance) {
         dispatch_byte,
         (dispatch_byte >> 4) & 0xF);
 
-    uint8_t key1_bytes[8];
-    uint32_t key1_low = instance->key1_low;
-    uint32_t key1_high = instance->key1_high;
-
-    key1_bytes[0] = (uint8_t)(key1_high >> 24);
-    key1_bytes[1] = (uint8_t)(key1_high >> 16);
-    key1_bytes[2] = (uint8_t)(key1_high >> 8);
-    key1_bytes[3] = (uint8_t)(key1_high);
-    key1_bytes[4] = (uint8_t)(key1_low >> 24);
-    key1_bytes[5] = (uint8_t)(key1_low >> 16);
-    key1_bytes[6] = (uint8_t)(key1_low >> 8);
-    key1_bytes[7] = (uint8_t)(key1_low);
-
 #ifndef REMOVE_LOGS
-    uint8_t type_byte = key1_bytes[0];
+    uint8_t type_byte = frame[0];
 #endif
+    // Encrypted block is Key1 without its type byte plus the high Key2 byte
     uint8_t block[8];
-    block[0] = key1_bytes[1];
-    block[1] = key1_bytes[2];
-    block[2] = key1_bytes[3];
-    block[3] = key1_bytes[4];
-    block[4] = key1_bytes[5];
-    block[5] = key1_bytes[6];
-    block[6] = key1_bytes[7];
-    block[7] = key2_high;
+    bit_accumulator_export(&instance->bits, 1, block, 8);
 
     FURI_LOG_D(
         TAG,
@@ -523,8 +524,7 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
     SubGhzProtocolDecoderVAG* instance = context;
 
     uint32_t diff;
-    bool bit_value = false;
-    ManchesterEvent event;
+    LineCodingBit bit;
 
     switch(instance->parser_step) {
     case VAGDecoderStepReset:
@@ -552,15 +552,12 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
     init_pattern1:
         instance->parser_step = VAGDecoderStepPreamble1;
     init_common:
-        instance->data_low = 0;
-        instance->data_high = 0;
+        bit_accumulator_reset(&instance->bits);
         instance->header_count = 0;
         instance->mid_count = 0;
-        instance->bit_count = 0;
         instance->vag_type = 0;
         instance->te_last = duration;
-        manchester_advance(
-            instance->manchester_state, ManchesterEventReset, &instance->manchester_state, NULL);
+        line_coding_manchester_reset(&instance->manchester_state);
         return;
 
     case VAGDecoderStepPreamble1:
@@ -624,54 +621,30 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
         return;
 
     case VAGDecoderStepData1:
-        if(instance->bit_count < 96) {
-            if(duration < 300) {
-                if((300 - duration) <= 79) {
-                    event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-                    goto process_manchester1;
-                }
-            } else if((duration - 300) < 80) {
-                event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-                goto process_manchester1;
+        if(bit_accumulator_count(&instance->bits) < 96) {
+            bit = line_coding_manchester_feed(
+                &instance->manchester_state,
+                &vag_data1_timing,
+                LineCodingPolarityNormal,
+                level,
+                duration);
+            if(bit == LineCodingBitInvalid) {
+                goto check_gap1_data;
             }
 
-            if(duration < 600) {
-                if((600 - duration) <= 79) {
-                    event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-                    goto process_manchester1;
-                }
-            } else if((duration - 600) < 80) {
-                event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-                goto process_manchester1;
-            }
+            if(line_coding_is_bit(bit)) {
+                bit_accumulator_push(&instance->bits, bit);
 
-            goto check_gap1_data;
-
-        process_manchester1:
-            if(manchester_advance(
-                   instance->manchester_state, event, &instance->manchester_state, &bit_value)) {
-                uint32_t carry = (instance->data_low >> 31) & 1;
-                instance->data_low = (instance->data_low << 1) | (bit_value ? 1 : 0);
-                instance->data_high = (instance->data_high << 1) | carry;
-                instance->bit_count++;
-
-                if(instance->bit_count == 15) {
-                    if(instance->data_low == 0x2F3F && instance->data_high == 0) {
-                        instance->data_low = 0;
-                        instance->data_high = 0;
-                        instance->bit_count = 0;
+                // A 15-bit type prefix restarts the frame
+                if(bit_accumulator_count(&instance->bits) == 15) {
+                    uint16_t prefix = bit_accumulator_get_bits(&instance->bits, 0, 15);
+                    if(prefix == 0x2F3F) {
+                        bit_accumulator_reset(&instance->bits);
                         instance->vag_type = 1;
-                    } else if(instance->data_low == 0x2F1C && instance->data_high == 0) {
-                        instance->data_low = 0;
-                        instance->data_high = 0;
-                        instance->bit_count = 0;
+                    } else if(prefix == 0x2F1C) {
+                        bit_accumulator_reset(&instance->bits);
                         instance->vag_type = 2;
                     }
-                } else if(instance->bit_count == 64) {
-                    instance->key1_low = ~instance->data_low;
-                    instance->key1_high = ~instance->data_high;
-                    instance->data_low = 0;
-                    instance->data_high = 0;
                 }
             }
             return;
@@ -689,16 +662,15 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
         if(diff >= 4000) {
             return;
         }
-        if(instance->bit_count == 80) {
-            instance->key2_low = (~instance->data_low) & 0xFFFF;
-            instance->key2_high = 0;
+        if(bit_accumulator_count(&instance->bits) == 80) {
+            // Type 1/2 frames are transmitted inverted
+            bit_accumulator_invert(&instance->bits);
             instance->data_count_bit = 80;
             FURI_LOG_I(
                 TAG,
-                "VAG decoded: Key1:%08lX%08lX Key2:%04X Type:%d",
-                (unsigned long)instance->key1_high,
-                (unsigned long)instance->key1_low,
-                (unsigned int)(instance->key2_low & 0xFFFF),
+                "VAG decoded: Key1:%016llX Key2:%04X Type:%d",
+                (unsigned long long)vag_key1(instance),
+                (unsigned int)vag_key2(instance),
                 instance->vag_type);
 
             vag_parse_data(instance);
@@ -707,9 +679,6 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
                 instance->base.callback(&instance->base, instance->base.context);
             }
         }
-        instance->data_low = 0;
-        instance->data_high = 0;
-        instance->bit_count = 0;
         instance->parser_step = VAGDecoderStepReset;
         break;
 
@@ -819,14 +788,9 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
                     instance->parser_step = VAGDecoderStepSync2B;
 
                     if(instance->mid_count == 3) {
-                        instance->data_low = 1;
-                        instance->data_high = 0;
-                        instance->bit_count = 1;
-                        manchester_advance(
-                            instance->manchester_state,
-                            ManchesterEventReset,
-                            &instance->manchester_state,
-                            NULL);
+                        bit_accumulator_reset(&instance->bits);
+                        bit_accumulator_push(&instance->bits, 1);
+                        line_coding_manchester_reset(&instance->manchester_state);
                         instance->parser_step = VAGDecoderStepData2;
                     }
                     break;
@@ -837,48 +801,26 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
         break;
 
     case VAGDecoderStepData2:
-        if(duration >= 380 && duration <= 620) {
-            event = level ? ManchesterEventShortLow : ManchesterEventShortHigh;
-            goto process_manchester2;
-        }
-
-        if(duration >= 880 && duration <= 1120) {
-            event = level ? ManchesterEventLongLow : ManchesterEventLongHigh;
-            goto process_manchester2;
-        }
-
-        goto check_complete2;
-
-    process_manchester2:
-        if(manchester_advance(
-               instance->manchester_state, event, &instance->manchester_state, &bit_value)) {
-            uint32_t carry = (instance->data_low >> 31) & 1;
-            instance->data_low = (instance->data_low << 1) | (bit_value ? 1 : 0);
-            instance->data_high = (instance->data_high << 1) | carry;
-            instance->bit_count++;
-
-            if(instance->bit_count == 64) {
-                instance->key1_low = instance->data_low;
-                instance->key1_high = instance->data_high;
-                instance->data_low = 0;
-                instance->data_high = 0;
-            }
+        bit = line_coding_manchester_feed(
+            &instance->manchester_state,
+            &vag_data2_timing,
+            LineCodingPolarityNormal,
+            level,
+            duration);
+        if(line_coding_is_bit(bit)) {
+            bit_accumulator_push(&instance->bits, bit);
         }
 
-    check_complete2:
-        if(instance->bit_count != 80) {
+        if(bit_accumulator_count(&instance->bits) != 80) {
             break;
         }
-        instance->key2_low = instance->data_low & 0xFFFF;
-        instance->key2_high = 0;
         instance->data_count_bit = 80;
         instance->vag_type = 3;
         FURI_LOG_I(
             TAG,
-            "VAG decoded: Key1:%08lX%08lX Key2:%04X Type:%d",
-            (unsigned long)instance->key1_high,
-            (unsigned long)instance->key1_low,
-            (unsigned int)(instance->key2_low & 0xFFFF),
+            "VAG decoded: Key1:%016llX Key2:%04X Type:%d",
+            (unsigned long long)vag_key1(instance),
+            (unsigned int)vag_key2(instance),
             instance->vag_type);
 
         vag_parse_data(instance);
@@ -886,9 +828,6 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
         if(instance->base.callback) {
             instance->base.callback(&instance->base, instance->base.context);
         }
-        instance->data_low = 0;
-        instance->data_high = 0;
-        instance->bit_count = 0;
         instance->parser_step = VAGDecoderStepReset;
         break;
 
@@ -901,16 +840,7 @@ void subghz_protocol_decoder_vag_feed(void* context, bool level, uint32_t durati
 uint8_t subghz_protocol_decoder_vag_get_hash_data(void* context) {
     furi_check(context);
     SubGhzProtocolDecoderVAG* instance = context;
-    uint8_t hash = 0;
-    hash ^= (instance->key1_low & 0xFF);
-    hash ^= ((instance->key1_low >> 8) & 0xFF);
-    hash ^= ((instance->key1_low >> 16) & 0xFF);
-    hash ^= ((instance->key1_low >> 24) & 0xFF);
-    hash ^= (instance->key1_high & 0xFF);
-    hash ^= ((instance->key1_high >> 8) & 0xFF);
-    hash ^= ((instance->key1_high >> 16) & 0xFF);
-    hash ^= ((instance->key1_high >> 24) & 0xFF);
-    return hash;
+    return bit_accumulator_hash(&instance->bits, VAG_KEY2_BYTE);
 }
 
 SubGhzProtocolStatus subghz_protocol_decoder_vag_serialize(
@@ -944,16 +874,13 @@ SubGhzProtocolStatus subghz_protocol_decoder_vag_serialize(
         instance->btn,
         instance->vag_type);
 
-    uint64_t key1 = ((uint64_t)instance->key1_high << 32) | instance->key1_low;
-    uint16_t key2_16bit = (uint16_t)(instance->key2_low & 0xFFFF);
+    uint64_t key1 = vag_key1(instance);
 
     FURI_LOG_I(
         TAG,
-        "Keys: Key1=%08lX%08lX Key2=%08lX%08lX",
-        (unsigned long)instance->key1_high,
-        (unsigned long)instance->key1_low,
-        (unsigned long)instance->key2_high,
-        (unsigned long)instance->key2_low);
+        "Keys: Key1=%016llX Key2=%04X",
+        (unsigned long long)key1,
+        (unsigned int)vag_key2(instance));
 
     instance->generic.data = key1;
     instance->generic.data_count_bit = instance->data_count_bit;
@@ -974,8 +901,7 @@ SubGhzProtocolStatus subghz_protocol_decoder_vag_serialize(
 
     if(ret == SubGhzProtocolStatusOk) {
         uint8_t key2_bytes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-        key2_bytes[6] = (uint8_t)((key2_16bit >> 8) & 0xFF);
-        key2_bytes[7] = (uint8_t)(key2_16bit & 0xFF);
+        bit_accumulator_export(&instance->bits, VAG_KEY2_BYTE, &key2_bytes[6], 2);
         flipper_format_write_hex(flipper_format, "Key2", key2_bytes, 8);
         FURI_LOG_I(TAG, "Wrote Key2");
 
@@ -1013,16 +939,11 @@ SubGhzProtocolStatus
         &instance->generic, flipper_format, subghz_protocol_vag_const.min_count_bit_for_found);
 
     if(ret == SubGhzProtocolStatusOk) {
-        uint64_t key1 = instance->generic.data;
-        instance->key1_low = (uint32_t)key1;
-        instance->key1_high = (uint32_t)(key1 >> 32);
-
+        uint16_t key2_16bit = 0;
         uint8_t key2_bytes[8] = {0, 0, 0, 0, 0, 0, 0, 0};
         flipper_format_rewind(flipper_format);
         if(flipper_format_read_hex(flipper_format, "Key2", key2_bytes, 8)) {
-            uint16_t key2_16bit = ((uint16_t)key2_bytes[6] << 8) | (uint16_t)key2_bytes[7];
-            instance->key2_low = (uint32_t)key2_16bit & 0xFFFF;
-            instance->key2_high = 0;
+            key2_16bit = ((uint16_t)key2_bytes[6] << 8) | (uint16_t)key2_bytes[7];
             FURI_LOG_D(
                 TAG,
                 "Read Key2 from file: bytes[6]=0x%02X bytes[7]=0x%02X normalized=0x%04X",
@@ -1031,6 +952,10 @@ SubGhzProtocolStatus
                 (unsigned int)key2_16bit);
         }
 
+        bit_accumulator_reset(&instance->bits);
+        bit_accumulator_push_bits(&instance->bits, instance->generic.data, 64);
+        bit_accumulator_push_bits(&instance->bits, key2_16bit, 16);
+
         uint32_t type = 0;
         flipper_format_rewind(flipper_format);
         if(flipper_format_read_uint32(flipper_format, "Type", &type, 1)) {
@@ -1646,10 +1571,10 @@ void subghz_protocol_decoder_vag_get_string(void* context, FuriString* output) {
         vag_parse_data(instance);
     }
 
-    uint64_t key1 = ((uint64_t)instance->key1_high << 32) | instance->key1_low;
-    uint16_t key2 = (uint16_t)(instance->key2_low & 0xFFFF);
+    uint64_t key1 = vag_key1(instance);
+    uint16_t key2 = vag_key2(instance);
 
-    uint8_t type_byte = (uint8_t)(instance->key1_high >> 24);
+    uint8_t type_byte = bit_accumulator_bytes(&instance->bits)[0];
     const char* vehicle_name;
     switch(type_byte) {
     case 0x00:
@@ -1702,6 +1627,33 @@ void subghz_protocol_decoder_vag_get_string(void* context, FuriString* output) {
     }
 }
 
+void subghz_protocol_decoder_vag_get_result(void* context, ProtoPirateDecodeResult* result) {
+    furi_check(context);
+    SubGhzProtocolDecoderVAG* instance = context;
+
+    if(!instance->decrypted && instance->data_count_bit >= 80) {
+        vag_parse_data(instance);
+    }
+
+    result->bits = instance->data_count_bit;
+    result->serial = instance->serial;
+    result->btn = instance->btn;
+    result->cnt = instance->cnt;
+    // The check byte has to match the dispatch byte for a block to count as decrypted
+    result->crc_valid = instance->decrypted;
+    result->decrypted = instance->decrypted;
+    protopirate_decode_result_set_key_bytes(
+        result,
+        bit_accumulator_bytes(&instance->bits),
+        bit_accumulator_byte_count(&instance->bits));
+}
+
+bool subghz_protocol_decoder_vag_in_frame(void* context) {
+    furi_check(context);
+    SubGhzProtocolDecoderVAG* instance = context;
+    return instance->parser_step != VAGDecoderStepReset;
+}
+
 #define VAG_ENCODER_UPLOAD_MAX_SIZE 680
 
 #ifdef ENABLE_EMULATE_FEATURE
@@ -1880,10 +1832,9 @@ SubGhzProtocolStatus
 
             SubGhzProtocolDecoderVAG decoder;
             memset(&decoder, 0, sizeof(decoder));
-            decoder.key1_low = instance->key1_low;
-            decoder.key1_high = instance->key1_high;
-            decoder.key2_low = instance->key2_low;
-            decoder.key2_high = instance->key2_high;
+            uint64_t key1 = ((uint64_t)instance->key1_high << 32) | instance->key1_low;
+            bit_accumulator_push_bits(&decoder.bits, key1, 64);
+            bit_accumulator_push_bits(&decoder.bits, instance->key2_low & 0xFFFF, 16);
             decoder.vag_type = instance->vag_type;
             decoder.data_count_bit = 80;
             decoder.key_idx = 0xFF;
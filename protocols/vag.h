@@ -11,10 +11,13 @@
 #include <lib/toolbox/manchester_decoder.h>
 #include <flipper_format/flipper_format.h>
 
+#include "decode_result.h"
+
 #include "../defines.h"
 
 #define VAG_PROTOCOL_NAME "VAG"
 
+extern const SubGhzBlockConst subghz_protocol_vag_const;
 extern const SubGhzProtocol subghz_protocol_vag;
 
 // Decoder functions
@@ -30,6 +33,8 @@ SubGhzProtocolStatus subghz_protocol_decoder_vag_serialize(
 SubGhzProtocolStatus
     subghz_protocol_decoder_vag_deserialize(void* context, FlipperFormat* flipper_format);
 void subghz_protocol_decoder_vag_get_string(void* context, FuriString* output);
+void subghz_protocol_decoder_vag_get_result(void* context, ProtoPirateDecodeResult* result);
+bool subghz_protocol_decoder_vag_in_frame(void* context);
 
 // Encoder functions
 void* subghz_protocol_encoder_vag_alloc(SubGhzEnvironment* environment);
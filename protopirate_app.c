@@ -9,8 +9,7 @@
 #include "protocols/keys.h"
 #include <string.h>
 
-#define TAG           "ProtoPirateApp"
-#define LOG_HEAP(msg) FURI_LOG_I(TAG, "%s - Free heap: %zu", msg, memmgr_get_free_heap())
+#define TAG "ProtoPirateApp"
 
 static bool protopirate_app_custom_event_callback(void* context, uint32_t event) {
     furi_check(context);
@@ -24,26 +23,104 @@ static bool protopirate_app_back_event_callback(void* context) {
     return scene_manager_handle_back_event(app->scene_manager);
 }
 
+// Runs on the GUI thread after every commit until the tick callback drops it
+static void protopirate_app_frame_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context) {
+    UNUSED(data);
+    UNUSED(size);
+    UNUSED(orientation);
+    ProtoPirateApp* app = context;
+    if(!app->startup.first_frame) app->startup.first_frame = furi_get_tick();
+}
+
 static void protopirate_app_tick_event_callback(void* context) {
     furi_check(context);
     ProtoPirateApp* app = context;
     scene_manager_handle_tick_event(app->scene_manager);
+    protopirate_heap_sample();
+
+    // Can't unhook from inside the callback, the GUI holds its lock there
+    if(app->first_frame_hooked && app->startup.first_frame) {
+        gui_remove_framebuffer_callback(app->gui, protopirate_app_frame_callback, app);
+        app->first_frame_hooked = false;
+        FURI_LOG_I(
+            TAG, "First frame after %lums", app->startup.first_frame - app->startup.app_start);
+    }
+}
+
+// Loader thread: nothing reads the preset or the keys until the matching
+// wait returns, so they can be filled in from here
+static void protopirate_app_assets_callback(AssetLoaderAsset asset, void* context) {
+    ProtoPirateApp* app = context;
+
+    if(asset == AssetLoaderKeystore) {
+        protopirate_keys_load(app->txrx->environment);
+        FURI_LOG_I(TAG, "Loaded ProtoPirate secure keys");
+        app->startup.keystore_ready = furi_get_tick();
+        return;
+    }
+
+    preset_registry_build(&app->presets, app->setting);
+
+    // Apply saved frequency and preset, with validation
+    ProtoPirateSettings* settings = &app->settings;
+    uint32_t frequency = settings->frequency;
+    uint8_t preset_index = settings->preset_index;
+
+    // Validate frequency
+    bool frequency_valid = false;
+    for(size_t i = 0; i < subghz_setting_get_frequency_count(app->setting); i++) {
+        if(subghz_setting_get_frequency(app->setting, i) == frequency) {
+            frequency_valid = true;
+            break;
+        }
+    }
+    if(!frequency_valid) {
+        frequency = subghz_setting_get_default_frequency(app->setting);
+        FURI_LOG_W(TAG, "Saved frequency invalid, using default: %lu", frequency);
+    }
+
+    // Validate preset index
+    if(preset_index >= subghz_setting_get_preset_count(app->setting)) {
+        preset_index = 0;
+        FURI_LOG_W(TAG, "Saved preset index invalid, using default");
+    }
+
+    // Get preset name and data
+    const char* preset_name = subghz_setting_get_preset_name(app->setting, preset_index);
+    uint8_t* preset_data = subghz_setting_get_preset_data(app->setting, preset_index);
+    size_t preset_data_size = subghz_setting_get_preset_data_size(app->setting, preset_index);
+
+    FURI_LOG_I(
+        TAG,
+        "Settings: freq=%lu, preset=%s, auto_save=%d, hopping=%d",
+        frequency,
+        preset_name,
+        ((settings->option_flags & FLAG_AUTO_SAVE) == FLAG_AUTO_SAVE),
+        settings->hopping_enabled);
+
+    protopirate_preset_init(app, preset_name, frequency, preset_data, preset_data_size);
+    app->startup.setting_ready = furi_get_tick();
 }
 
 ProtoPirateApp* protopirate_app_alloc() {
-    LOG_HEAP("Pre alloc");
+    uint32_t app_start = furi_get_tick();
     ProtoPirateApp* app = malloc(sizeof(ProtoPirateApp));
     if(!app) {
         FURI_LOG_E(TAG, "Failed to allocate ProtoPirateApp app !");
         return NULL;
     }
+    memset(app, 0, sizeof(ProtoPirateApp));
+    app->startup.app_start = app_start;
 
-    LOG_HEAP("Start alloc");
     FURI_LOG_I(TAG, "Allocating ProtoPirate Decoder App");
 
     // GUI
     app->gui = furi_record_open(RECORD_GUI);
-    LOG_HEAP("After GUI");
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapViews);
 
     // View Dispatcher
     app->view_dispatcher = view_dispatcher_alloc();
@@ -61,7 +138,8 @@ ProtoPirateApp* protopirate_app_alloc() {
         app->view_dispatcher, protopirate_app_tick_event_callback, 100);
 
     view_dispatcher_attach_to_gui(app->view_dispatcher, app->gui, ViewDispatcherTypeFullscreen);
-    LOG_HEAP("After ViewDispatcher");
+    gui_add_framebuffer_callback(app->gui, protopirate_app_frame_callback, app);
+    app->first_frame_hooked = true;
 
     // Open Notification record
     app->notifications = furi_record_open(RECORD_NOTIFICATION);
@@ -94,19 +172,28 @@ ProtoPirateApp* protopirate_app_alloc() {
     furi_string_set(app->file_path, "/ext/apps_data/proto_pirate/");
 #endif
 
+    // Receive path scratch strings
+    app->rx_file_name = furi_string_alloc();
+    app->rx_saved_path = furi_string_alloc();
+    app->statusbar_frequency = furi_string_alloc();
+    app->statusbar_modulation = furi_string_alloc();
+    app->statusbar_history = furi_string_alloc();
+
     // About View
     app->view_about = view_alloc();
     view_dispatcher_add_view(app->view_dispatcher, ProtoPirateViewAbout, app->view_about);
 
-    LOG_HEAP("After basic views");
 
-    // Load saved settings
-    ProtoPirateSettings settings;
-    protopirate_settings_load(&settings);
+    // Load saved settings, frequency and preset are applied once setting_user
+    // is in, see protopirate_app_assets_callback
+    ProtoPirateSettings* settings = &app->settings;
+    protopirate_settings_load(settings);
 
     // Apply auto-save setting
-    app->option_flags = settings.option_flags;
-    app->tx_power = settings.tx_power;
+    app->option_flags = settings->option_flags;
+    app->tx_power = settings->tx_power;
+    app->hopper_dwell_ms = settings->hopper_dwell_ms;
+    memcpy(app->glitch_filter, settings->glitch_filter, sizeof(app->glitch_filter));
 
     // Receiver Views
     app->protopirate_receiver =
@@ -121,39 +208,13 @@ ProtoPirateApp* protopirate_app_alloc() {
         app->view_dispatcher,
         ProtoPirateViewReceiverInfo,
         protopirate_view_receiver_info_get_view(app->protopirate_receiver_info));
+    protopirate_heap_settle(ProtoPirateHeapViews, heap_mark);
 
-    LOG_HEAP("After receiver views");
 
-    // Init setting - KEEP THIS, it's small
+    // Init setting - KEEP THIS, it's small. Filled in by the asset loader.
     app->setting = subghz_setting_alloc();
     app->loaded_file_path = NULL;
     app->start_tx_time = 0;
-    subghz_setting_load(app->setting, EXT_PATH("subghz/assets/setting_user"));
-
-    LOG_HEAP("After subghz_setting");
-
-    // Apply loaded frequency and preset, with validation
-    uint32_t frequency = settings.frequency;
-    uint8_t preset_index = settings.preset_index;
-
-    // Validate frequency
-    bool frequency_valid = false;
-    for(size_t i = 0; i < subghz_setting_get_frequency_count(app->setting); i++) {
-        if(subghz_setting_get_frequency(app->setting, i) == frequency) {
-            frequency_valid = true;
-            break;
-        }
-    }
-    if(!frequency_valid) {
-        frequency = subghz_setting_get_default_frequency(app->setting);
-        FURI_LOG_W(TAG, "Saved frequency invalid, using default: %lu", frequency);
-    }
-
-    // Validate preset index
-    if(preset_index >= subghz_setting_get_preset_count(app->setting)) {
-        preset_index = 0;
-        FURI_LOG_W(TAG, "Saved preset index invalid, using default");
-    }
 
     // Initialize TxRx structure with minimal setup
     app->lock = ProtoPirateLockOff;
@@ -165,29 +226,13 @@ ProtoPirateApp* protopirate_app_alloc() {
     app->txrx->txrx_state = ProtoPirateTxRxStateIDLE;
     app->txrx->rx_key_state = ProtoPirateRxKeyStateIDLE;
 
-    // Get preset name and data
-    const char* preset_name = subghz_setting_get_preset_name(app->setting, preset_index);
-    uint8_t* preset_data = subghz_setting_get_preset_data(app->setting, preset_index);
-    size_t preset_data_size = subghz_setting_get_preset_data_size(app->setting, preset_index);
-
-    FURI_LOG_I(
-        TAG,
-        "Settings: freq=%lu, preset=%s, auto_save=%d, hopping=%d",
-        frequency,
-        preset_name,
-        ((settings.option_flags & FLAG_AUTO_SAVE) == FLAG_AUTO_SAVE),
-        settings.hopping_enabled);
-
-    protopirate_preset_init(app, preset_name, frequency, preset_data, preset_data_size);
-
     // Apply hopping state from settings
-    app->txrx->hopper_state = settings.hopping_enabled ? ProtoPirateHopperStateRunning :
-                                                         ProtoPirateHopperStateOFF;
-    app->txrx->hopper_idx_frequency = 0;
-    app->txrx->hopper_timeout = 0;
+    app->txrx->hopper_state = settings->hopping_enabled ? ProtoPirateHopperStateRunning :
+                                                          ProtoPirateHopperStateOFF;
+    hopper_scheduler_init(&app->txrx->hopper, &hopper_scheduler_default_config, 0, 0);
+    protopirate_rx_metrics_reset(&app->txrx->metrics);
     app->txrx->idx_menu_chosen = 0;
 
-    LOG_HEAP("After txrx basic setup");
 
     // Mark as not initialized
     app->radio_initialized = false;
@@ -201,7 +246,14 @@ ProtoPirateApp* protopirate_app_alloc() {
 
     FURI_LOG_D(TAG, "Initial state: radio_initialized=%d", app->radio_initialized);
 
-    LOG_HEAP("App alloc complete (radio deferred)");
+    // Disk reads last, off this thread, so the start menu can come up first
+    app->assets = asset_loader_alloc(
+        app->setting,
+        PROTOPIRATE_SETTING_USER_PATH,
+        app->txrx->environment,
+        PROTOPIRATE_KEYSTORE_DIR_NAME,
+        protopirate_app_assets_callback,
+        app);
 
     return app;
 }
@@ -218,7 +270,7 @@ bool protopirate_radio_init(ProtoPirateApp* app) {
 
     // Fresh radio init - nothing was initialized before
     FURI_LOG_I(TAG, "Fresh radio init - allocating all components");
-    LOG_HEAP("Radio init start");
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapDecoders);
 
     // Create environment with our custom protocols
     app->txrx->environment = subghz_environment_alloc();
@@ -226,20 +278,13 @@ bool protopirate_radio_init(ProtoPirateApp* app) {
         FURI_LOG_E(TAG, "Failed to allocate environment!");
         return false;
     }
-    LOG_HEAP("After environment alloc");
 
     FURI_LOG_I(TAG, "Registering %zu ProtoPirate protocols", protopirate_protocol_registry.size);
     subghz_environment_set_protocol_registry(
         app->txrx->environment, (void*)&protopirate_protocol_registry);
 
-    // Load keystores
-    subghz_environment_load_keystore(app->txrx->environment, PROTOPIRATE_KEYSTORE_DIR_NAME);
-    LOG_HEAP("After keystore load");
-
-    // Load ProtoPirate specific keys
-    protopirate_keys_load(app->txrx->environment);
-    FURI_LOG_I(TAG, "Loaded ProtoPirate secure keys");
-    LOG_HEAP("After keys load");
+    // The keystore is left to the asset loader, decoders only read it once
+    // a scene has waited for AssetLoaderKeystore
 
     // Create receiver
     app->txrx->receiver = subghz_receiver_alloc_init(app->txrx->environment);
@@ -249,7 +294,6 @@ bool protopirate_radio_init(ProtoPirateApp* app) {
         app->txrx->environment = NULL;
         return false;
     }
-    LOG_HEAP("After receiver alloc");
 
     // Initialize SubGhz devices
     subghz_devices_init();
@@ -287,12 +331,14 @@ bool protopirate_radio_init(ProtoPirateApp* app) {
 
     // Set filter to accept decodable protocols
     subghz_receiver_set_filter(app->txrx->receiver, SubGhzProtocolFlag_Decodable);
+    protopirate_receiver_get_decoders(app->txrx->receiver, app->txrx->decoders);
+    protopirate_heap_settle(ProtoPirateHeapDecoders, heap_mark);
 
     app->radio_initialized = true;
+    if(!app->startup.radio_ready) app->startup.radio_ready = furi_get_tick();
 
     FURI_LOG_D(TAG, "Final state: radio_initialized=%d", app->radio_initialized);
 
-    LOG_HEAP("Radio init complete");
 
     return true;
 }
@@ -315,7 +361,8 @@ void protopirate_radio_deinit(ProtoPirateApp* app) {
         return;
     }
 
-    LOG_HEAP("Radio deinit start");
+
+    protopirate_radio_thread_stop(app);
 
     // Make sure we're not receiving
     if(app->txrx->worker && app->txrx->txrx_state == ProtoPirateTxRxStateRx) {
@@ -326,6 +373,8 @@ void protopirate_radio_deinit(ProtoPirateApp* app) {
         }
     }
 
+    // Everything radio_init set up, the counterpart of its Decoders charge
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapDecoders);
     if(app->txrx->radio_device) {
         FURI_LOG_D(TAG, "Putting radio device to sleep and ending: %p", app->txrx->radio_device);
         subghz_devices_sleep(app->txrx->radio_device);
@@ -353,6 +402,7 @@ void protopirate_radio_deinit(ProtoPirateApp* app) {
     } else {
         FURI_LOG_D(TAG, "Environment was NULL, skipping free");
     }
+    protopirate_heap_settle(ProtoPirateHeapDecoders, heap_mark);
 
     if(app->txrx->history) {
         FURI_LOG_D(TAG, "Freeing history %p", app->txrx->history);
@@ -370,10 +420,12 @@ void protopirate_radio_deinit(ProtoPirateApp* app) {
         FURI_LOG_D(TAG, "Worker was NULL, skipping free");
     }
 
+    free(app->txrx->burst_filter);
+    app->txrx->burst_filter = NULL;
+
     app->radio_initialized = false;
 
     FURI_LOG_D(TAG, "Final state: radio_initialized=%d", app->radio_initialized);
-    LOG_HEAP("Radio deinit complete");
 }
 
 void protopirate_app_free(ProtoPirateApp* app) {
@@ -382,23 +434,29 @@ void protopirate_app_free(ProtoPirateApp* app) {
     FURI_LOG_I(TAG, "=== protopirate_app_free called ===");
     FURI_LOG_D(TAG, "State: radio_initialized=%d", app->radio_initialized);
 
+    // The loader writes into setting, environment and the preset
+    if(app->assets) {
+        asset_loader_free(app->assets);
+        app->assets = NULL;
+    }
+    if(app->first_frame_hooked) {
+        gui_remove_framebuffer_callback(app->gui, protopirate_app_frame_callback, app);
+        app->first_frame_hooked = false;
+    }
+
     // Save settings before exiting
-    ProtoPirateSettings settings;
-    settings.frequency = app->txrx->preset->frequency;
+    ProtoPirateSettings settings = app->settings;
+    // Without setting_user the preset was never applied, keep the saved one
+    if(app->startup.setting_ready) {
+        settings.frequency = app->txrx->preset->frequency;
+        settings.preset_index = protopirate_preset_index(app);
+    }
     settings.option_flags = app->option_flags;
     settings.tx_power = app->tx_power;
+    settings.hopper_dwell_ms = app->hopper_dwell_ms;
+    memcpy(settings.glitch_filter, app->glitch_filter, sizeof(settings.glitch_filter));
     settings.hopping_enabled = (app->txrx->hopper_state != ProtoPirateHopperStateOFF);
 
-    // Find current preset index
-    settings.preset_index = 0;
-    const char* current_preset = furi_string_get_cstr(app->txrx->preset->name);
-    for(uint8_t i = 0; i < subghz_setting_get_preset_count(app->setting); i++) {
-        if(strcmp(subghz_setting_get_preset_name(app->setting, i), current_preset) == 0) {
-            settings.preset_index = i;
-            break;
-        }
-    }
-
     FURI_LOG_I(
         TAG,
         "Saving settings: freq=%lu, preset=%u, auto_save=%d, hopping=%d",
@@ -440,6 +498,14 @@ void protopirate_app_free(ProtoPirateApp* app) {
         furi_string_free(app->file_path);
     }
 
+    // Receive path scratch strings
+    FURI_LOG_D(TAG, "Freeing scratch strings");
+    furi_string_free(app->rx_file_name);
+    furi_string_free(app->rx_saved_path);
+    furi_string_free(app->statusbar_frequency);
+    furi_string_free(app->statusbar_modulation);
+    furi_string_free(app->statusbar_history);
+
     // Widget
     FURI_LOG_D(TAG, "Removing widget view");
     view_dispatcher_remove_view(app->view_dispatcher, ProtoPirateViewWidget);
@@ -469,6 +535,8 @@ void protopirate_app_free(ProtoPirateApp* app) {
     FURI_LOG_D(TAG, "Freeing view_dispatcher and scene_manager");
     view_dispatcher_free(app->view_dispatcher);
     scene_manager_free(app->scene_manager);
+    // Scenes release their arena on exit, this only catches one that didn't
+    scene_arena_release(&app->scene_arena);
 
     // Close Dialogs
     FURI_LOG_D(TAG, "Closing dialogs record");
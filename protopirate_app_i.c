@@ -1,5 +1,6 @@
 // protopirate_app_i.c
 #include "protopirate_app_i.h"
+#include "protocols/protocol_items.h"
 
 #define TAG "ProtoPirateTxRx"
 
@@ -17,27 +18,10 @@ void protopirate_preset_init(
     app->txrx->preset->data_size = preset_data_size;
 }
 
-// Convert full FuriHal preset name to short name used by settings
-const char* preset_name_to_short(const char* preset_name) {
-    if(!preset_name) return "AM650";
-
-    // Check for full FuriHal names
-    if(strstr(preset_name, "Ook650") || strstr(preset_name, "OOK650")) return "AM650";
-    if(strstr(preset_name, "Ook270") || strstr(preset_name, "OOK270")) return "AM270";
-    if(strstr(preset_name, "2FSKDev238") || strstr(preset_name, "Dev238")) return "FM238";
-    if(strstr(preset_name, "2FSKDev12K") || strstr(preset_name, "Dev12K")) return "FM12K";
-    if(strstr(preset_name, "2FSKDev476") || strstr(preset_name, "Dev476")) return "FM476";
-
-    // Check for short names already
-    if(strcmp(preset_name, "AM650") == 0) return "AM650";
-    if(strcmp(preset_name, "AM270") == 0) return "AM270";
-    if(strcmp(preset_name, "FM238") == 0) return "FM238";
-    if(strcmp(preset_name, "FM12K") == 0) return "FM12K";
-    if(strcmp(preset_name, "FM476") == 0) return "FM476";
-    if(strcmp(preset_name, "FuriHalSubGhzPresetCustom") == 0) return "Custom";
-
-    // Default fallback
-    return "AM650";
+const char* protopirate_preset_short_name(ProtoPirateApp* app, const char* preset_name) {
+    furi_check(app);
+    const char* short_name = preset_registry_short_name(&app->presets, preset_name);
+    return short_name ? short_name : "AM650";
 }
 
 void protopirate_get_frequency_modulation(
@@ -82,6 +66,9 @@ uint32_t protopirate_rx(ProtoPirateApp* app, uint32_t frequency) {
     subghz_devices_flush_rx(app->txrx->radio_device);
     subghz_devices_set_rx(app->txrx->radio_device);
 
+    // The worker merges pulses shorter than this into their neighbours
+    subghz_worker_set_filter(app->txrx->worker, protopirate_glitch_filter_us(app));
+
     subghz_devices_start_async_rx(
         app->txrx->radio_device, subghz_worker_rx_callback, app->txrx->worker);
 
@@ -90,6 +77,31 @@ uint32_t protopirate_rx(ProtoPirateApp* app, uint32_t frequency) {
     return value;
 }
 
+uint8_t protopirate_preset_index(ProtoPirateApp* app) {
+    furi_check(app);
+    // The preset always points into setting, so its data identifies it
+    uint8_t index = preset_registry_find_data(&app->presets, app->txrx->preset->data);
+    return preset_registry_is_valid(&app->presets, index) ? index : 0;
+}
+
+void protopirate_app_wait_assets(ProtoPirateApp* app, uint32_t assets) {
+    furi_check(app);
+    if(asset_loader_is_ready(app->assets, assets)) return;
+
+    // Only reached when a scene is opened right after launch
+#ifndef REMOVE_LOGS
+    uint32_t start = furi_get_tick();
+#endif
+    asset_loader_wait(app->assets, assets);
+    FURI_LOG_I(TAG, "Waited %lums for assets", furi_get_tick() - start);
+}
+
+uint16_t protopirate_glitch_filter_us(ProtoPirateApp* app) {
+    furi_check(app);
+    return protopirate_glitch_filter_get(
+        app->glitch_filter, furi_string_get_cstr(app->txrx->preset->name));
+}
+
 void protopirate_idle(ProtoPirateApp* app) {
     furi_check(app);
     furi_check(app->txrx->txrx_state != ProtoPirateTxRxStateSleep);
@@ -114,53 +126,185 @@ void protopirate_sleep(ProtoPirateApp* app) {
     app->txrx->txrx_state = ProtoPirateTxRxStateSleep;
 }
 
-void protopirate_hopper_update(ProtoPirateApp* app) {
-    furi_check(app);
+// Feed one pulse to the decoders. Returns true if it completed a decode.
+static bool protopirate_rx_feed(void* context, bool level, uint32_t duration) {
+    ProtoPirateApp* app = context;
+    ProtoPirateRxMetrics* metrics = &app->txrx->metrics;
+
+    // The RX callback runs inside subghz_receiver_decode and counts itself
+    uint32_t decodes = metrics->rx_callback.calls;
+    uint32_t start = protopirate_rx_metrics_now();
+    protopirate_rx_metrics_feed_decoders(
+        metrics->decoder_feed, app->txrx->decoders, level, duration);
+    protopirate_rx_metrics_timing_add(&metrics->feed, start);
+    metrics->last_pulse_cycles = start;
+    // Decoders finish on the gap, so it still belongs to the burst it closes
+    if(duration >= BURST_FILTER_GAP_US) app->txrx->burst_id++;
+    return metrics->rx_callback.calls != decodes;
+}
+
+// Worker pair callback (context is the app): count the pulse and pass it on
+// through the repeat filter when the scene has one
+void protopirate_rx_pair_callback(void* context, bool level, uint32_t duration) {
+    ProtoPirateApp* app = context;
+    ProtoPirateRxMetrics* metrics = &app->txrx->metrics;
 
-    switch(app->txrx->hopper_state) {
-    case ProtoPirateHopperStateOFF:
-    case ProtoPirateHopperStatePause:
+    metrics->pulses++;
+    metrics->pulse_cycles = protopirate_rx_metrics_now();
+    if(!app->startup.first_pulse) app->startup.first_pulse = furi_get_tick();
+    if(!app->txrx->burst_filter) {
+        protopirate_rx_feed(app, level, duration);
         return;
-    case ProtoPirateHopperStateRSSITimeOut:
-        if(app->txrx->hopper_timeout != 0) {
-            app->txrx->hopper_timeout--;
-            return;
-        }
-        break;
-    default:
-        break;
     }
-    float rssi = -127.0f;
-    if(app->txrx->hopper_state != ProtoPirateHopperStateRSSITimeOut) {
-        rssi = subghz_devices_get_rssi(app->txrx->radio_device);
-
-        if(rssi > -90.0f) {
-            app->txrx->hopper_timeout = 10;
-            app->txrx->hopper_state = ProtoPirateHopperStateRSSITimeOut;
-            return;
-        }
-    } else {
-        app->txrx->hopper_state = ProtoPirateHopperStateRunning;
+
+    size_t dropped = burst_filter_push(
+        app->txrx->burst_filter,
+        level,
+        duration,
+        app->txrx->preset->frequency,
+        furi_get_tick(),
+        protopirate_rx_feed,
+        app);
+    if(dropped) {
+        metrics->repeats_suppressed++;
+        metrics->pulses_suppressed += dropped;
     }
+}
+
+// Worker overrun callback (context is the app): samples were dropped, so
+// recover the decoders without throwing away the ones that were idle
+void protopirate_rx_overrun_callback(void* context) {
+    ProtoPirateApp* app = context;
+    ProtoPirateRxMetrics* metrics = &app->txrx->metrics;
+
+    // Flushed pulses decode now, so latency counts from here
+    metrics->pulse_cycles = protopirate_rx_metrics_now();
+    uint32_t gap_us = (metrics->pulse_cycles - metrics->last_pulse_cycles) /
+                      furi_hal_cortex_instructions_per_microsecond();
+    metrics->overruns++;
+    metrics->overrun_gap_total_us += gap_us;
+    if(gap_us > metrics->overrun_gap_max_us) metrics->overrun_gap_max_us = gap_us;
+
+    // Held pulses are part of whatever frame the drop cut short
+    if(app->txrx->burst_filter) {
+        burst_filter_flush(app->txrx->burst_filter, protopirate_rx_feed, app);
+    }
+    metrics->lost_frames += protopirate_receiver_recover(
+        app->txrx->receiver, app->txrx->decoders, PROTOPIRATE_RX_RESYNC_GAP_US);
+    app->txrx->burst_id++;
+}
+
+void protopirate_receiver_reset(ProtoPirateApp* app) {
+    furi_check(app);
+    app->txrx->metrics.receiver_resets++;
+    subghz_receiver_reset(app->txrx->receiver);
+}
+
+void protopirate_hopper_reset(ProtoPirateApp* app) {
+    furi_check(app);
+
+    size_t count = subghz_setting_get_hopper_frequency_count(app->setting);
+    HopperSchedulerConfig config;
+    hopper_scheduler_config_for_dwell(&config, app->hopper_dwell_ms, count);
+    hopper_scheduler_init(&app->txrx->hopper, &config, count, furi_get_tick());
+}
+
+void protopirate_hopper_update(ProtoPirateApp* app, float rssi) {
+    furi_check(app);
+
+    if(app->txrx->hopper_state == ProtoPirateHopperStateOFF) return;
 
-    if(app->txrx->hopper_idx_frequency <
-       subghz_setting_get_hopper_frequency_count(app->setting) - 1) {
-        app->txrx->hopper_idx_frequency++;
-    } else {
-        app->txrx->hopper_idx_frequency = 0;
+    // furi_get_tick() runs at 1kHz, so scheduler times are milliseconds
+    uint32_t now = furi_get_tick();
+    HopperScheduler* hopper = &app->txrx->hopper;
+
+    if(app->txrx->hopper_decode_pending) {
+        app->txrx->hopper_decode_pending = false;
+        hopper_scheduler_on_decode(hopper, now);
     }
+    hopper_scheduler_on_rssi(hopper, rssi, now);
+    if(!hopper_scheduler_tick(hopper, now)) return;
 
     if(app->txrx->txrx_state == ProtoPirateTxRxStateRx) {
         protopirate_rx_end(app);
     }
     if(app->txrx->txrx_state == ProtoPirateTxRxStateIDLE) {
-        subghz_receiver_reset(app->txrx->receiver);
-        app->txrx->preset->frequency =
-            subghz_setting_get_hopper_frequency(app->setting, app->txrx->hopper_idx_frequency);
+        protopirate_receiver_reset(app);
+        app->txrx->preset->frequency = subghz_setting_get_hopper_frequency(
+            app->setting, hopper_scheduler_current(hopper));
         protopirate_rx(app, app->txrx->preset->frequency);
     }
 }
 
+// Runs on the radio thread: sample RSSI, let the hopper retune, then tell the
+// GUI only when something it shows has changed. At most one update event is
+// queued at a time; the scene reads the latest values when it handles it.
+static void protopirate_radio_poll(ProtoPirateApp* app) {
+    ProtoPirateTxRx* txrx = app->txrx;
+
+    if(!app->radio_initialized || txrx->txrx_state != ProtoPirateTxRxStateRx) return;
+
+    float rssi = subghz_devices_get_rssi(txrx->radio_device);
+    protopirate_hopper_update(app, rssi);
+
+    // The view draws nothing below -90 dBm and whole-dB bars above it
+    int8_t shown_rssi = rssi <= -90.0f ? -90 : (rssi >= 0.0f ? 0 : (int8_t)rssi);
+    uint32_t shown_frequency = txrx->preset->frequency;
+    if(shown_rssi == txrx->shown_rssi && shown_frequency == txrx->shown_frequency) return;
+
+    txrx->shown_rssi = shown_rssi;
+    txrx->shown_frequency = shown_frequency;
+    if(!txrx->radio_update_pending) {
+        txrx->radio_update_pending = true;
+        view_dispatcher_send_custom_event(
+            app->view_dispatcher, ProtoPirateCustomEventSceneReceiverRadio);
+    }
+}
+
+// A retune joins the worker thread and restarts async RX, which must not
+// happen on the shared timer service thread, so polling gets its own thread
+static int32_t protopirate_radio_thread(void* context) {
+    ProtoPirateApp* app = context;
+
+    for(;;) {
+        uint32_t flags = furi_thread_flags_wait(
+            PROTOPIRATE_RADIO_FLAG_STOP,
+            FuriFlagWaitAny,
+            furi_ms_to_ticks(PROTOPIRATE_RADIO_POLL_MS));
+        if(!(flags & FuriFlagError) && (flags & PROTOPIRATE_RADIO_FLAG_STOP)) break;
+        protopirate_radio_poll(app);
+    }
+
+    return 0;
+}
+
+void protopirate_radio_thread_start(ProtoPirateApp* app) {
+    furi_check(app);
+    ProtoPirateTxRx* txrx = app->txrx;
+    if(txrx->radio_thread) return;
+
+    // Force the first sample through to the view
+    txrx->shown_frequency = 0;
+    txrx->radio_update_pending = false;
+    txrx->hopper_decode_pending = false;
+
+    txrx->radio_thread = furi_thread_alloc_ex(
+        "ProtoPirateRadio", PROTOPIRATE_RADIO_STACK_SIZE, protopirate_radio_thread, app);
+    furi_thread_start(txrx->radio_thread);
+}
+
+void protopirate_radio_thread_stop(ProtoPirateApp* app) {
+    furi_check(app);
+    ProtoPirateTxRx* txrx = app->txrx;
+    if(!txrx->radio_thread) return;
+
+    // Waits out a poll in progress, so the caller owns the radio after this
+    furi_thread_flags_set(furi_thread_get_id(txrx->radio_thread), PROTOPIRATE_RADIO_FLAG_STOP);
+    furi_thread_join(txrx->radio_thread);
+    furi_thread_free(txrx->radio_thread);
+    txrx->radio_thread = NULL;
+}
+
 void protopirate_tx(ProtoPirateApp* app, uint32_t frequency) {
     furi_check(app);
     if(!subghz_devices_is_frequency_valid(app->txrx->radio_device, frequency)) {
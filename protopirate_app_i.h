@@ -8,6 +8,16 @@
 #include "views/protopirate_receiver_info.h"
 #include "protopirate_history.h"
 #include "helpers/radio_device_loader.h"
+#include "helpers/hopper_scheduler.h"
+#include "helpers/burst_filter.h"
+#include "helpers/protopirate_rx_metrics.h"
+#include "helpers/protopirate_heap.h"
+#include "helpers/scene_arena.h"
+#include "helpers/asset_loader.h"
+#include "helpers/preset_registry.h"
+#include "helpers/frame_timing.h"
+#include "helpers/event_coalescer.h"
+#include "helpers/pulse_stream.h"
 
 #include <gui/gui.h>
 #include <gui/view_dispatcher.h>
@@ -26,9 +36,29 @@
 #include "defines.h"
 
 #define PROTOPIRATE_KEYSTORE_DIR_NAME APP_ASSETS_PATH("encrypted")
+#define PROTOPIRATE_SETTING_USER_PATH EXT_PATH("subghz/assets/setting_user")
+
+// Quiet gap fed to the decoders after an overrun, longer than any frame gap
+#define PROTOPIRATE_RX_RESYNC_GAP_US 50000
+
+// RSSI sampling and hop decision period
+#define PROTOPIRATE_RADIO_POLL_MS 20
+// The radio thread stops and restarts RX (worker and async RX) on every hop
+#define PROTOPIRATE_RADIO_STACK_SIZE 2048
+#define PROTOPIRATE_RADIO_FLAG_STOP  (1 << 0)
 
 typedef struct ProtoPirateApp ProtoPirateApp;
 
+// Best decode reported for the current burst, so overlapping decoders on one
+// burst produce a single history entry
+typedef struct {
+    uint32_t burst;
+    uint8_t score;
+    bool valid;
+    // The winner went into history as its newest entry
+    bool reported;
+} ProtoPirateArbitration;
+
 typedef struct {
     SubGhzWorker* worker;
     SubGhzEnvironment* environment;
@@ -39,8 +69,28 @@ typedef struct {
     ProtoPirateTxRxState txrx_state;
     ProtoPirateHopperState hopper_state;
     ProtoPirateRxKeyState rx_key_state;
-    uint8_t hopper_idx_frequency;
-    uint8_t hopper_timeout;
+    HopperScheduler hopper;
+    // Polls RSSI and drives the hopper off the GUI thread, receiver scene only
+    FuriThread* radio_thread;
+    // Last values published to the receiver view, written by radio_thread
+    volatile uint32_t shown_frequency;
+    volatile int8_t shown_rssi;
+    volatile bool radio_update_pending;
+    // Set by the receive callback, consumed by the hopper on the radio thread
+    volatile bool hopper_decode_pending;
+    ProtoPirateRxMetrics metrics;
+    // The receiver's decoders by protocol id, fed one by one so each is timed
+    SubGhzProtocolDecoderBase* decoders[ProtoPirateProtocolIdCount];
+    // Drops repeat bursts before they reach the decoders, receiver scene only
+    BurstFilter* burst_filter;
+    // Bumped after every quiet gap reaches the decoders, worker thread only
+    uint32_t burst_id;
+    ProtoPirateArbitration arbitration;
+    // History updates from the receive callback, one view refresh per frame
+    EventCoalescer history_updates;
+    // Pulses read from PULSE_STREAM_FILE while the receiver takes its input
+    // from there instead of the radio
+    PulseStream* stream;
     uint16_t idx_menu_chosen;
 } ProtoPirateTxRx;
 
@@ -59,13 +109,34 @@ struct ProtoPirateApp {
     ProtoPirateReceiverInfo* protopirate_receiver_info;
     ProtoPirateTxRx* txrx;
     SubGhzSetting* setting;
+    // Built from setting as soon as it is loaded
+    PresetRegistry presets;
     ProtoPirateLock lock;
     FuriString* loaded_file_path;
+    // Scratch strings for the receive path, reused on every capture
+    FuriString* rx_file_name;
+    FuriString* rx_saved_path;
+    FuriString* statusbar_frequency;
+    FuriString* statusbar_modulation;
+    FuriString* statusbar_history;
     bool radio_initialized;
     uint8_t option_flags;
     ProtoPirateSettings settings;
     uint32_t start_tx_time;
     uint8_t tx_power;
+    uint16_t hopper_dwell_ms;
+    // Receiver input is PULSE_STREAM_FILE rather than the radio, not saved
+    bool stream_input;
+    // Pulses shorter than this are merged into their neighbours, per preset
+    ProtoPirateGlitchFilter glitch_filter[PROTOPIRATE_GLITCH_FILTER_PRESETS];
+    // Transient objects of the scene on screen, reserved and released by it
+    SceneArena scene_arena;
+    // Loads setting and the keystore in the background, see
+    // protopirate_app_wait_assets
+    AssetLoader* assets;
+    ProtoPirateStartupTimes startup;
+    // Framebuffer callback still registered, waiting for the first frame
+    bool first_frame_hooked;
 };
 
 typedef enum {
@@ -80,7 +151,9 @@ void protopirate_preset_init(
     uint8_t* preset_data,
     size_t preset_data_size);
 
-const char* preset_name_to_short(const char* preset_name);
+// Setting name for a setting or FuriHal preset name, "Custom" for the FuriHal
+// custom preset and "AM650" for anything unknown
+const char* protopirate_preset_short_name(ProtoPirateApp* app, const char* preset_name);
 
 void protopirate_get_frequency_modulation(
     ProtoPirateApp* app,
@@ -89,10 +162,21 @@ void protopirate_get_frequency_modulation(
 
 void protopirate_begin(ProtoPirateApp* app, uint8_t* preset_data);
 uint32_t protopirate_rx(ProtoPirateApp* app, uint32_t frequency);
+uint8_t protopirate_preset_index(ProtoPirateApp* app);
+// Block until the AssetLoaderAsset mask is loaded. Scenes reading app->setting
+// or decoding keyed protocols call this on enter.
+void protopirate_app_wait_assets(ProtoPirateApp* app, uint32_t assets);
+uint16_t protopirate_glitch_filter_us(ProtoPirateApp* app);
 void protopirate_idle(ProtoPirateApp* app);
 void protopirate_rx_end(ProtoPirateApp* app);
 void protopirate_sleep(ProtoPirateApp* app);
-void protopirate_hopper_update(ProtoPirateApp* app);
+void protopirate_rx_pair_callback(void* context, bool level, uint32_t duration);
+void protopirate_rx_overrun_callback(void* context);
+void protopirate_receiver_reset(ProtoPirateApp* app);
+void protopirate_hopper_update(ProtoPirateApp* app, float rssi);
+void protopirate_hopper_reset(ProtoPirateApp* app);
+void protopirate_radio_thread_start(ProtoPirateApp* app);
+void protopirate_radio_thread_stop(ProtoPirateApp* app);
 void protopirate_tx(ProtoPirateApp* app, uint32_t frequency);
 void protopirate_tx_stop(ProtoPirateApp* app);
 bool protopirate_radio_init(ProtoPirateApp* app);
@@ -1,7 +1,10 @@
 // protopirate_history.c
 #include "protopirate_history.h"
+#include "helpers/protopirate_heap.h"
 #include <lib/subghz/receiver.h>
 #include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/stream.h>
+#include <string.h>
 
 #define TAG "ProtoPirateHistory"
 
@@ -10,6 +13,7 @@ typedef struct {
     FlipperFormat* flipper_format;
     uint8_t type;
     SubGhzRadioPreset* preset;
+    ProtoPirateDecodeResult result;
 } ProtoPirateHistoryItem;
 
 ARRAY_DEF(ProtoPirateHistoryItemArray, ProtoPirateHistoryItem, M_POD_OPLIST)
@@ -19,50 +23,66 @@ struct ProtoPirateHistory {
     uint16_t last_index;
     uint32_t last_update_timestamp;
     uint8_t code_last_hash_data;
+    // Guards items against the receiver view, which reads menu text while drawing
+    FuriMutex* mutex;
 };
 
+// Helper function to free a single history item's resources
+static void protopirate_history_item_free(ProtoPirateHistoryItem* item) {
+    if(item->item_str) {
+        furi_string_free(item->item_str);
+        item->item_str = NULL;
+    }
+    if(item->flipper_format) {
+        flipper_format_free(item->flipper_format);
+        item->flipper_format = NULL;
+    }
+    if(item->preset) {
+        if(item->preset->name) {
+            furi_string_free(item->preset->name);
+        }
+        protopirate_heap_free(ProtoPirateHeapHistory, item->preset, sizeof(SubGhzRadioPreset));
+        item->preset = NULL;
+    }
+}
+
 ProtoPirateHistory* protopirate_history_alloc(void) {
-    ProtoPirateHistory* instance = malloc(sizeof(ProtoPirateHistory));
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapHistory);
+    ProtoPirateHistory* instance =
+        protopirate_heap_alloc(ProtoPirateHeapHistory, sizeof(ProtoPirateHistory));
     furi_check(instance);
     ProtoPirateHistoryItemArray_init(instance->data);
     instance->last_index = 0;
     instance->last_update_timestamp = 0;
     instance->code_last_hash_data = 0;
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    protopirate_heap_settle(ProtoPirateHeapHistory, heap_mark);
     return instance;
 }
 
 void protopirate_history_free(ProtoPirateHistory* instance) {
     furi_check(instance);
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapHistory);
     for(size_t i = 0; i < ProtoPirateHistoryItemArray_size(instance->data); i++) {
-        ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, i);
-        furi_string_free(item->item_str);
-        flipper_format_free(item->flipper_format);
-        if(item->preset) {
-            if(item->preset->name) {
-                furi_string_free(item->preset->name);
-            }
-            free(item->preset);
-        }
+        protopirate_history_item_free(ProtoPirateHistoryItemArray_get(instance->data, i));
     }
     ProtoPirateHistoryItemArray_clear(instance->data);
-    free(instance);
+    furi_mutex_free(instance->mutex);
+    protopirate_heap_free(ProtoPirateHeapHistory, instance, sizeof(ProtoPirateHistory));
+    protopirate_heap_settle(ProtoPirateHeapHistory, heap_mark);
 }
 
 void protopirate_history_reset(ProtoPirateHistory* instance) {
     furi_check(instance);
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapHistory);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
     for(size_t i = 0; i < ProtoPirateHistoryItemArray_size(instance->data); i++) {
-        ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, i);
-        furi_string_free(item->item_str);
-        flipper_format_free(item->flipper_format);
-        if(item->preset) {
-            if(item->preset->name) {
-                furi_string_free(item->preset->name);
-            }
-            free(item->preset);
-        }
+        protopirate_history_item_free(ProtoPirateHistoryItemArray_get(instance->data, i));
     }
     ProtoPirateHistoryItemArray_reset(instance->data);
     instance->last_index = 0;
+    furi_mutex_release(instance->mutex);
+    protopirate_heap_settle(ProtoPirateHeapHistory, heap_mark);
 }
 
 uint16_t protopirate_history_get_item(ProtoPirateHistory* instance) {
@@ -75,95 +95,89 @@ uint16_t protopirate_history_get_last_index(ProtoPirateHistory* instance) {
     return instance->last_index;
 }
 
-// Helper function to free a single history item's resources
-static void protopirate_history_item_free(ProtoPirateHistoryItem* item) {
-    if(item->item_str) {
-        furi_string_free(item->item_str);
-        item->item_str = NULL;
-    }
-    if(item->flipper_format) {
-        flipper_format_free(item->flipper_format);
-        item->flipper_format = NULL;
-    }
-    if(item->preset) {
-        if(item->preset->name) {
-            furi_string_free(item->preset->name);
-        }
-        free(item->preset);
-        item->preset = NULL;
+// Call with the mutex held; the item's stream must be empty, its text is
+// reset here
+static void protopirate_history_fill_item(
+    ProtoPirateHistoryItem* item,
+    SubGhzProtocolDecoderBase* decoder_base,
+    SubGhzRadioPreset* preset,
+    const ProtoPirateDecodeResult* result) {
+    item->type = 0;
+
+    // Copy preset
+    item->preset->frequency = preset->frequency;
+    if(preset->name) {
+        furi_string_set(item->preset->name, preset->name);
+    } else {
+        furi_string_set(item->preset->name, "UNKNOWN");
     }
+    item->preset->data = preset->data;
+    item->preset->data_size = preset->data_size;
+
+    // The caller's get_result already ran the decoder's decryption, which
+    // get_string and serialize reuse
+    item->result = *result;
+
+    // Render the decoder text once, directly into the item. Most decoders
+    // append, and a recycled item still holds the evicted capture's text
+    furi_string_reset(item->item_str);
+    subghz_protocol_decoder_base_get_string(decoder_base, item->item_str);
+
+    // Serialize to flipper format
+    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_format, preset);
 }
 
 bool protopirate_history_add_to_history(
     ProtoPirateHistory* instance,
     void* context,
-    SubGhzRadioPreset* preset) {
+    SubGhzRadioPreset* preset,
+    const ProtoPirateDecodeResult* result) {
     furi_check(instance);
     furi_check(context);
+    furi_check(result);
 
     SubGhzProtocolDecoderBase* decoder_base = context;
+    uint8_t hash = subghz_protocol_decoder_base_get_hash_data(decoder_base);
 
     // Check for duplicate (same hash within 500ms)
-    if((instance->code_last_hash_data ==
-        subghz_protocol_decoder_base_get_hash_data(decoder_base)) &&
+    if((instance->code_last_hash_data == hash) &&
        ((furi_get_tick() - instance->last_update_timestamp) < 500)) {
         instance->last_update_timestamp = furi_get_tick();
         return false;
     }
 
-    // If history is full, remove the oldest entry
-    if(ProtoPirateHistoryItemArray_size(instance->data) >= PROTOPIRATE_HISTORY_MAX) {
-        ProtoPirateHistoryItem* oldest = ProtoPirateHistoryItemArray_get(instance->data, 0);
-        if(oldest) {
-            protopirate_history_item_free(oldest);
-        }
-        ProtoPirateHistoryItemArray_pop_at(NULL, instance->data, 0);
-        FURI_LOG_D(TAG, "History full, removed oldest entry");
-    }
-
-    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    instance->code_last_hash_data = hash;
     instance->last_update_timestamp = furi_get_tick();
 
-    // Create a new history item
-    ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_push_raw(instance->data);
-    item->item_str = furi_string_alloc();
-    item->flipper_format = flipper_format_string_alloc();
-    item->type = 0;
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapHistory);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
 
-    // Copy preset
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    if(preset->name) {
-        furi_string_set(item->preset->name, preset->name);
+    ProtoPirateHistoryItem* item;
+    if(ProtoPirateHistoryItemArray_size(instance->data) >= PROTOPIRATE_HISTORY_MAX) {
+        // History is full: move the oldest entry to the end and reuse its buffers
+        ProtoPirateHistoryItem oldest;
+        ProtoPirateHistoryItemArray_pop_at(&oldest, instance->data, 0);
+        item = ProtoPirateHistoryItemArray_push_raw(instance->data);
+        *item = oldest;
+        stream_clean(flipper_format_get_raw_stream(item->flipper_format));
+        FURI_LOG_D(TAG, "History full, recycled oldest entry");
     } else {
-        furi_string_set(item->preset->name, "UNKNOWN");
+        item = ProtoPirateHistoryItemArray_push_raw(instance->data);
+        item->item_str = furi_string_alloc();
+        item->flipper_format = flipper_format_string_alloc();
+        item->preset = protopirate_heap_alloc(ProtoPirateHeapHistory, sizeof(SubGhzRadioPreset));
+        item->preset->name = furi_string_alloc();
     }
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-
-    // Get string representation
-    FuriString* text = furi_string_alloc();
-    subghz_protocol_decoder_base_get_string(decoder_base, text);
-    furi_string_set(item->item_str, text);
-
-    // Serialize to flipper format
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_format, preset);
+    protopirate_history_fill_item(item, decoder_base, preset, result);
 
-    // Debug: Log what we're adding to history
-    flipper_format_rewind(item->flipper_format);
-    uint32_t debug_bit_count;
-    FuriString* debug_protocol = furi_string_alloc();
-    if(flipper_format_read_string(item->flipper_format, "Protocol", debug_protocol)) {
-        FURI_LOG_I(TAG, "History add - Protocol: %s", furi_string_get_cstr(debug_protocol));
-    }
-    flipper_format_rewind(item->flipper_format);
-    if(flipper_format_read_uint32(item->flipper_format, "Bit", &debug_bit_count, 1)) {
-        FURI_LOG_I(TAG, "History add - Bit count: %lu", debug_bit_count);
-    }
-    furi_string_free(debug_protocol);
+    furi_mutex_release(instance->mutex);
+    protopirate_heap_settle(ProtoPirateHeapHistory, heap_mark);
 
-    furi_string_free(text);
+    FURI_LOG_I(
+        TAG,
+        "History add - Protocol: %s, bits: %u",
+        decoder_base->protocol->name,
+        item->result.bits);
 
     instance->last_index++;
 
@@ -176,38 +190,70 @@ bool protopirate_history_add_to_history(
     return true;
 }
 
+bool protopirate_history_replace_last(
+    ProtoPirateHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset,
+    const ProtoPirateDecodeResult* result) {
+    furi_check(instance);
+    furi_check(context);
+    furi_check(result);
+
+    SubGhzProtocolDecoderBase* decoder_base = context;
+
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapHistory);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    size_t size = ProtoPirateHistoryItemArray_size(instance->data);
+    if(!size) {
+        furi_mutex_release(instance->mutex);
+        protopirate_heap_settle(ProtoPirateHeapHistory, heap_mark);
+        return false;
+    }
+
+    ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, size - 1);
+    // Drops the losing decode's text and stream before the winner is rendered
+    stream_clean(flipper_format_get_raw_stream(item->flipper_format));
+    protopirate_history_fill_item(item, decoder_base, preset, result);
+
+    furi_mutex_release(instance->mutex);
+    protopirate_heap_settle(ProtoPirateHeapHistory, heap_mark);
+
+    // Repeats of the better decode are the ones to suppress from now on
+    instance->code_last_hash_data = subghz_protocol_decoder_base_get_hash_data(decoder_base);
+    instance->last_update_timestamp = furi_get_tick();
+
+    FURI_LOG_I(TAG, "History replace - Protocol: %s", decoder_base->protocol->name);
+    return true;
+}
+
 void protopirate_history_get_text_item_menu(
     ProtoPirateHistory* instance,
     FuriString* output,
     uint16_t idx) {
     furi_check(instance);
     furi_check(output);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
 
     if(idx >= ProtoPirateHistoryItemArray_size(instance->data)) {
         furi_string_set(output, "---");
-        return;
-    }
+    } else {
+        ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, idx);
 
-    ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, idx);
+        // Get just the first line for the menu
+        const char* str = furi_string_get_cstr(item->item_str);
+        size_t len = strcspn(str, "\r\n");
 
-    // Get just the first line for the menu
-    const char* str = furi_string_get_cstr(item->item_str);
-    const char* newline = strchr(str, '\r');
-    size_t len = 0;
-    if(newline) {
-        len = newline - str;
-    } else {
-        newline = strchr(str, '\n');
-        if(newline) {
-            len = newline - str;
-        } else {
-            len = furi_string_size(item->item_str);
-        }
+        // Add index prefix
+        uint16_t display_idx = idx + 1;
+        furi_string_printf(output, "%u. %.*s", display_idx, (int)len, str);
     }
 
-    // Add index prefix
-    uint16_t display_idx = idx + 1;
-    furi_string_printf(output, "%u. %.*s", display_idx, (int)len, str);
+    furi_mutex_release(instance->mutex);
+}
+
+void protopirate_history_menu_item_callback(void* context, uint16_t idx, FuriString* output) {
+    protopirate_history_get_text_item_menu(context, output, idx);
 }
 
 void protopirate_history_get_text_item(
@@ -216,14 +262,16 @@ void protopirate_history_get_text_item(
     uint16_t idx) {
     furi_check(instance);
     furi_check(output);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
 
     if(idx >= ProtoPirateHistoryItemArray_size(instance->data)) {
         furi_string_set(output, "---");
-        return;
+    } else {
+        ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, idx);
+        furi_string_set(output, item->item_str);
     }
 
-    ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_mutex_release(instance->mutex);
 }
 
 SubGhzProtocolDecoderBase*
@@ -243,3 +291,22 @@ FlipperFormat* protopirate_history_get_raw_data(ProtoPirateHistory* instance, ui
     ProtoPirateHistoryItem* item = ProtoPirateHistoryItemArray_get(instance->data, idx);
     return item->flipper_format;
 }
+
+bool protopirate_history_get_result(
+    ProtoPirateHistory* instance,
+    uint16_t idx,
+    ProtoPirateDecodeResult* result) {
+    furi_check(instance);
+    furi_check(result);
+    furi_check(furi_mutex_acquire(instance->mutex, FuriWaitForever) == FuriStatusOk);
+
+    bool found = idx < ProtoPirateHistoryItemArray_size(instance->data);
+    if(found) {
+        *result = ProtoPirateHistoryItemArray_get(instance->data, idx)->result;
+    } else {
+        memset(result, 0, sizeof(*result));
+    }
+
+    furi_mutex_release(instance->mutex);
+    return found;
+}
@@ -4,6 +4,8 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/protocols/base.h>
 
+#include "protocols/decode_result.h"
+
 #define PROTOPIRATE_HISTORY_MAX 20
 
 typedef struct ProtoPirateHistory ProtoPirateHistory;
@@ -13,14 +15,25 @@ void protopirate_history_free(ProtoPirateHistory* instance);
 void protopirate_history_reset(ProtoPirateHistory* instance);
 uint16_t protopirate_history_get_item(ProtoPirateHistory* instance);
 uint16_t protopirate_history_get_last_index(ProtoPirateHistory* instance);
+// result is the decoder's protopirate_decoder_get_result, which the caller
+// already has, so keyed decoders aren't decrypted again for the item
 bool protopirate_history_add_to_history(
     ProtoPirateHistory* instance,
     void* context,
-    SubGhzRadioPreset* preset);
+    SubGhzRadioPreset* preset,
+    const ProtoPirateDecodeResult* result);
+// Overwrite the newest entry with a better decode of the same burst
+bool protopirate_history_replace_last(
+    ProtoPirateHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset,
+    const ProtoPirateDecodeResult* result);
 void protopirate_history_get_text_item_menu(
     ProtoPirateHistory* instance,
     FuriString* output,
     uint16_t idx);
+// Matches ProtoPirateReceiverItemCallback, context is the ProtoPirateHistory
+void protopirate_history_menu_item_callback(void* context, uint16_t idx, FuriString* output);
 void protopirate_history_get_text_item(
     ProtoPirateHistory* instance,
     FuriString* output,
@@ -28,3 +41,8 @@ void protopirate_history_get_text_item(
 SubGhzProtocolDecoderBase*
     protopirate_history_get_decoder_base(ProtoPirateHistory* instance, uint16_t idx);
 FlipperFormat* protopirate_history_get_raw_data(ProtoPirateHistory* instance, uint16_t idx);
+// Copy the decode result captured when the item was added
+bool protopirate_history_get_result(
+    ProtoPirateHistory* instance,
+    uint16_t idx,
+    ProtoPirateDecodeResult* result);
@@ -0,0 +1,127 @@
+// scenes/protopirate_scene_batch_decode.c
+#include "../protopirate_app_i.h"
+#ifdef ENABLE_SUB_DECODE_SCENE
+#include "../helpers/batch_decoder.h"
+#include <dialogs/dialogs.h>
+#include <toolbox/path.h>
+
+#ifdef BUILD_MAIN_APP
+#include "proto_pirate_icons.h"
+#else
+#include "proto_pirate_utils_icons.h"
+#endif
+
+#define TAG "ProtoPirateBatchDecode"
+
+#define SUBGHZ_APP_FOLDER EXT_PATH("subghz")
+
+// Only one batch scene can be on the stack, same as the sub decode context
+static BatchDecoder* g_batch_decoder = NULL;
+
+// Runs on the decoder thread
+static void protopirate_scene_batch_decode_progress_callback(void* context) {
+    ProtoPirateApp* app = context;
+    view_dispatcher_send_custom_event(
+        app->view_dispatcher, ProtoPirateCustomEventBatchDecodeProgress);
+}
+
+static void protopirate_scene_batch_decode_draw(ProtoPirateApp* app) {
+    BatchDecoderStatus status;
+    batch_decoder_get_status(g_batch_decoder, &status);
+
+    FuriString* text = furi_string_alloc();
+    if(status.failed) {
+        furi_string_printf(text, "Could not create\n%s", BATCH_DECODER_FOLDER);
+    } else {
+        furi_string_printf(
+            text,
+            "%s\nFiles: %u/%u\nNot RAW: %u\nMatches: %lu\n%s",
+            status.running ? "Decoding..." : "Done",
+            status.files_done,
+            status.files_total,
+            status.files_skipped,
+            status.matches,
+            status.running ? "" : batch_decoder_get_output_path(g_batch_decoder));
+    }
+
+    widget_reset(app->widget);
+    widget_add_text_scroll_element(app->widget, 0, 0, 128, 64, furi_string_get_cstr(text));
+    furi_string_free(text);
+}
+
+void protopirate_scene_batch_decode_on_enter(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+    protopirate_app_wait_assets(app, AssetLoaderKeystore);
+
+    FuriString* path = furi_string_alloc_set_str(SUBGHZ_APP_FOLDER);
+
+    DialogsFileBrowserOptions browser_options;
+    dialog_file_browser_set_basic_options(&browser_options, ".sub", &I_subghz_10px);
+    browser_options.base_path = SUBGHZ_APP_FOLDER;
+    browser_options.hide_ext = false;
+
+    // Any capture in the folder selects the whole folder
+    DialogsApp* dialogs = furi_record_open(RECORD_DIALOGS);
+    bool selected = dialog_file_browser_show(dialogs, path, path, &browser_options);
+    furi_record_close(RECORD_DIALOGS);
+
+    if(!selected) {
+        furi_string_free(path);
+        scene_manager_previous_scene(app->scene_manager);
+        return;
+    }
+
+    FuriString* folder = furi_string_alloc();
+    path_extract_dirname(furi_string_get_cstr(path), folder);
+    FURI_LOG_I(TAG, "Batch decoding %s", furi_string_get_cstr(folder));
+
+    g_batch_decoder = batch_decoder_alloc(app->txrx->receiver);
+    batch_decoder_start(
+        g_batch_decoder,
+        furi_string_get_cstr(folder),
+        protopirate_scene_batch_decode_progress_callback,
+        app);
+
+    furi_string_free(folder);
+    furi_string_free(path);
+
+    protopirate_scene_batch_decode_draw(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, ProtoPirateViewWidget);
+}
+
+bool protopirate_scene_batch_decode_on_event(void* context, SceneManagerEvent event) {
+    ProtoPirateApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == ProtoPirateCustomEventBatchDecodeProgress && g_batch_decoder) {
+            BatchDecoderStatus status;
+            batch_decoder_get_status(g_batch_decoder, &status);
+            if(!status.running) {
+                notification_message(
+                    app->notifications, status.failed ? &sequence_error : &sequence_success);
+            }
+            protopirate_scene_batch_decode_draw(app);
+            consumed = true;
+        }
+    }
+
+    return consumed;
+}
+
+void protopirate_scene_batch_decode_on_exit(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+
+    if(g_batch_decoder) {
+        // Stops and joins the thread, which hands the receiver back clean
+        batch_decoder_free(g_batch_decoder);
+        g_batch_decoder = NULL;
+    }
+    subghz_receiver_reset(app->txrx->receiver);
+    subghz_receiver_set_rx_callback(app->txrx->receiver, NULL, NULL);
+
+    widget_reset(app->widget);
+}
+#endif // ENABLE_SUB_DECODE_SCENE
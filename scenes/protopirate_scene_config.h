@@ -5,14 +5,18 @@
 ADD_SCENE(protopirate, start, Start)
 #ifdef ENABLE_SUB_DECODE_SCENE
 ADD_SCENE(protopirate, sub_decode, SubDecode)
+ADD_SCENE(protopirate, batch_decode, BatchDecode)
+ADD_SCENE(protopirate, decoder_bench, DecoderBench)
 #endif
 ADD_SCENE(protopirate, about, About)
+ADD_SCENE(protopirate, memory, Memory)
 #ifdef ENABLE_RECEIVER_SCENE
 ADD_SCENE(protopirate, receiver, Receiver)
 #endif
 ADD_SCENE(protopirate, receiver_config, ReceiverConfig)
 #ifdef ENABLE_RECEIVER_SCENE
 ADD_SCENE(protopirate, receiver_info, ReceiverInfo)
+ADD_SCENE(protopirate, receiver_diagnostics, ReceiverDiagnostics)
 #endif
 #ifdef ENABLE_SAVED_SCENE
 ADD_SCENE(protopirate, saved, Saved)
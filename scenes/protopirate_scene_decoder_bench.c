@@ -0,0 +1,66 @@
+// scenes/protopirate_scene_decoder_bench.c
+#include "../protopirate_app_i.h"
+#ifdef ENABLE_SUB_DECODE_SCENE
+#include "../helpers/decoder_bench.h"
+
+#define TAG "ProtoPirateDecoderBench"
+
+static DecoderBench* g_decoder_bench = NULL;
+
+// Runs on the bench thread
+static void protopirate_scene_decoder_bench_progress_callback(void* context) {
+    ProtoPirateApp* app = context;
+    view_dispatcher_send_custom_event(
+        app->view_dispatcher, ProtoPirateCustomEventDecoderBenchProgress);
+}
+
+static void protopirate_scene_decoder_bench_draw(ProtoPirateApp* app) {
+    FuriString* text = furi_string_alloc();
+    decoder_bench_format(g_decoder_bench, text);
+
+    widget_reset(app->widget);
+    widget_add_text_scroll_element(app->widget, 0, 0, 128, 64, furi_string_get_cstr(text));
+    furi_string_free(text);
+}
+
+void protopirate_scene_decoder_bench_on_enter(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+    protopirate_app_wait_assets(app, AssetLoaderKeystore);
+
+    g_decoder_bench = decoder_bench_alloc(app->txrx->receiver);
+    decoder_bench_start(g_decoder_bench, protopirate_scene_decoder_bench_progress_callback, app);
+
+    protopirate_scene_decoder_bench_draw(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, ProtoPirateViewWidget);
+}
+
+bool protopirate_scene_decoder_bench_on_event(void* context, SceneManagerEvent event) {
+    ProtoPirateApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == ProtoPirateCustomEventDecoderBenchProgress && g_decoder_bench) {
+            if(!decoder_bench_is_running(g_decoder_bench)) {
+                notification_message(app->notifications, &sequence_success);
+            }
+            protopirate_scene_decoder_bench_draw(app);
+            consumed = true;
+        }
+    }
+
+    return consumed;
+}
+
+void protopirate_scene_decoder_bench_on_exit(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+
+    if(g_decoder_bench) {
+        decoder_bench_free(g_decoder_bench);
+        g_decoder_bench = NULL;
+    }
+
+    widget_reset(app->widget);
+}
+#endif // ENABLE_SUB_DECODE_SCENE
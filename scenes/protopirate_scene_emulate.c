@@ -377,6 +377,7 @@ static bool protopirate_emulate_input_callback(InputEvent* event, void* context)
 
 void protopirate_scene_emulate_on_enter(void* context) {
     ProtoPirateApp* app = context;
+    protopirate_app_wait_assets(app, AssetLoaderAll);
 
     //Stop charging while using the radio.
     furi_hal_power_suppress_charge_enter();
@@ -451,7 +452,8 @@ void protopirate_scene_emulate_on_enter(void* context) {
         }
 
         // Convert full preset name to short name
-        emulate_context->preset = preset_name_to_short(furi_string_get_cstr(preset_str));
+        emulate_context->preset =
+            protopirate_preset_short_name(app, furi_string_get_cstr(preset_str));
         FURI_LOG_I(
             TAG,
             "Using frequency %lu Hz, preset %s (from %s)",
@@ -627,26 +629,24 @@ bool protopirate_scene_emulate_on_event(void* context, SceneManagerEvent event)
                             FURI_LOG_W(TAG, "Custom Preset not Loaded, trying AM650");
                             free(preset_data);
                             free_custom_data = false;
-                            preset_data =
-                                subghz_setting_get_preset_data_by_name(app->setting, "AM650");
+                            preset_data = preset_registry_get_data(&app->presets, "AM650");
                             emulate_context->preset = "AM650";
                         }
                     }
                 } else {
                     //NOT A CUStoM PRESET
                     // Get preset data with fallback chain
-                    preset_data = subghz_setting_get_preset_data_by_name(
-                        app->setting, emulate_context->preset);
+                    preset_data = preset_registry_get_data(&app->presets, emulate_context->preset);
                 }
 
                 if(!preset_data) {
                     FURI_LOG_W(TAG, "Preset %s not found, trying AM650", emulate_context->preset);
-                    preset_data = subghz_setting_get_preset_data_by_name(app->setting, "AM650");
+                    preset_data = preset_registry_get_data(&app->presets, "AM650");
                     emulate_context->preset = "AM650";
                 }
                 if(!preset_data) {
                     FURI_LOG_W(TAG, "AM650 not found, trying FM476");
-                    preset_data = subghz_setting_get_preset_data_by_name(app->setting, "FM476");
+                    preset_data = preset_registry_get_data(&app->presets, "FM476");
                     emulate_context->preset = "FM476";
                 }
 
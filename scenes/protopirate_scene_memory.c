@@ -0,0 +1,72 @@
+// scenes/protopirate_scene_memory.c
+#include "../protopirate_app_i.h"
+
+#define TAG "ProtoPirateMemory"
+
+static void protopirate_scene_memory_widget_callback(
+    GuiButtonType result,
+    InputType type,
+    void* context) {
+    ProtoPirateApp* app = context;
+    if(type == InputTypeShort) {
+        if(result == GuiButtonTypeCenter) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventMemoryRefresh);
+        } else if(result == GuiButtonTypeLeft) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventMemoryReset);
+        }
+    }
+}
+
+static void protopirate_scene_memory_draw(ProtoPirateApp* app) {
+    widget_reset(app->widget);
+
+    FuriString* text = furi_string_alloc();
+    protopirate_heap_format(text);
+    protopirate_frame_format(text);
+    widget_add_text_scroll_element(app->widget, 0, 0, 128, 50, furi_string_get_cstr(text));
+    furi_string_free(text);
+
+    widget_add_button_element(
+        app->widget, GuiButtonTypeLeft, "Reset", protopirate_scene_memory_widget_callback, app);
+    widget_add_button_element(
+        app->widget,
+        GuiButtonTypeCenter,
+        "Refresh",
+        protopirate_scene_memory_widget_callback,
+        app);
+}
+
+void protopirate_scene_memory_on_enter(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+
+    protopirate_scene_memory_draw(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, ProtoPirateViewWidget);
+}
+
+bool protopirate_scene_memory_on_event(void* context, SceneManagerEvent event) {
+    ProtoPirateApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == ProtoPirateCustomEventMemoryReset) {
+            protopirate_heap_reset_trend();
+            protopirate_frame_reset();
+            protopirate_scene_memory_draw(app);
+            consumed = true;
+        } else if(event.event == ProtoPirateCustomEventMemoryRefresh) {
+            protopirate_scene_memory_draw(app);
+            consumed = true;
+        }
+    }
+
+    return consumed;
+}
+
+void protopirate_scene_memory_on_exit(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+    widget_reset(app->widget);
+}
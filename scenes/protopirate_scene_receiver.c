@@ -2,6 +2,7 @@
 #include "../protopirate_app_i.h"
 #ifdef ENABLE_RECEIVER_SCENE
 #include "../helpers/protopirate_storage.h"
+#include "../protocols/protocol_items.h"
 #include "views/protopirate_receiver.h"
 #include <notification/notification_messages.h>
 
@@ -11,30 +12,17 @@
 // Forward declaration
 void protopirate_scene_receiver_view_callback(ProtoPirateCustomEvent event, void* context);
 
+// Frequency currently shown in the status bar
+static uint32_t drawn_frequency = 0;
+
 static void protopirate_scene_receiver_update_statusbar(void* context) {
     furi_check(context);
     ProtoPirateApp* app = context;
 
-    FuriString* frequency_str = furi_string_alloc();
-    if(!frequency_str) {
-        FURI_LOG_E(TAG, "frequency_str allocation failed");
-        return;
-    }
-    FuriString* modulation_str = furi_string_alloc();
-    if(!modulation_str) {
-        FURI_LOG_E(TAG, "modulation_str allocation failed");
-        furi_string_free(frequency_str);
-        return;
-    }
-    FuriString* history_stat_str = furi_string_alloc();
-    if(!history_stat_str) {
-        FURI_LOG_E(TAG, "history_stat_str allocation failed");
-        furi_string_free(frequency_str);
-        furi_string_free(modulation_str);
-        return;
-    }
-
-    protopirate_get_frequency_modulation(app, frequency_str, modulation_str);
+    protopirate_get_frequency_modulation(
+        app, app->statusbar_frequency, app->statusbar_modulation);
+    if(app->stream_input) furi_string_set(app->statusbar_modulation, "Stream");
+    drawn_frequency = app->txrx->preset->frequency;
 
     // Check if using external radio (only if radio is initialized)
     bool is_external = false;
@@ -43,21 +31,17 @@ static void protopirate_scene_receiver_update_statusbar(void* context) {
     }
 
     furi_string_printf(
-        history_stat_str,
+        app->statusbar_history,
         "%u/%u",
         protopirate_history_get_item(app->txrx->history),
         PROTOPIRATE_DISPLAY_HISTORY_MAX);
     // Pass actual external radio status
     protopirate_view_receiver_add_data_statusbar(
         app->protopirate_receiver,
-        furi_string_get_cstr(frequency_str),
-        furi_string_get_cstr(modulation_str),
-        furi_string_get_cstr(history_stat_str),
+        furi_string_get_cstr(app->statusbar_frequency),
+        furi_string_get_cstr(app->statusbar_modulation),
+        furi_string_get_cstr(app->statusbar_history),
         is_external);
-
-    furi_string_free(frequency_str);
-    furi_string_free(modulation_str);
-    furi_string_free(history_stat_str);
 }
 
 static void protopirate_scene_receiver_callback(
@@ -68,20 +52,41 @@ static void protopirate_scene_receiver_callback(
     furi_check(decoder_base);
     furi_check(context);
     ProtoPirateApp* app = context;
+    ProtoPirateRxMetrics* metrics = &app->txrx->metrics;
+    uint32_t start = protopirate_rx_metrics_now();
 
     FURI_LOG_I(TAG, "=== SIGNAL DECODED ===");
 
-    FuriString* str_buff = furi_string_alloc();
-    if(!str_buff) {
-        FURI_LOG_E(TAG, "str_buff allocation failed");
+    ProtoPirateProtocolId protocol_id = protopirate_protocol_id(decoder_base->protocol);
+    if(protocol_id < ProtoPirateProtocolIdCount) metrics->decodes[protocol_id]++;
+
+    ProtoPirateDecodeResult result;
+    protopirate_decoder_get_result(decoder_base, &result);
+    uint8_t score = protopirate_decode_result_score(&result);
+
+    // Decoders sharing a timing family can all fire on one burst: keep the best
+    ProtoPirateArbitration* arbitration = &app->txrx->arbitration;
+    bool same_burst = arbitration->valid && arbitration->burst == app->txrx->burst_id;
+    if(same_burst && score <= arbitration->score) {
+        metrics->arbitration_losses++;
+        protopirate_rx_metrics_timing_add(&metrics->rx_callback, start);
         return;
     }
 
-    subghz_protocol_decoder_base_get_string(decoder_base, str_buff);
-    FURI_LOG_I(TAG, "%s", furi_string_get_cstr(str_buff));
+    bool replace = same_burst && arbitration->reported;
+    if(same_burst) metrics->arbitration_losses++;
+    arbitration->burst = app->txrx->burst_id;
+    arbitration->score = score;
+    arbitration->valid = true;
+
+    // History renders the decoder text once, straight into its own item
+    bool added = replace ? protopirate_history_replace_last(
+                               app->txrx->history, decoder_base, app->txrx->preset, &result) :
+                           protopirate_history_add_to_history(
+                               app->txrx->history, decoder_base, app->txrx->preset, &result);
+    arbitration->reported = added;
 
-    // Add to history
-    if(protopirate_history_add_to_history(app->txrx->history, decoder_base, app->txrx->preset)) {
+    if(added) {
         notification_message(app->notifications, &sequence_semi_success);
 
         FURI_LOG_I(
@@ -89,62 +94,18 @@ static void protopirate_scene_receiver_callback(
             "Added to history, total items: %u",
             protopirate_history_get_item(app->txrx->history));
 
-        FuriString* item_name = furi_string_alloc();
-        if(!item_name) {
-            FURI_LOG_E(TAG, "item_name allocation failed");
-            return;
-        }
-
-        protopirate_history_get_text_item_menu(
-            app->txrx->history, item_name, protopirate_history_get_item(app->txrx->history) - 1);
-
-        protopirate_view_receiver_add_item_to_menu(
-            app->protopirate_receiver, furi_string_get_cstr(item_name), 0);
-
-        furi_string_free(item_name);
-
-        // Auto-scroll to the last detected signal
-        uint16_t last_index = protopirate_history_get_item(app->txrx->history) - 1;
-        protopirate_view_receiver_set_idx_menu(app->protopirate_receiver, last_index);
-
         // Auto-save if enabled
         if(app->option_flags & FLAG_AUTO_SAVE) {
-            FlipperFormat* ff = protopirate_history_get_raw_data(
-                app->txrx->history, protopirate_history_get_item(app->txrx->history) - 1);
+            uint16_t last = protopirate_history_get_item(app->txrx->history) - 1;
+            FlipperFormat* ff = protopirate_history_get_raw_data(app->txrx->history, last);
 
             if(ff) {
-                FuriString* saved_path = furi_string_alloc();
-                FuriString* file_name_str = furi_string_alloc();
-
-                if(app->option_flags & FLAG_DATETIME_FILENAMES) {
-                    //Get the date and time to save.
-                    DateTime date_time;
-                    furi_hal_rtc_get_datetime(&date_time);
-                    furi_string_printf(
-                        file_name_str,
-                        "%.2d%.2d%.2d_%.2d.%.2d.%.2d_",
-                        date_time.year,
-                        date_time.month,
-                        date_time.day,
-                        date_time.hour,
-                        date_time.minute,
-                        date_time.second);
-                }
+                FuriString* saved_path = app->rx_saved_path;
+                FuriString* file_name_str = app->rx_file_name;
 
-                // Extract protocol name
-                FuriString* protocol = furi_string_alloc();
-                flipper_format_rewind(ff);
-                if(!flipper_format_read_string(ff, "Protocol", protocol)) {
-                    furi_string_set_str(protocol, "Unknown");
-                }
-
-                //Add the protocol
-                furi_string_cat(file_name_str, protocol);
-                furi_string_free(protocol);
-
-                // Clean protocol name for filename
-                furi_string_replace_all(file_name_str, "/", "_");
-                furi_string_replace_all(file_name_str, " ", "_");
+                // The newest item was filled from this decode's result
+                protopirate_storage_capture_name(
+                    &result, app->option_flags & FLAG_DATETIME_FILENAMES, file_name_str);
 
                 if(protopirate_storage_save_capture(
                        ff,
@@ -156,30 +117,81 @@ static void protopirate_scene_receiver_callback(
                 } else {
                     FURI_LOG_E(TAG, "Auto-save failed");
                 }
-
-                furi_string_free(file_name_str);
-                furi_string_free(saved_path);
             }
         }
 
-        view_dispatcher_send_custom_event(
-            app->view_dispatcher, ProtoPirateCustomEventSceneReceiverUpdate);
+        // The view reads rows from history, it only needs the new count. A
+        // burst of decodes is folded into one refresh on the GUI thread
+        if(event_coalescer_post(
+               &app->txrx->history_updates,
+               protopirate_history_get_item(app->txrx->history),
+               furi_get_tick())) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventSceneReceiverUpdate);
+        }
+        if(protocol_id < ProtoPirateProtocolIdCount) {
+            protopirate_rx_metrics_timing_add(
+                &metrics->latency[protocol_id], metrics->pulse_cycles);
+        }
     } else {
-        FURI_LOG_W(TAG, "Failed to add to history (duplicate or full)");
+        // History recycles its oldest entry, so a refusal is always a repeat
+        metrics->duplicates++;
+        FURI_LOG_W(TAG, "Failed to add to history (duplicate)");
     }
 
-    furi_string_free(str_buff);
+    // A full length frame with a valid CRC settles the burst, so the other
+    // decoders still chewing on it can stop
+    const uint8_t decisive = PROTOPIRATE_SCORE_CRC | PROTOPIRATE_SCORE_FULL;
+    if((score & decisive) == decisive) {
+        metrics->early_resets +=
+            protopirate_receiver_reset_others(app->txrx->decoders, protocol_id);
+    }
 
-    // Pause hopper when we receive something
+    // Hold on the frequency that just decoded and weight it for later visits
     if(app->txrx->hopper_state == ProtoPirateHopperStateRunning) {
-        app->txrx->hopper_state = ProtoPirateHopperStatePause;
-        app->txrx->hopper_timeout = 10;
+        app->txrx->hopper_decode_pending = true;
+    }
+
+    protopirate_rx_metrics_timing_add(&metrics->rx_callback, start);
+}
+
+// Pulses come from PULSE_STREAM_FILE through the same path the radio worker
+// feeds, so decodes, history, auto-save and latency all work as on air. The
+// radio stays idle and the hopper doesn't run.
+static void protopirate_scene_receiver_stream_start(ProtoPirateApp* app) {
+    ProtoPirateTxRx* txrx = app->txrx;
+    if(!txrx->stream) {
+        txrx->stream = pulse_stream_alloc(
+            PULSE_STREAM_FILE, PROTOPIRATE_RX_RESYNC_GAP_US, protopirate_rx_pair_callback, app);
     }
+    FURI_LOG_I(TAG, "Reading pulses from %s", PULSE_STREAM_FILE);
+    pulse_stream_start(txrx->stream);
 }
 
+static void protopirate_scene_receiver_stream_stop(ProtoPirateApp* app) {
+    ProtoPirateTxRx* txrx = app->txrx;
+    if(!txrx->stream) return;
+
+#ifndef REMOVE_LOGS
+    PulseStreamStats stats = pulse_stream_get_stats(txrx->stream);
+    FURI_LOG_I(
+        TAG,
+        "Stream: %lu bytes, %lu pulses, %lu gaps, %lu restarts",
+        stats.bytes,
+        stats.pulses,
+        stats.gaps,
+        stats.restarts);
+#endif
+    pulse_stream_free(txrx->stream);
+    txrx->stream = NULL;
+}
+
+static void protopirate_scene_receiver_enter_view(ProtoPirateApp* app);
+
 void protopirate_scene_receiver_on_enter(void* context) {
     furi_check(context);
     ProtoPirateApp* app = context;
+    protopirate_app_wait_assets(app, AssetLoaderAll);
 
     FURI_LOG_I(TAG, "=== ENTERING RECEIVER SCENE ===");
 
@@ -207,6 +219,14 @@ void protopirate_scene_receiver_on_enter(void* context) {
             FURI_LOG_E(TAG, "Failed to allocate history!");
             return;
         }
+        // New session, new counters
+        protopirate_rx_metrics_reset(&app->txrx->metrics);
+        memset(&app->txrx->arbitration, 0, sizeof(ProtoPirateArbitration));
+    }
+
+    if(!app->txrx->burst_filter) {
+        app->txrx->burst_filter = malloc(sizeof(BurstFilter));
+        burst_filter_init(app->txrx->burst_filter);
     }
 
     // Allocate worker
@@ -217,23 +237,34 @@ void protopirate_scene_receiver_on_enter(void* context) {
             return;
         }
         // Set up worker callbacks
-        subghz_worker_set_overrun_callback(
-            app->txrx->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-        subghz_worker_set_pair_callback(
-            app->txrx->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
-        subghz_worker_set_context(app->txrx->worker, app->txrx->receiver);
+        subghz_worker_set_overrun_callback(app->txrx->worker, protopirate_rx_overrun_callback);
+        subghz_worker_set_pair_callback(app->txrx->worker, protopirate_rx_pair_callback);
+        subghz_worker_set_context(app->txrx->worker, app);
     }
 
     // Set up the receiver callback
+    event_coalescer_init(&app->txrx->history_updates, EVENT_COALESCER_FRAME_MS);
     subghz_receiver_set_rx_callback(app->txrx->receiver, protopirate_scene_receiver_callback, app);
 
     // Set up view callback
     protopirate_view_receiver_set_callback(
         app->protopirate_receiver, protopirate_scene_receiver_view_callback, app);
 
+    // Menu rows are drawn straight from history
+    protopirate_view_receiver_set_item_source(
+        app->protopirate_receiver, protopirate_history_menu_item_callback, app->txrx->history);
+    protopirate_view_receiver_set_item_count(
+        app->protopirate_receiver, protopirate_history_get_item(app->txrx->history));
+
     // Update status bar
     protopirate_scene_receiver_update_statusbar(app);
 
+    if(app->stream_input) {
+        protopirate_scene_receiver_stream_start(app);
+        protopirate_scene_receiver_enter_view(app);
+        return;
+    }
+
     // Start hopper if enabled
     if(app->txrx->hopper_state != ProtoPirateHopperStateOFF) {
         app->txrx->hopper_state = ProtoPirateHopperStateRunning;
@@ -241,11 +272,11 @@ void protopirate_scene_receiver_on_enter(void* context) {
 
     // Get preset data
     const char* preset_name = furi_string_get_cstr(app->txrx->preset->name);
-    uint8_t* preset_data = subghz_setting_get_preset_data_by_name(app->setting, preset_name);
+    uint8_t* preset_data = preset_registry_get_data(&app->presets, preset_name);
 
     if(preset_data == NULL) {
         FURI_LOG_E(TAG, "Failed to get preset data for %s, using AM650", preset_name);
-        preset_data = subghz_setting_get_preset_data_by_name(app->setting, "AM650");
+        preset_data = preset_registry_get_data(&app->presets, "AM650");
     }
 
     // Begin receiving
@@ -253,14 +284,29 @@ void protopirate_scene_receiver_on_enter(void* context) {
 
     uint32_t frequency = app->txrx->preset->frequency;
     if(app->txrx->hopper_state == ProtoPirateHopperStateRunning) {
-        frequency = subghz_setting_get_hopper_frequency(app->setting, 0);
-        app->txrx->hopper_idx_frequency = 0;
+        // Keep per-frequency activity across the info and config scenes
+        HopperScheduler* hopper = &app->txrx->hopper;
+        size_t hopper_count = subghz_setting_get_hopper_frequency_count(app->setting);
+        if(hopper->count != MIN(hopper_count, HOPPER_SCHEDULER_MAX_SLOTS) ||
+           hopper->config.base_dwell != app->hopper_dwell_ms) {
+            protopirate_hopper_reset(app);
+        }
+        frequency =
+            subghz_setting_get_hopper_frequency(app->setting, hopper_scheduler_current(hopper));
     }
 
     FURI_LOG_I(TAG, "Starting RX on %lu Hz", frequency);
+    if(!app->startup.rx_start) app->startup.rx_start = furi_get_tick();
     protopirate_rx(app, frequency);
     FURI_LOG_I(TAG, "RX started, state: %d", app->txrx->txrx_state);
 
+    // RSSI and hopping run on their own thread from here on
+    protopirate_radio_thread_start(app);
+
+    protopirate_scene_receiver_enter_view(app);
+}
+
+static void protopirate_scene_receiver_enter_view(ProtoPirateApp* app) {
     // Update lock state in view
     protopirate_view_receiver_set_lock(app->protopirate_receiver, app->lock);
 
@@ -282,8 +328,27 @@ bool protopirate_scene_receiver_on_event(void* context, SceneManagerEvent event)
 
     if(event.type == SceneManagerEventTypeCustom) {
         switch(event.event) {
-        case ProtoPirateCustomEventSceneReceiverUpdate:
-            protopirate_scene_receiver_update_statusbar(app);
+        case ProtoPirateCustomEventSceneReceiverUpdate: {
+            uint32_t item_count;
+            if(event_coalescer_take(
+                   &app->txrx->history_updates, furi_get_tick(), &item_count)) {
+                protopirate_view_receiver_set_item_count(app->protopirate_receiver, item_count);
+                // Auto-scroll to the last detected signal
+                protopirate_view_receiver_set_idx_menu(app->protopirate_receiver, item_count - 1);
+                protopirate_scene_receiver_update_statusbar(app);
+            }
+        }
+            consumed = true;
+            break;
+
+        case ProtoPirateCustomEventSceneReceiverRadio: {
+            // Clear first so a change landing while we draw queues a new event
+            app->txrx->radio_update_pending = false;
+            protopirate_view_receiver_set_rssi(app->protopirate_receiver, app->txrx->shown_rssi);
+            if(app->txrx->shown_frequency != drawn_frequency) {
+                protopirate_scene_receiver_update_statusbar(app);
+            }
+        }
             consumed = true;
             break;
 
@@ -305,7 +370,15 @@ bool protopirate_scene_receiver_on_event(void* context, SceneManagerEvent event)
             consumed = true;
             break;
 
+        case ProtoPirateCustomEventViewReceiverDiagnostics:
+            scene_manager_set_scene_state(app->scene_manager, ProtoPirateSceneReceiver, 1);
+            scene_manager_next_scene(app->scene_manager, ProtoPirateSceneReceiverDiagnostics);
+            consumed = true;
+            break;
+
         case ProtoPirateCustomEventViewReceiverBack:
+            protopirate_scene_receiver_stream_stop(app);
+            protopirate_radio_thread_stop(app);
             if(app->txrx->txrx_state == ProtoPirateTxRxStateRx) {
                 protopirate_rx_end(app);
             }
@@ -322,18 +395,13 @@ bool protopirate_scene_receiver_on_event(void* context, SceneManagerEvent event)
             break;
         }
     } else if(event.type == SceneManagerEventTypeTick) {
-        // Update hopper
-        if(app->txrx->hopper_state != ProtoPirateHopperStateOFF) {
-            protopirate_hopper_update(app);
-            protopirate_scene_receiver_update_statusbar(app);
+        // Decodes merged since the last refresh
+        if(event_coalescer_flush(&app->txrx->history_updates)) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventSceneReceiverUpdate);
         }
 
-        // Update RSSI from the correct radio device (only if initialized)
-        if(app->radio_initialized && app->txrx->txrx_state == ProtoPirateTxRxStateRx &&
-           app->txrx->radio_device) {
-            float rssi = subghz_devices_get_rssi(app->txrx->radio_device);
-            protopirate_view_receiver_set_rssi(app->protopirate_receiver, rssi);
-
+        if(app->radio_initialized && app->txrx->txrx_state == ProtoPirateTxRxStateRx) {
             // Debug: Log RSSI periodically (every ~5 seconds)
             static uint8_t rssi_log_counter = 0;
             if(++rssi_log_counter >= 50) {
@@ -341,7 +409,11 @@ bool protopirate_scene_receiver_on_event(void* context, SceneManagerEvent event)
                 bool is_external = app->txrx->radio_device ?
                                        radio_device_loader_is_external(app->txrx->radio_device) :
                                        false;
-                FURI_LOG_D(TAG, "RSSI: %.1f dBm (%s)", (double)rssi, is_external ? "EXT" : "INT");
+                FURI_LOG_D(
+                    TAG,
+                    "RSSI: %d dBm (%s)",
+                    app->txrx->shown_rssi,
+                    is_external ? "EXT" : "INT");
 #endif
                 rssi_log_counter = 0;
             }
@@ -362,6 +434,11 @@ void protopirate_scene_receiver_on_exit(void* context) {
 
     FURI_LOG_I(TAG, "=== EXITING RECEIVER SCENE ===");
 
+    // The radio and stream threads feed the receiver, stop them before
+    // anything else touches it
+    protopirate_scene_receiver_stream_stop(app);
+    protopirate_radio_thread_stop(app);
+
     // Only try to stop RX if radio is initialized
     if(app->radio_initialized && app->txrx->txrx_state == ProtoPirateTxRxStateRx) {
         protopirate_rx_end(app);
@@ -381,6 +458,7 @@ void protopirate_scene_receiver_on_exit(void* context) {
 
     // Reset both view menu AND history when actually leaving (only if radio initialized)
     protopirate_view_receiver_reset_menu(app->protopirate_receiver);
+    hopper_scheduler_init(&app->txrx->hopper, &hopper_scheduler_default_config, 0, 0);
     if(app->radio_initialized && app->txrx->history) {
         protopirate_history_reset(app->txrx->history);
     }
@@ -392,6 +470,10 @@ void protopirate_scene_receiver_on_exit(void* context) {
     } else {
         FURI_LOG_D(TAG, "History was NULL, skipping free");
     }
+
+    // Worker is gone, nothing feeds the filter any more
+    free(app->txrx->burst_filter);
+    app->txrx->burst_filter = NULL;
 }
 
 void protopirate_scene_receiver_view_callback(ProtoPirateCustomEvent event, void* context) {
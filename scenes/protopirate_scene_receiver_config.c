@@ -4,11 +4,15 @@
 enum ProtoPirateSettingIndex {
     ProtoPirateSettingIndexFrequency,
     ProtoPirateSettingIndexHopping,
+    ProtoPirateSettingIndexHopDwell,
     ProtoPirateSettingIndexModulation,
+    ProtoPirateSettingIndexGlitchFilter,
 #ifdef ENABLE_EMULATE_FEATURE
     ProtoPirateSettingIndexTXPower,
 #endif
     ProtoPirateSettingIndexAutoSave,
+    ProtoPirateSettingIndexFilenames,
+    ProtoPirateSettingIndexInput,
     ProtoPirateSettingIndexLock,
 };
 
@@ -23,6 +27,27 @@ const uint32_t hopping_value[HOPPING_COUNT] = {
     ProtoPirateHopperStateRunning,
 };
 
+#define HOP_DWELL_COUNT PROTOPIRATE_HOPPER_DWELL_COUNT
+const char* const hop_dwell_text[HOP_DWELL_COUNT] = {
+    "50ms",
+    "100ms",
+    "200ms",
+    "400ms",
+    "800ms",
+};
+
+#define GLITCH_FILTER_COUNT PROTOPIRATE_GLITCH_FILTER_COUNT
+const char* const glitch_filter_text[GLITCH_FILTER_COUNT] = {
+    "OFF",
+    "60us",
+    "100us",
+    "150us",
+    "200us",
+};
+
+// Follows the Modulation item, so it is refreshed when the preset changes
+static VariableItem* glitch_filter_item;
+
 #define ON_OFF_COUNT 2
 const char* const on_off_text[ON_OFF_COUNT] = {
     "OFF",
@@ -35,6 +60,12 @@ const char* const sequence_time_text[ON_OFF_COUNT] = {
     "Time",
 };
 
+#define INPUT_COUNT 2
+const char* const input_text[INPUT_COUNT] = {
+    "Radio",
+    "Stream",
+};
+
 #ifdef ENABLE_EMULATE_FEATURE
 #define TX_POWER_COUNT 9
 const char* const tx_power_text[TX_POWER_COUNT] = {
@@ -68,14 +99,8 @@ uint8_t protopirate_scene_receiver_config_next_frequency(const uint32_t value, v
 uint8_t protopirate_scene_receiver_config_next_preset(const char* preset_name, void* context) {
     furi_check(context);
     ProtoPirateApp* app = context;
-    uint8_t index = 0;
-    for(uint8_t i = 0; i < subghz_setting_get_preset_count(app->setting); i++) {
-        if(!strcmp(subghz_setting_get_preset_name(app->setting, i), preset_name)) {
-            index = i;
-            break;
-        }
-    }
-    return index;
+    uint8_t index = preset_registry_find(&app->presets, preset_name);
+    return preset_registry_is_valid(&app->presets, index) ? index : 0;
 }
 
 uint8_t protopirate_scene_receiver_config_hopper_value_index(
@@ -118,6 +143,19 @@ static void protopirate_scene_receiver_config_set_frequency(VariableItem* item)
     }
 }
 
+static void protopirate_scene_receiver_config_show_glitch_filter(ProtoPirateApp* app) {
+    uint16_t threshold = protopirate_glitch_filter_us(app);
+    uint8_t value_index = 0;
+    for(uint8_t i = 0; i < GLITCH_FILTER_COUNT; i++) {
+        if(protopirate_glitch_filter_values[i] == threshold) {
+            value_index = i;
+            break;
+        }
+    }
+    variable_item_set_current_value_index(glitch_filter_item, value_index);
+    variable_item_set_current_value_text(glitch_filter_item, glitch_filter_text[value_index]);
+}
+
 static void protopirate_scene_receiver_config_set_preset(VariableItem* item) {
     ProtoPirateApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -129,6 +167,23 @@ static void protopirate_scene_receiver_config_set_preset(VariableItem* item) {
         app->txrx->preset->frequency,
         subghz_setting_get_preset_data(app->setting, index),
         subghz_setting_get_preset_data_size(app->setting, index));
+    protopirate_scene_receiver_config_show_glitch_filter(app);
+}
+
+static void protopirate_scene_receiver_config_set_glitch_filter(VariableItem* item) {
+    ProtoPirateApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    if(protopirate_glitch_filter_set(
+           app->glitch_filter,
+           furi_string_get_cstr(app->txrx->preset->name),
+           protopirate_glitch_filter_values[index])) {
+        variable_item_set_current_value_text(item, glitch_filter_text[index]);
+    } else {
+        // Every slot is taken by other presets, this one keeps the default
+        variable_item_set_current_value_index(item, 0);
+        variable_item_set_current_value_text(item, glitch_filter_text[0]);
+    }
 }
 
 static void protopirate_scene_receiver_config_set_hopping_running(VariableItem* item) {
@@ -167,6 +222,14 @@ static void protopirate_scene_receiver_config_set_hopping_running(VariableItem*
     app->txrx->hopper_state = hopping_value[index];
 }
 
+static void protopirate_scene_receiver_config_set_hop_dwell(VariableItem* item) {
+    ProtoPirateApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, hop_dwell_text[index]);
+    app->hopper_dwell_ms = protopirate_hopper_dwell_ms[index];
+}
+
 static void protopirate_scene_receiver_config_set_auto_save(VariableItem* item) {
     ProtoPirateApp* app = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -193,6 +256,14 @@ static void protopirate_scene_receiver_config_set_datetime_filenames(VariableIte
     variable_item_set_current_value_text(item, sequence_time_text[index]);
 }
 
+static void protopirate_scene_receiver_config_set_input(VariableItem* item) {
+    ProtoPirateApp* app = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    app->stream_input = index == 1;
+    variable_item_set_current_value_text(item, input_text[index]);
+}
+
 #ifdef ENABLE_EMULATE_FEATURE
 static void protopirate_scene_receiver_config_set_tx_power(VariableItem* item) {
     ProtoPirateApp* app = variable_item_get_context(item);
@@ -218,6 +289,8 @@ void protopirate_scene_receiver_config_on_enter(void* context) {
     VariableItem* item;
     uint8_t value_index;
 
+    protopirate_app_wait_assets(app, AssetLoaderSetting);
+
     item = variable_item_list_add(
         app->variable_item_list,
         "Frequency:",
@@ -249,6 +322,22 @@ void protopirate_scene_receiver_config_on_enter(void* context) {
     variable_item_set_current_value_index(item, value_index);
     variable_item_set_current_value_text(item, hopping_text[value_index]);
 
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Hop Dwell:",
+        HOP_DWELL_COUNT,
+        protopirate_scene_receiver_config_set_hop_dwell,
+        app);
+    value_index = 1;
+    for(uint8_t i = 0; i < HOP_DWELL_COUNT; i++) {
+        if(protopirate_hopper_dwell_ms[i] == app->hopper_dwell_ms) {
+            value_index = i;
+            break;
+        }
+    }
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, hop_dwell_text[value_index]);
+
     item = variable_item_list_add(
         app->variable_item_list,
         "Modulation:",
@@ -261,6 +350,14 @@ void protopirate_scene_receiver_config_on_enter(void* context) {
     variable_item_set_current_value_text(
         item, subghz_setting_get_preset_name(app->setting, value_index));
 
+    glitch_filter_item = variable_item_list_add(
+        app->variable_item_list,
+        "Glitch Filter:",
+        GLITCH_FILTER_COUNT,
+        protopirate_scene_receiver_config_set_glitch_filter,
+        app);
+    protopirate_scene_receiver_config_show_glitch_filter(app);
+
 #ifdef ENABLE_EMULATE_FEATURE
     // TX power option
     item = variable_item_list_add(
@@ -295,6 +392,16 @@ void protopirate_scene_receiver_config_on_enter(void* context) {
     variable_item_set_current_value_text(
         item, sequence_time_text[(app->option_flags & FLAG_DATETIME_FILENAMES) ? 1 : 0]);
 
+    // Pulse source, the stream file is for driving the decoders from a host
+    item = variable_item_list_add(
+        app->variable_item_list,
+        "Input:",
+        INPUT_COUNT,
+        protopirate_scene_receiver_config_set_input,
+        app);
+    variable_item_set_current_value_index(item, app->stream_input ? 1 : 0);
+    variable_item_set_current_value_text(item, input_text[app->stream_input ? 1 : 0]);
+
     //Lock Keyboard option
     variable_item_list_add(app->variable_item_list, "Lock Keyboard", 1, NULL, NULL);
     variable_item_list_set_enter_callback(
@@ -0,0 +1,102 @@
+// scenes/protopirate_scene_receiver_diagnostics.c
+#include "../protopirate_app_i.h"
+#ifdef ENABLE_RECEIVER_SCENE
+
+#define TAG "ProtoPirateReceiverDiagnostics"
+
+static void protopirate_scene_receiver_diagnostics_widget_callback(
+    GuiButtonType result,
+    InputType type,
+    void* context) {
+    ProtoPirateApp* app = context;
+    if(type == InputTypeShort) {
+        if(result == GuiButtonTypeRight) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventReceiverDiagnosticsSave);
+        } else if(result == GuiButtonTypeLeft) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventReceiverDiagnosticsReset);
+        } else if(result == GuiButtonTypeCenter) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventReceiverDiagnosticsMemory);
+        }
+    }
+}
+
+static void protopirate_scene_receiver_diagnostics_draw(ProtoPirateApp* app) {
+    widget_reset(app->widget);
+
+    FuriString* text = furi_string_alloc();
+    protopirate_rx_metrics_format(&app->txrx->metrics, text);
+    furi_string_cat_printf(
+        text,
+        "UI: %lu updates %lu redraws\n",
+        app->txrx->history_updates.posts,
+        app->txrx->history_updates.refreshes);
+    protopirate_rx_metrics_format_startup(&app->startup, text);
+    widget_add_text_scroll_element(app->widget, 0, 0, 128, 50, furi_string_get_cstr(text));
+    furi_string_free(text);
+
+    widget_add_button_element(
+        app->widget,
+        GuiButtonTypeLeft,
+        "Reset",
+        protopirate_scene_receiver_diagnostics_widget_callback,
+        app);
+    widget_add_button_element(
+        app->widget,
+        GuiButtonTypeCenter,
+        "Heap",
+        protopirate_scene_receiver_diagnostics_widget_callback,
+        app);
+    widget_add_button_element(
+        app->widget,
+        GuiButtonTypeRight,
+        "Save",
+        protopirate_scene_receiver_diagnostics_widget_callback,
+        app);
+}
+
+void protopirate_scene_receiver_diagnostics_on_enter(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+
+    protopirate_scene_receiver_diagnostics_draw(app);
+    view_dispatcher_switch_to_view(app->view_dispatcher, ProtoPirateViewWidget);
+}
+
+bool protopirate_scene_receiver_diagnostics_on_event(void* context, SceneManagerEvent event) {
+    ProtoPirateApp* app = context;
+    bool consumed = false;
+
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == ProtoPirateCustomEventReceiverDiagnosticsSave) {
+            FuriString* saved_path = furi_string_alloc();
+            if(protopirate_rx_metrics_save(&app->txrx->metrics, saved_path)) {
+                notification_message(app->notifications, &sequence_success);
+                FURI_LOG_I(TAG, "Saved to: %s", furi_string_get_cstr(saved_path));
+            } else {
+                notification_message(app->notifications, &sequence_error);
+                FURI_LOG_E(TAG, "Save failed");
+            }
+            furi_string_free(saved_path);
+            consumed = true;
+        } else if(event.event == ProtoPirateCustomEventReceiverDiagnosticsReset) {
+            protopirate_rx_metrics_reset(&app->txrx->metrics);
+            protopirate_scene_receiver_diagnostics_draw(app);
+            consumed = true;
+        } else if(event.event == ProtoPirateCustomEventReceiverDiagnosticsMemory) {
+            scene_manager_next_scene(app->scene_manager, ProtoPirateSceneMemory);
+            consumed = true;
+        }
+    }
+
+    return consumed;
+}
+
+void protopirate_scene_receiver_diagnostics_on_exit(void* context) {
+    furi_check(context);
+    ProtoPirateApp* app = context;
+    widget_reset(app->widget);
+}
+#endif //ENABLE_RECEIVER_SCENE
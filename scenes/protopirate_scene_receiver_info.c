@@ -3,6 +3,7 @@
 #ifdef ENABLE_RECEIVER_SCENE
 
 #include "../helpers/protopirate_storage.h"
+#include "../protocols/protocol_items.h"
 
 #define TAG "ProtoPirateReceiverInfo"
 
@@ -50,27 +51,9 @@ void protopirate_scene_receiver_info_on_enter(void* context) {
     furi_string_reset(text);
     protopirate_history_get_text_item(app->txrx->history, text, app->txrx->idx_menu_chosen);
 
-    bool is_psa = false;
-    FlipperFormat* ff =
-        protopirate_history_get_raw_data(app->txrx->history, app->txrx->idx_menu_chosen);
-    if(ff) {
-        FuriString* protocol = furi_string_alloc();
-        flipper_format_rewind(ff);
-        if(flipper_format_read_string(ff, "Protocol", protocol)) {
-            if(furi_string_cmp_str(protocol, "PSA") == 0) {
-                is_psa = true;
-            }
-            if(furi_string_cmp_str(protocol, "Scher-Khan") == 0) {
-                is_emu_off = true;
-            } else if(furi_string_cmp_str(protocol, "Kia V5") == 0) {
-                is_emu_off = true;
-            } else if(furi_string_cmp_str(protocol, "Kia V6") == 0) {
-                is_emu_off = true;
-            } else {
-                is_emu_off = false;
-            }
-        }
-        furi_string_free(protocol);
+    ProtoPirateDecodeResult result;
+    if(protopirate_history_get_result(app->txrx->history, app->txrx->idx_menu_chosen, &result)) {
+        is_emu_off = !protopirate_protocol_can_emulate(result.protocol_id);
     }
 
     // Skip the first line (protocol name + Xbits) since it's already shown as the title
@@ -90,72 +73,8 @@ void protopirate_scene_receiver_info_on_enter(void* context) {
         }
     }
 
-    if(is_psa) {
-        FuriString* reformatted = furi_string_alloc();
-        const char* current = text_str;
-
-        while(*current) {
-            const char* line_end = strchr(current, '\r');
-            if(!line_end) {
-                line_end = strchr(current, '\n');
-            }
-            if(!line_end) {
-                line_end = current + strlen(current);
-            }
-
-            if(strncmp(current, "Ser:", 4) == 0) {
-                size_t ser_len = line_end - current;
-                furi_string_cat_printf(reformatted, "%.*s", (int)ser_len, current);
-
-                const char* next_line = line_end;
-                if(*next_line == '\r') next_line++;
-                if(*next_line == '\n') next_line++;
-
-                if(strncmp(next_line, "Cnt:", 4) == 0) {
-                    const char* cnt_end = strchr(next_line, '\r');
-                    if(!cnt_end) {
-                        cnt_end = strchr(next_line, '\n');
-                    }
-                    if(!cnt_end) {
-                        cnt_end = next_line + strlen(next_line);
-                    }
-
-                    size_t cnt_len = cnt_end - next_line;
-                    furi_string_cat_printf(reformatted, " %.*s\r\n", (int)cnt_len, next_line);
-
-                    current = cnt_end;
-                    if(*current == '\r') current++;
-                    if(*current == '\n') current++;
-                } else {
-                    furi_string_cat_printf(reformatted, "\r\n");
-                    current = line_end;
-                    if(*current == '\r') current++;
-                    if(*current == '\n') current++;
-                }
-            } else {
-                size_t line_len = line_end - current;
-                furi_string_cat_printf(reformatted, "%.*s\r\n", (int)line_len, current);
-                current = line_end;
-                if(*current == '\r') current++;
-                if(*current == '\n') current++;
-            }
-
-            if(*current == '\0') break;
-        }
-
-        widget_add_string_multiline_element(
-            app->widget,
-            0,
-            11,
-            AlignLeft,
-            AlignTop,
-            FontSecondary,
-            furi_string_get_cstr(reformatted));
-        furi_string_free(reformatted);
-    } else {
-        widget_add_string_multiline_element(
-            app->widget, 0, 11, AlignLeft, AlignTop, FontSecondary, text_str);
-    }
+    widget_add_string_multiline_element(
+        app->widget, 0, 11, AlignLeft, AlignTop, FontSecondary, text_str);
 
 #ifdef ENABLE_EMULATE_FEATURE
     // Add emulate button on the left
@@ -195,36 +114,11 @@ bool protopirate_scene_receiver_info_on_event(void* context, SceneManagerEvent e
             FuriString* filename_str = furi_string_alloc();
 
             if(ff) {
-                if(app->option_flags & FLAG_DATETIME_FILENAMES) {
-                    //Get the date and time to save.
-                    DateTime date_time;
-                    furi_hal_rtc_get_datetime(&date_time);
-
-                    furi_string_printf(
-                        filename_str,
-                        "%.2d%.2d%.2d_%.2d.%.2d.%.2d_",
-                        date_time.year,
-                        date_time.month,
-                        date_time.day,
-                        date_time.hour,
-                        date_time.minute,
-                        date_time.second);
-                }
-
-                // Extract protocol name
-                FuriString* protocol = furi_string_alloc();
-                flipper_format_rewind(ff);
-                if(!flipper_format_read_string(ff, "Protocol", protocol)) {
-                    furi_string_set_str(protocol, "Unknown");
-                }
-
-                //Add the protocol
-                furi_string_cat(filename_str, protocol);
-                furi_string_free(protocol);
-
-                // Clean protocol name for filename
-                furi_string_replace_all(filename_str, "/", "_");
-                furi_string_replace_all(filename_str, " ", "_");
+                ProtoPirateDecodeResult result;
+                protopirate_history_get_result(
+                    app->txrx->history, app->txrx->idx_menu_chosen, &result);
+                protopirate_storage_capture_name(
+                    &result, app->option_flags & FLAG_DATETIME_FILENAMES, filename_str);
 
                 FuriString* saved_path = furi_string_alloc();
                 if(protopirate_storage_save_capture(
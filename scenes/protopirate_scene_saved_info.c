@@ -48,6 +48,9 @@ void protopirate_scene_saved_info_on_enter(void* context) {
 
     FURI_LOG_I(TAG, "=== ENTER START ===");
 
+    // Preset names resolve through the registry built from setting
+    protopirate_app_wait_assets(app, AssetLoaderSetting);
+
     // Reset widget first
     widget_reset(app->widget);
 
@@ -134,7 +137,8 @@ void protopirate_scene_saved_info_on_enter(void* context) {
     flipper_format_rewind(ff);
     if(flipper_format_read_string(ff, "Preset", temp_str)) {
         // Convert full preset name to short name
-        const char* preset_name = preset_name_to_short(furi_string_get_cstr(temp_str));
+        const char* preset_name =
+            protopirate_preset_short_name(app, furi_string_get_cstr(temp_str));
         furi_string_cat_printf(info_str, "Modulation: %s\n", preset_name);
     }
 
@@ -20,6 +20,9 @@ typedef enum {
     SubmenuIndexProtoPirateReceiverConfig,
 #ifdef ENABLE_SUB_DECODE_SCENE
     SubmenuIndexProtoPirateSubDecode,
+    SubmenuIndexProtoPirateBatchDecode,
+    SubmenuIndexProtoPirateDecoderBench,
+    SubmenuIndexProtoPirateMemory,
 #endif
 #ifdef ENABLE_TIMING_TUNER_SCENE
     SubmenuIndexProtoPirateTimingTuner,
@@ -180,6 +183,24 @@ void protopirate_scene_start_on_enter(void* context) {
         SubmenuIndexProtoPirateSubDecode,
         protopirate_scene_start_submenu_callback,
         app);
+    submenu_add_item(
+        app->submenu,
+        "Batch Decode",
+        SubmenuIndexProtoPirateBatchDecode,
+        protopirate_scene_start_submenu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        "Decoder Bench",
+        SubmenuIndexProtoPirateDecoderBench,
+        protopirate_scene_start_submenu_callback,
+        app);
+    submenu_add_item(
+        app->submenu,
+        "Memory",
+        SubmenuIndexProtoPirateMemory,
+        protopirate_scene_start_submenu_callback,
+        app);
 #endif
 #ifdef ENABLE_TIMING_TUNER_SCENE
     submenu_add_item(
@@ -226,6 +247,15 @@ bool protopirate_scene_start_on_event(void* context, SceneManagerEvent event) {
         else if(event.event == SubmenuIndexProtoPirateSubDecode) {
             scene_manager_next_scene(app->scene_manager, ProtoPirateSceneSubDecode);
             consumed = true;
+        } else if(event.event == SubmenuIndexProtoPirateBatchDecode) {
+            scene_manager_next_scene(app->scene_manager, ProtoPirateSceneBatchDecode);
+            consumed = true;
+        } else if(event.event == SubmenuIndexProtoPirateDecoderBench) {
+            scene_manager_next_scene(app->scene_manager, ProtoPirateSceneDecoderBench);
+            consumed = true;
+        } else if(event.event == SubmenuIndexProtoPirateMemory) {
+            scene_manager_next_scene(app->scene_manager, ProtoPirateSceneMemory);
+            consumed = true;
         }
 #endif
 #ifdef ENABLE_TIMING_TUNER_SCENE
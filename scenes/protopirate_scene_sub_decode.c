@@ -4,12 +4,13 @@
 #include "../helpers/protopirate_storage.h"
 #include "../helpers/radio_device_loader.h"
 #include "../helpers/raw_file_reader.h"
+#include "../helpers/draw_tables.h"
 #include "../protopirate_history.h"
+#include "../protocols/protocol_items.h"
 #include "core/core_defines.h"
 #include "core/record.h"
 #include "storage/storage.h"
 #include <dialogs/dialogs.h>
-#include <math.h>
 #include <lib/subghz/types.h>
 
 #ifdef BUILD_MAIN_APP
@@ -65,10 +66,15 @@ typedef struct {
 
     ProtoPirateHistory* history;
     uint16_t match_count;
+    // Count the animation shows, refreshed at most once per frame
+    uint16_t shown_matches;
+    EventCoalescer match_updates;
     uint16_t selected_history_index;
     bool showing_signal_info;
 
+    // Points at reader_slot while a RAW file is being decoded
     RawFileReader* raw_reader;
+    RawFileReader* reader_slot;
 } SubDecodeContext;
 
 static SubDecodeContext* g_decode_ctx = NULL;
@@ -99,25 +105,49 @@ static void protopirate_sub_decode_receiver_callback(
     FURI_LOG_I(TAG, "=== SIGNAL DECODED FROM FILE ===");
 
     // Add to history
-    if(protopirate_history_add_to_history(ctx->history, decoder_base, app->txrx->preset)) {
+    ProtoPirateDecodeResult result;
+    protopirate_decoder_get_result(decoder_base, &result);
+    if(protopirate_history_add_to_history(
+           ctx->history, decoder_base, app->txrx->preset, &result)) {
         ctx->match_count++;
         FURI_LOG_I(TAG, "Added signal %u to history", ctx->match_count);
 
-        // Send update event to refresh animation
-        view_dispatcher_send_custom_event(
-            app->view_dispatcher, ProtoPirateCustomEventSubDecodeUpdate);
+        // A file full of matches would otherwise queue an event per match
+        if(event_coalescer_post(&ctx->match_updates, ctx->match_count, furi_get_tick())) {
+            view_dispatcher_send_custom_event(
+                app->view_dispatcher, ProtoPirateCustomEventSubDecodeUpdate);
+        }
     }
 
     // Reset receiver to continue looking for more signals
     subghz_receiver_reset(receiver);
 }
 
-// Draw the decoding animation
-static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
-    UNUSED(context);
-    SubDecodeContext* ctx = g_decode_ctx;
-    if(!ctx) return;
+// One step of the waveform phases in 1/256 turns, Q8: 0.12 and 0.08 rad
+#define DECODE_WAVE_STEP_Q8  1252
+#define DECODE_WAVE2_STEP_Q8 834
+
+// Diagonal stroke, steps pixels from (x, y) along (dx, dy), drawn three wide
+// by repeating it shifted by ox across and by oy down
+static void protopirate_decode_draw_stroke(
+    Canvas* canvas,
+    int x,
+    int y,
+    int steps,
+    int dx,
+    int dy,
+    int ox,
+    int oy) {
+    if(steps <= 0) return;
+    int x_end = x + dx * (steps - 1);
+    int y_end = y + dy * (steps - 1);
+    canvas_draw_line(canvas, x, y, x_end, y_end);
+    canvas_draw_line(canvas, x + ox, y, x_end + ox, y_end);
+    canvas_draw_line(canvas, x, y + oy, x_end, y_end + oy);
+}
 
+// Draw the decoding animation
+static void protopirate_decode_draw(Canvas* canvas, SubDecodeContext* ctx, bool lean) {
     canvas_clear(canvas);
 
     if(ctx->state == DecodeStateIdle || ctx->state == DecodeStateDone) {
@@ -141,32 +171,26 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
         // First stroke of check (going down-right from left)
         int stroke1_max = size;
         int stroke1_len = (check_progress > stroke1_max) ? stroke1_max : check_progress;
-        for(int i = 0; i <= stroke1_len; i++) {
-            canvas_draw_dot(canvas, cx - size + i, cy - size / 2 + i);
-            canvas_draw_dot(canvas, cx - size + i, cy - size / 2 + i + 1);
-            canvas_draw_dot(canvas, cx - size + i + 1, cy - size / 2 + i);
-        }
+        protopirate_decode_draw_stroke(
+            canvas, cx - size, cy - size / 2, stroke1_len + 1, 1, 1, 1, 1);
 
         // Second stroke of check (going up-right)
         if(check_progress > stroke1_max) {
             int stroke2_max = size * 2;
             int stroke2_len = check_progress - stroke1_max;
             if(stroke2_len > stroke2_max) stroke2_len = stroke2_max;
-            for(int i = 0; i <= stroke2_len; i++) {
-                canvas_draw_dot(canvas, cx + i, cy + size / 2 - i);
-                canvas_draw_dot(canvas, cx + i, cy + size / 2 - i - 1);
-                canvas_draw_dot(canvas, cx + i + 1, cy + size / 2 - i);
-            }
+            protopirate_decode_draw_stroke(
+                canvas, cx, cy + size / 2, stroke2_len + 1, 1, -1, 1, -1);
         }
 
-        // Radiating dots
+        // Radiating dots, twelve to a ring
         for(int r = 0; r < 3; r++) {
             int radius = ((frame * 2 + r * 12) % 35) + 8;
             if(radius < 30) {
                 for(int angle = 0; angle < 12; angle++) {
-                    float a = (float)angle * 3.14159f * 2.0f / 12.0f;
-                    int x = cx + (int)(radius * cosf(a));
-                    int y = cy + (int)(radius * sinf(a));
+                    uint8_t a = angle * 64 / 3;
+                    int x = draw_polar_x(cx, radius, a);
+                    int y = draw_polar_y(cy, radius, a);
                     if(x >= 0 && x < 128 && y >= 0 && y < 64) {
                         canvas_draw_dot(canvas, x, y);
                     }
@@ -192,29 +216,18 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
 
         // First stroke: top-left to bottom-right
         int stroke1_len = (x_progress > stroke_len) ? stroke_len : x_progress;
-        for(int i = 0; i < stroke1_len; i++) {
-            int x = cx - size + i;
-            int y = cy - size + i;
-            canvas_draw_dot(canvas, x, y);
-            canvas_draw_dot(canvas, x + 1, y);
-            canvas_draw_dot(canvas, x, y + 1);
-        }
+        protopirate_decode_draw_stroke(canvas, cx - size, cy - size, stroke1_len, 1, 1, 1, 1);
 
         // Second stroke: top-right to bottom-left
         if(x_progress > stroke_len) {
             int stroke2_progress = x_progress - stroke_len;
             int stroke2_len = (stroke2_progress > stroke_len) ? stroke_len : stroke2_progress;
-            for(int i = 0; i < stroke2_len; i++) {
-                int x = cx + size - i;
-                int y = cy - size + i;
-                canvas_draw_dot(canvas, x, y);
-                canvas_draw_dot(canvas, x - 1, y);
-                canvas_draw_dot(canvas, x, y + 1);
-            }
+            protopirate_decode_draw_stroke(
+                canvas, cx + size, cy - size, stroke2_len, -1, 1, -1, 1);
         }
 
         // Static noise effect around the edges
-        for(int i = 0; i < 30; i++) {
+        for(int i = 0; i < 30 && !lean; i++) {
             int x = ((frame * 7 + i * 17) * 31) % 128;
             int y = ((frame * 13 + i * 23) * 17) % 64;
             canvas_draw_dot(canvas, x, y);
@@ -238,14 +251,16 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
     int glitch = (frame % 47 == 0) ? 1 : 0;
     canvas_draw_str_aligned(canvas, 64 + glitch, 0, AlignCenter, AlignTop, "Decoding");
 
-    // Waveform visualization - original style with sinf
+    // Waveform visualization, two sines off the table
     int wave_y = 22;
     int wave_height = 14;
 
     for(int x = 0; x < 128; x++) {
-        float phase = (float)(x + frame * 4) * 0.12f;
-        float phase2 = (float)(x - frame * 2) * 0.08f;
-        int y_offset = (int)(sinf(phase) * wave_height / 2 + sinf(phase2) * wave_height / 4);
+        uint8_t phase = (uint32_t)(x + frame * 4) * DECODE_WAVE_STEP_Q8 >> 8;
+        uint8_t phase2 = (int32_t)(x - frame * 2) * DECODE_WAVE2_STEP_Q8 >> 8;
+        int y_offset =
+            (draw_sin(phase) * wave_height / 2 + draw_sin(phase2) * wave_height / 4) /
+            DRAW_TRIG_ONE;
 
         // Add some noise variation
         if((x * 7 + frame) % 13 == 0) {
@@ -255,23 +270,22 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
         canvas_draw_dot(canvas, x, wave_y + y_offset);
 
         // Thicker line
-        if((x + frame) % 3 != 0) {
+        if(!lean && (x + frame) % 3 != 0) {
             canvas_draw_dot(canvas, x, wave_y + y_offset + 1);
         }
     }
 
-    // Scanning beam effect
+    // Scanning beam effect, three columns wide
     int scan_x = (frame * 5) % 148 - 10;
-    for(int dx = 0; dx < 8; dx++) {
-        int sx = scan_x + dx;
-        if(sx >= 0 && sx < 128) {
-            int intensity = 8 - dx;
-            for(int y = wave_y - wave_height / 2 - 1; y <= wave_y + wave_height / 2 + 1; y++) {
-                if(dx < intensity / 2) {
-                    canvas_draw_dot(canvas, sx, y);
-                }
-            }
-        }
+    int beam_left = MAX(scan_x, 0);
+    int beam_right = MIN(scan_x + 3, 128);
+    if(!lean && beam_right > beam_left) {
+        canvas_draw_box(
+            canvas,
+            beam_left,
+            wave_y - wave_height / 2 - 1,
+            beam_right - beam_left,
+            wave_height + 3);
     }
 
     // Progress bar frame
@@ -290,14 +304,17 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
     }
     if(progress > 100) progress = 100;
 
-    // Animated progress fill with diagonal stripes
+    // Animated progress fill with diagonal stripes, a sprite per 8 pixels
     int fill_width = (progress * 108) / 100;
-    for(int x = 0; x < fill_width; x++) {
-        for(int y = 0; y < 6; y++) {
-            if(((x - (int)frame + y) & 3) < 2) {
-                canvas_draw_dot(canvas, 10 + x, progress_y + 2 + y);
-            }
-        }
+    const uint8_t* stripe = draw_stripe_sprites[frame & (DRAW_STRIPE_PHASES - 1)];
+    for(int x = 0; x < fill_width; x += DRAW_STRIPE_WIDTH) {
+        canvas_draw_xbm(
+            canvas,
+            10 + x,
+            progress_y + 2,
+            MIN(DRAW_STRIPE_WIDTH, fill_width - x),
+            DRAW_STRIPE_HEIGHT,
+            stripe);
     }
 
     // Status text
@@ -316,13 +333,13 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
         break;
     case DecodeStateDecodingRaw: {
         static char match_text[32];
-        if(ctx->match_count > 0) {
+        if(ctx->shown_matches > 0) {
             snprintf(
                 match_text,
                 sizeof(match_text),
                 "%u  match%s",
-                ctx->match_count,
-                ctx->match_count > 1 ? "es" : "");
+                ctx->shown_matches,
+                ctx->shown_matches > 1 ? "es" : "");
             status_text = match_text;
         } else {
             status_text = "Decoding signal...";
@@ -355,6 +372,16 @@ static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
     canvas_draw_str(canvas, 123, 62, spinner);
 }
 
+static void protopirate_decode_draw_callback(Canvas* canvas, void* context) {
+    UNUSED(context);
+    SubDecodeContext* ctx = g_decode_ctx;
+    if(!ctx) return;
+
+    uint32_t frame_start = protopirate_frame_begin();
+    protopirate_decode_draw(canvas, ctx, protopirate_frame_lean(ProtoPirateFrameSubDecode));
+    protopirate_frame_end(ProtoPirateFrameSubDecode, frame_start);
+}
+
 static bool protopirate_decode_input_callback(InputEvent* event, void* context) {
     UNUSED(context);
 
@@ -362,7 +389,7 @@ static bool protopirate_decode_input_callback(InputEvent* event, void* context)
         if(g_decode_ctx && g_decode_ctx->state != DecodeStateIdle &&
            g_decode_ctx->state != DecodeStateDone) {
             if(g_decode_ctx->raw_reader) {
-                raw_file_reader_free(g_decode_ctx->raw_reader);
+                raw_file_reader_deinit(g_decode_ctx->raw_reader);
                 g_decode_ctx->raw_reader = NULL;
             }
 
@@ -378,6 +405,7 @@ static bool protopirate_decode_input_callback(InputEvent* event, void* context)
 }
 
 static void close_file_handles(SubDecodeContext* ctx) {
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapStorage);
     if(ctx->ff) {
         flipper_format_free(ctx->ff);
         ctx->ff = NULL;
@@ -386,6 +414,7 @@ static void close_file_handles(SubDecodeContext* ctx) {
         furi_record_close(RECORD_STORAGE);
         ctx->storage = NULL;
     }
+    protopirate_heap_settle(ProtoPirateHeapStorage, heap_mark);
 }
 
 // Receiver view callback for history navigation
@@ -413,35 +442,40 @@ static void protopirate_scene_sub_decode_widget_callback(
 
 void protopirate_scene_sub_decode_on_enter(void* context) {
     ProtoPirateApp* app = context;
+    protopirate_app_wait_assets(app, AssetLoaderAll);
 
-    FURI_LOG_I(TAG, "Sub decode scene enter - Free heap: %zu", memmgr_get_free_heap());
+    FURI_LOG_I(TAG, "Sub decode scene enter");
 
-    g_decode_ctx = malloc(sizeof(SubDecodeContext));
-    if(!g_decode_ctx) {
+    // Context and RAW reader in one block, released together on exit
+    if(!scene_arena_reserve(
+           &app->scene_arena,
+           SCENE_ARENA_SIZE_OF(SubDecodeContext) + SCENE_ARENA_SIZE_OF(RawFileReader))) {
         FURI_LOG_E(TAG, "Failed to allocate decode context");
         scene_manager_previous_scene(app->scene_manager);
         return;
     }
-    memset(g_decode_ctx, 0, sizeof(SubDecodeContext));
-
-    FURI_LOG_I(TAG, "After decode context alloc - Free heap: %zu", memmgr_get_free_heap());
+    g_decode_ctx = scene_arena_alloc(&app->scene_arena, sizeof(SubDecodeContext));
+    g_decode_ctx->reader_slot = scene_arena_alloc(&app->scene_arena, sizeof(RawFileReader));
 
     // Allocate history
     if(!app->txrx->history) {
         app->txrx->history = protopirate_history_alloc();
         if(!app->txrx->history) {
             FURI_LOG_E(TAG, "Failed to allocate history!");
-            free(g_decode_ctx);
+            scene_arena_release(&app->scene_arena);
             g_decode_ctx = NULL;
             return;
         }
     }
 
+    // The context's strings live as long as its arena block, so charge them there
+    int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapSceneArena);
     g_decode_ctx->file_path = furi_string_alloc();
     g_decode_ctx->protocol_name = furi_string_alloc();
     g_decode_ctx->result = furi_string_alloc();
     g_decode_ctx->error_info = furi_string_alloc();
     g_decode_ctx->decoded_string = furi_string_alloc();
+    protopirate_heap_settle(ProtoPirateHeapSceneArena, heap_mark);
     g_decode_ctx->state = DecodeStateIdle;
     g_decode_ctx->can_save = false;
     g_decode_ctx->save_data = NULL;
@@ -449,13 +483,13 @@ void protopirate_scene_sub_decode_on_enter(void* context) {
     g_decode_ctx->history = app->txrx->history;
     //protopirate_history_reset(g_decode_ctx->history);
     g_decode_ctx->match_count = 0;
+    g_decode_ctx->shown_matches = 0;
+    event_coalescer_init(&g_decode_ctx->match_updates, EVENT_COALESCER_FRAME_MS);
     g_decode_ctx->selected_history_index = 0;
     g_decode_ctx->raw_reader = NULL;
 
     protopirate_view_receiver_set_sub_decode_mode(app->protopirate_receiver, true);
 
-    FURI_LOG_I(TAG, "After context setup - Free heap: %zu", memmgr_get_free_heap());
-
     DialogsFileBrowserOptions browser_options;
     dialog_file_browser_set_basic_options(&browser_options, ".sub", &I_subghz_10px);
     browser_options.base_path = SUBGHZ_APP_FOLDER;
@@ -492,7 +526,11 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
         if(event.event == ProtoPirateCustomEventSubDecodeUpdate) {
             // Update receiver view with new history items (when signals are detected during decoding)
             if(ctx->state == DecodeStateDecodingRaw) {
-                // History is updated in callback, just refresh animation
+                // History is updated in callback, the animation tick draws the count
+                uint32_t matches;
+                if(event_coalescer_take(&ctx->match_updates, furi_get_tick(), &matches)) {
+                    ctx->shown_matches = matches;
+                }
                 consumed = true;
             } else if(
                 ctx->state == DecodeStateShowHistory ||
@@ -501,14 +539,12 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
                 uint16_t history_count = protopirate_history_get_item(ctx->history);
                 if(history_count > 0) {
                     protopirate_view_receiver_reset_menu(app->protopirate_receiver);
-
-                    FuriString* item_text = furi_string_alloc();
-                    for(uint16_t i = 0; i < history_count; i++) {
-                        protopirate_history_get_text_item_menu(ctx->history, item_text, i);
-                        protopirate_view_receiver_add_item_to_menu(
-                            app->protopirate_receiver, furi_string_get_cstr(item_text), 0);
-                    }
-                    furi_string_free(item_text);
+                    protopirate_view_receiver_set_item_source(
+                        app->protopirate_receiver,
+                        protopirate_history_menu_item_callback,
+                        ctx->history);
+                    protopirate_view_receiver_set_item_count(
+                        app->protopirate_receiver, history_count);
 
                     protopirate_view_receiver_set_idx_menu(
                         app->protopirate_receiver, ctx->selected_history_index);
@@ -627,11 +663,13 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
 
         switch(ctx->state) {
         case DecodeStateOpenFile: {
-            FURI_LOG_I(TAG, "OpenFile: Starting - Free heap: %zu", memmgr_get_free_heap());
+            FURI_LOG_I(TAG, "OpenFile: Starting");
+            int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapStorage);
             ctx->storage = furi_record_open(RECORD_STORAGE);
             FURI_LOG_D(TAG, "OpenFile: Storage opened");
             ctx->ff = flipper_format_file_alloc(ctx->storage);
             FURI_LOG_D(TAG, "OpenFile: FlipperFormat allocated");
+            protopirate_heap_settle(ProtoPirateHeapStorage, heap_mark);
 
             if(!flipper_format_file_open_existing(ctx->ff, furi_string_get_cstr(ctx->file_path))) {
                 FURI_LOG_E(TAG, "OpenFile: Failed to open file");
@@ -649,7 +687,7 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
         }
 
         case DecodeStateReadHeader: {
-            FURI_LOG_I(TAG, "ReadHeader: Starting - Free heap: %zu", memmgr_get_free_heap());
+            FURI_LOG_I(TAG, "ReadHeader: Starting");
 
             FuriString* temp_str = furi_string_alloc();
             uint32_t version = 0;
@@ -712,10 +750,7 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
                 FURI_LOG_D(TAG, "ReadHeader: Receiver callback set");
 
                 ctx->state = DecodeStateStartingWorker;
-                FURI_LOG_I(
-                    TAG,
-                    "ReadHeader: State set to StartingWorker - Free heap: %zu",
-                    memmgr_get_free_heap());
+                FURI_LOG_I(TAG, "ReadHeader: State set to StartingWorker");
             } else {
                 FURI_LOG_W(TAG, "ReadHeader: Non-RAW protocol not supported");
                 close_file_handles(ctx);
@@ -729,11 +764,7 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
         }
 
         case DecodeStateStartingWorker: {
-            FURI_LOG_I(
-                TAG,
-                "StartingWorker: Entry - delay=%d, Free heap: %zu",
-                ctx->worker_startup_delay,
-                memmgr_get_free_heap());
+            FURI_LOG_I(TAG, "StartingWorker: Entry - delay=%d", ctx->worker_startup_delay);
 
             if(ctx->worker_startup_delay < 3) {
                 ctx->worker_startup_delay++;
@@ -787,47 +818,19 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
                     break;
                 }
 
-                const char* preset_name_long = furi_string_get_cstr(temp_str);
-                const char* preset_name_short = preset_name_long;
-
-                if(!strcmp(preset_name_long, "FuriHalSubGhzPresetOok270Async")) {
-                    preset_name_short = "AM270";
-                } else if(!strcmp(preset_name_long, "FuriHalSubGhzPresetOok650Async")) {
-                    preset_name_short = "AM650";
-                } else if(!strcmp(preset_name_long, "FuriHalSubGhzPreset2FSKDev238Async")) {
-                    preset_name_short = "FM238";
-                } else if(!strcmp(preset_name_long, "FuriHalSubGhzPreset2FSKDev12KAsync")) {
-                    preset_name_short = "FM12K";
-                } else if(!strcmp(preset_name_long, "FuriHalSubGhzPreset2FSKDev476Async")) {
-                    preset_name_short = "FM476";
-                } else if(!strcmp(preset_name_long, "FuriHalSubGhzPresetCustom")) {
-                    preset_name_short = "CUSTOM";
-                }
-
-                size_t preset_index = subghz_setting_get_preset_count(app->setting);
-                for(size_t i = 0; i < subghz_setting_get_preset_count(app->setting); i++) {
-                    if(!strcmp(
-                           subghz_setting_get_preset_name(app->setting, i), preset_name_short)) {
-                        preset_index = i;
-                        break;
-                    }
-                }
-                if(preset_index >= subghz_setting_get_preset_count(app->setting)) {
-                    preset_name_short = "AM650";
-                    for(size_t i = 0; i < subghz_setting_get_preset_count(app->setting); i++) {
-                        if(!strcmp(
-                               subghz_setting_get_preset_name(app->setting, i),
-                               preset_name_short)) {
-                            preset_index = i;
-                            break;
-                        }
-                    }
-                    if(preset_index >= subghz_setting_get_preset_count(app->setting)) {
+                // Long or short name alike; custom presets fall back to AM650
+                uint8_t preset_index =
+                    preset_registry_find(&app->presets, furi_string_get_cstr(temp_str));
+                if(!preset_registry_is_valid(&app->presets, preset_index)) {
+                    preset_index = preset_registry_find(&app->presets, "AM650");
+                    if(!preset_registry_is_valid(&app->presets, preset_index)) {
                         FURI_LOG_E(TAG, "Failed to get preset index!");
                         break;
                     }
                 }
 
+                const char* preset_name_short =
+                    subghz_setting_get_preset_name(app->setting, preset_index);
                 uint8_t* preset_data = subghz_setting_get_preset_data(app->setting, preset_index);
                 size_t preset_data_size =
                     subghz_setting_get_preset_data_size(app->setting, preset_index);
@@ -858,28 +861,15 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
                 break;
             }
 
-            FURI_LOG_I(
-                TAG,
-                "StartingWorker: Allocating raw reader - Free heap: %zu",
-                memmgr_get_free_heap());
-
-            ctx->raw_reader = raw_file_reader_alloc();
-            if(!ctx->raw_reader) {
-                FURI_LOG_E(TAG, "Failed to allocate raw reader");
-                furi_string_set(ctx->result, "Memory allocation failed");
-                furi_string_set(ctx->error_info, "Out of memory");
-                ctx->state = DecodeStateShowFailure;
-                ctx->result_display_counter = 0;
-                notification_message(app->notifications, &sequence_error);
-                break;
-            }
+            // The reader charges its own buffers to the RAW reader account
+            ctx->raw_reader = ctx->reader_slot;
+            raw_file_reader_init(ctx->raw_reader);
 
-            FURI_LOG_I(
-                TAG, "StartingWorker: Opening raw file - Free heap: %zu", memmgr_get_free_heap());
+            FURI_LOG_I(TAG, "StartingWorker: Opening raw file");
 
             if(!raw_file_reader_open(ctx->raw_reader, furi_string_get_cstr(ctx->file_path))) {
                 FURI_LOG_E(TAG, "Failed to open raw file");
-                raw_file_reader_free(ctx->raw_reader);
+                raw_file_reader_deinit(ctx->raw_reader);
                 ctx->raw_reader = NULL;
                 furi_string_set(ctx->result, "Failed to open RAW file");
                 furi_string_set(ctx->error_info, "File open failed");
@@ -890,8 +880,7 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
             }
 
             ctx->state = DecodeStateDecodingRaw;
-            FURI_LOG_I(
-                TAG, "StartingWorker: Ready to decode - Free heap: %zu", memmgr_get_free_heap());
+            FURI_LOG_I(TAG, "StartingWorker: Ready to decode");
             break;
         }
 
@@ -903,47 +892,55 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
                 break;
             }
 
-            bool level = false;
-            uint32_t duration = 0;
-            uint32_t samples_processed = 0;
-
-            while(samples_processed < SAMPLES_TO_READ_PER_TICK) {
-                if(!raw_file_reader_get_next(ctx->raw_reader, &level, &duration)) {
-                    FURI_LOG_I(TAG, "DecodingRaw: File finished, matches=%u", ctx->match_count);
-
-                    raw_file_reader_free(ctx->raw_reader);
-                    ctx->raw_reader = NULL;
-
-                    subghz_receiver_set_rx_callback(app->txrx->receiver, NULL, NULL);
-
-                    uint16_t history_count = protopirate_history_get_item(ctx->history);
-
-                    if(history_count > 0) {
-                        ctx->state = DecodeStateShowSuccess;
-                        ctx->selected_history_index = 0;
-                        ctx->showing_signal_info = false;
-                        ctx->result_display_counter = 0;
-                        notification_message(app->notifications, &sequence_success);
-                    } else {
-                        furi_string_printf(
-                            ctx->result,
-                            "RAW Signal\n\n"
-                            "Freq: %lu.%02lu MHz\n\n"
-                            "No ProtoPirate protocol\n"
-                            "detected in signal.",
-                            ctx->frequency / 1000000,
-                            (ctx->frequency % 1000000) / 10000);
-                        furi_string_set(ctx->error_info, "No protocol match");
-                        ctx->state = DecodeStateShowFailure;
-                        ctx->result_display_counter = 0;
-                        notification_message(app->notifications, &sequence_error);
-                    }
-                    break;
+            const LevelDuration* samples;
+            size_t count =
+                raw_file_reader_get_span(ctx->raw_reader, SAMPLES_TO_READ_PER_TICK, &samples);
+
+            if(!count) {
+                FURI_LOG_I(TAG, "DecodingRaw: File finished, matches=%u", ctx->match_count);
+
+                raw_file_reader_deinit(ctx->raw_reader);
+                ctx->raw_reader = NULL;
+
+                subghz_receiver_set_rx_callback(app->txrx->receiver, NULL, NULL);
+
+                uint16_t history_count = protopirate_history_get_item(ctx->history);
+
+                if(history_count > 0) {
+                    ctx->state = DecodeStateShowSuccess;
+                    ctx->selected_history_index = 0;
+                    ctx->showing_signal_info = false;
+                    ctx->result_display_counter = 0;
+                    notification_message(app->notifications, &sequence_success);
+                } else {
+                    furi_string_printf(
+                        ctx->result,
+                        "RAW Signal\n\n"
+                        "Freq: %lu.%02lu MHz\n\n"
+                        "No ProtoPirate protocol\n"
+                        "detected in signal.",
+                        ctx->frequency / 1000000,
+                        (ctx->frequency % 1000000) / 10000);
+                    furi_string_set(ctx->error_info, "No protocol match");
+                    ctx->state = DecodeStateShowFailure;
+                    ctx->result_display_counter = 0;
+                    notification_message(app->notifications, &sequence_error);
                 }
-                furi_thread_yield();
-                subghz_receiver_decode(app->txrx->receiver, level, duration);
-                samples_processed++;
+                break;
             }
+
+            for(size_t i = 0; i < count; i++) {
+                subghz_receiver_decode(
+                    app->txrx->receiver,
+                    level_duration_get_level(samples[i]),
+                    level_duration_get_duration(samples[i]));
+            }
+            // Matches merged since the last refresh
+            if(event_coalescer_flush(&ctx->match_updates)) {
+                view_dispatcher_send_custom_event(
+                    app->view_dispatcher, ProtoPirateCustomEventSubDecodeUpdate);
+            }
+            furi_thread_yield();
             break;
         }
 
@@ -996,14 +993,11 @@ bool protopirate_scene_sub_decode_on_event(void* context, SceneManagerEvent even
             if(history_count > 0) {
                 // Reset and populate receiver view menu
                 protopirate_view_receiver_reset_menu(app->protopirate_receiver);
-
-                FuriString* item_text = furi_string_alloc();
-                for(uint16_t i = 0; i < history_count; i++) {
-                    protopirate_history_get_text_item_menu(ctx->history, item_text, i);
-                    protopirate_view_receiver_add_item_to_menu(
-                        app->protopirate_receiver, furi_string_get_cstr(item_text), 0);
-                }
-                furi_string_free(item_text);
+                protopirate_view_receiver_set_item_source(
+                    app->protopirate_receiver,
+                    protopirate_history_menu_item_callback,
+                    ctx->history);
+                protopirate_view_receiver_set_item_count(app->protopirate_receiver, history_count);
 
                 // Set initial selection
                 protopirate_view_receiver_set_idx_menu(
@@ -1132,7 +1126,7 @@ void protopirate_scene_sub_decode_on_exit(void* context) {
 
     if(g_decode_ctx) {
         if(g_decode_ctx->raw_reader) {
-            raw_file_reader_free(g_decode_ctx->raw_reader);
+            raw_file_reader_deinit(g_decode_ctx->raw_reader);
             g_decode_ctx->raw_reader = NULL;
         }
 
@@ -1142,13 +1136,15 @@ void protopirate_scene_sub_decode_on_exit(void* context) {
             flipper_format_free(g_decode_ctx->save_data);
         }
 
+        int32_t heap_mark = protopirate_heap_mark(ProtoPirateHeapSceneArena);
         furi_string_free(g_decode_ctx->file_path);
         furi_string_free(g_decode_ctx->protocol_name);
         furi_string_free(g_decode_ctx->result);
         furi_string_free(g_decode_ctx->error_info);
         furi_string_free(g_decode_ctx->decoded_string);
-        free(g_decode_ctx);
+        protopirate_heap_settle(ProtoPirateHeapSceneArena, heap_mark);
         g_decode_ctx = NULL;
+        scene_arena_release(&app->scene_arena);
     }
 
     if(app->txrx->history) {
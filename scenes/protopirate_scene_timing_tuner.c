@@ -2,8 +2,8 @@
 #include "../protopirate_app_i.h"
 #ifdef ENABLE_TIMING_TUNER_SCENE
 #include "../protocols/protocol_items.h"
+#include "../helpers/draw_tables.h"
 #include <gui/elements.h>
-#include <math.h>
 
 #define TAG "ProtoPirateTimingTuner"
 
@@ -34,6 +34,7 @@ typedef struct {
     // Protocol match info
     const char* matched_protocol;
     const ProtoPirateProtocolTiming* timing_info;
+    ProtoPirateDecodeResult result;
 
     // State
     bool is_receiving;
@@ -79,9 +80,9 @@ static void calculate_timing_stats(TimingTunerContext* ctx) {
     int32_t max_valid;
 
     if(ctx->timing_info) {
-        int32_t te_short = (int32_t)ctx->timing_info->te_short;
-        int32_t te_long = (int32_t)ctx->timing_info->te_long;
-        int32_t te_delta = (int32_t)ctx->timing_info->te_delta;
+        int32_t te_short = (int32_t)ctx->timing_info->timing->te_short;
+        int32_t te_long = (int32_t)ctx->timing_info->timing->te_long;
+        int32_t te_delta = (int32_t)ctx->timing_info->timing->te_delta;
 
         // Threshold halfway between expected short and long
         threshold = (te_short + te_long) / 2;
@@ -164,14 +165,14 @@ static void calculate_timing_stats(TimingTunerContext* ctx) {
 
     if(ctx->timing_info && ctx->short_count > 0 && ctx->long_count > 0) {
 #ifndef REMOVE_LOGS
-        int32_t short_diff = ctx->avg_short - (int32_t)ctx->timing_info->te_short;
-        int32_t long_diff = ctx->avg_long - (int32_t)ctx->timing_info->te_long;
+        int32_t short_diff = ctx->avg_short - (int32_t)ctx->timing_info->timing->te_short;
+        int32_t long_diff = ctx->avg_long - (int32_t)ctx->timing_info->timing->te_long;
         FURI_LOG_I(
             TAG,
             "DIFFERENCE: short=%+ld long=%+ld (tolerance +/-%lu)",
             short_diff,
             long_diff,
-            ctx->timing_info->te_delta);
+            (uint32_t)ctx->timing_info->timing->te_delta);
 #endif
     }
 }
@@ -186,8 +187,9 @@ static void timing_tuner_draw_listening(Canvas* canvas, TimingTunerContext* ctx)
     int wave_y = 38;
     ctx->animation_frame++;
     for(int x = 0; x < 128; x++) {
-        float phase = (float)(x + ctx->animation_frame * 3) * 0.15f;
-        int y_offset = (int)(sinf(phase) * 8.0f);
+        // 0.15 rad per pixel, in 1/256 turns Q8
+        uint8_t phase = (uint32_t)(x + ctx->animation_frame * 3) * 1565 >> 8;
+        int y_offset = draw_sin(phase) * 8 / DRAW_TRIG_ONE;
         canvas_draw_dot(canvas, x, wave_y + y_offset);
     }
 
@@ -225,11 +227,12 @@ static bool
     int32_t long_jitter = 0;
 
     if(ctx->timing_info) {
-        short_diff = ctx->avg_short - (int32_t)ctx->timing_info->te_short;
-        long_diff = ctx->avg_long - (int32_t)ctx->timing_info->te_long;
+        short_diff = ctx->avg_short - (int32_t)ctx->timing_info->timing->te_short;
+        long_diff = ctx->avg_long - (int32_t)ctx->timing_info->timing->te_long;
         short_ok = (ctx->short_count > 0) &&
-                   (abs(short_diff) <= (int32_t)ctx->timing_info->te_delta);
-        long_ok = (ctx->long_count > 0) && (abs(long_diff) <= (int32_t)ctx->timing_info->te_delta);
+                   (abs(short_diff) <= (int32_t)ctx->timing_info->timing->te_delta);
+        long_ok = (ctx->long_count > 0) &&
+                  (abs(long_diff) <= (int32_t)ctx->timing_info->timing->te_delta);
         short_exact = (abs(short_diff) <= 15);
         long_exact = (abs(long_diff) <= 15);
     }
@@ -242,13 +245,19 @@ static bool
             snprintf(buf, buf_size, "PROTOCOL DEFINITION:");
             return true;
         case 1:
-            snprintf(buf, buf_size, "  Short: %lu us", ctx->timing_info->te_short);
+            snprintf(
+                buf, buf_size, "  Short: %lu us", (uint32_t)ctx->timing_info->timing->te_short);
             return true;
         case 2:
-            snprintf(buf, buf_size, "  Long: %lu us", ctx->timing_info->te_long);
+            snprintf(
+                buf, buf_size, "  Long: %lu us", (uint32_t)ctx->timing_info->timing->te_long);
             return true;
         case 3:
-            snprintf(buf, buf_size, "  Tolerance: +/-%lu us", ctx->timing_info->te_delta);
+            snprintf(
+                buf,
+                buf_size,
+                "  Tolerance: +/-%lu us",
+                (uint32_t)ctx->timing_info->timing->te_delta);
             return true;
         case 4:
             buf[0] = '\0';
@@ -362,6 +371,28 @@ static bool
             buf[0] = '\0';
             return true;
         case 29:
+            snprintf(buf, buf_size, "DECODED:");
+            return true;
+        case 30:
+            snprintf(
+                buf,
+                buf_size,
+                "  Sn:%lX Btn:%X",
+                (uint32_t)ctx->result.serial,
+                ctx->result.btn);
+            return true;
+        case 31:
+            snprintf(
+                buf,
+                buf_size,
+                "  Cnt:%lX CRC:%s",
+                (uint32_t)ctx->result.cnt,
+                ctx->result.crc_valid ? "OK" : "--");
+            return true;
+        case 32:
+            buf[0] = '\0';
+            return true;
+        case 33:
             snprintf(buf, buf_size, "OK:Retry  <:Config");
             return true;
         default:
@@ -432,7 +463,7 @@ static bool
 
 static uint8_t count_result_lines(TimingTunerContext* ctx) {
     if(ctx->timing_info) {
-        return 30; // Lines 0-29
+        return 34; // Lines 0-33
     } else {
         return 18; // Lines 0-17
     }
@@ -483,6 +514,7 @@ static void timing_tuner_draw_callback(Canvas* canvas, void* context) {
     TimingTunerContext* ctx = g_timing_ctx;
     if(!ctx) return;
 
+    uint32_t frame_start = protopirate_frame_begin();
     canvas_clear(canvas);
     canvas_set_color(canvas, ColorBlack);
 
@@ -491,6 +523,7 @@ static void timing_tuner_draw_callback(Canvas* canvas, void* context) {
     } else {
         timing_tuner_draw_results(canvas, ctx);
     }
+    protopirate_frame_end(ProtoPirateFrameTimingTuner, frame_start);
 }
 
 static bool timing_tuner_input_callback(InputEvent* event, void* context) {
@@ -563,16 +596,21 @@ static void timing_tuner_rx_callback(
 
     FURI_LOG_I(TAG, "Matched protocol: %s", protocol_name);
 
-    ctx->timing_info = protopirate_get_protocol_timing(protocol_name);
+    // The result carries the registry id, so the timing lookup is a direct index
+    if(protopirate_decoder_get_result(decoder_base, &ctx->result)) {
+        ctx->timing_info = protopirate_get_protocol_timing_by_index(ctx->result.protocol_id);
+    } else {
+        ctx->timing_info = NULL;
+    }
 
     if(ctx->timing_info) {
         FURI_LOG_I(
             TAG,
             "Found timing for %s: short=%lu, long=%lu, delta=%lu",
-            ctx->timing_info->name,
-            ctx->timing_info->te_short,
-            ctx->timing_info->te_long,
-            ctx->timing_info->te_delta);
+            ctx->timing_info->protocol->name,
+            (uint32_t)ctx->timing_info->timing->te_short,
+            (uint32_t)ctx->timing_info->timing->te_long,
+            (uint32_t)ctx->timing_info->timing->te_delta);
     } else {
         FURI_LOG_W(TAG, "No timing info found for protocol: %s", protocol_name);
     }
@@ -609,20 +647,20 @@ static void timing_tuner_pair_callback(void* context, bool level, uint32_t durat
 void protopirate_scene_timing_tuner_on_enter(void* context) {
     furi_check(context);
     ProtoPirateApp* app = context;
+    protopirate_app_wait_assets(app, AssetLoaderAll);
 
     //Stop charging while using the radio.
     furi_hal_power_suppress_charge_enter();
 
     FURI_LOG_I(TAG, "Entering Timing Tuner");
 
-    g_timing_ctx = malloc(sizeof(TimingTunerContext));
-    if(!g_timing_ctx) {
+    if(!scene_arena_reserve(&app->scene_arena, SCENE_ARENA_SIZE_OF(TimingTunerContext))) {
         FURI_LOG_E(TAG, "Failed to allocate timing tuner context");
         notification_message(app->notifications, &sequence_error);
         scene_manager_previous_scene(app->scene_manager);
         return;
     }
-    memset(g_timing_ctx, 0, sizeof(TimingTunerContext));
+    g_timing_ctx = scene_arena_alloc(&app->scene_arena, sizeof(TimingTunerContext));
     g_timing_ctx->is_receiving = false;
     g_timing_ctx->has_match = false;
     g_timing_ctx->rssi = -127.0f;
@@ -646,11 +684,9 @@ void protopirate_scene_timing_tuner_on_enter(void* context) {
             return;
         }
         // Set up worker callbacks
-        subghz_worker_set_overrun_callback(
-            app->txrx->worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
-        subghz_worker_set_pair_callback(
-            app->txrx->worker, (SubGhzWorkerPairCallback)subghz_receiver_decode);
-        subghz_worker_set_context(app->txrx->worker, app->txrx->receiver);
+        subghz_worker_set_overrun_callback(app->txrx->worker, protopirate_rx_overrun_callback);
+        subghz_worker_set_pair_callback(app->txrx->worker, protopirate_rx_pair_callback);
+        subghz_worker_set_context(app->txrx->worker, app);
     }
 
     subghz_receiver_set_rx_callback(app->txrx->receiver, timing_tuner_rx_callback, app);
@@ -720,8 +756,8 @@ void protopirate_scene_timing_tuner_on_exit(void* context) {
     view_set_input_callback(app->view_about, NULL);
 
     if(g_timing_ctx) {
-        free(g_timing_ctx);
         g_timing_ctx = NULL;
+        scene_arena_release(&app->scene_arena);
     }
 
     furi_hal_power_suppress_charge_exit();
@@ -1,10 +1,10 @@
 // views/protopirate_receiver.c
 #include "protopirate_receiver.h"
 #include "../protopirate_app_i.h"
+#include "../helpers/draw_tables.h"
 #include <input/input.h>
 #include <gui/elements.h>
 #include <furi.h>
-#include <math.h>
 
 #ifdef BUILD_MAIN_APP
 #include "proto_pirate_icons.h"
@@ -17,12 +17,6 @@
 #define MENU_ITEMS               4u
 #define UNLOCK_CNT               3
 #define SUBGHZ_RAW_THRESHOLD_MIN -90.0f
-typedef struct {
-    FuriString* item_str;
-    uint8_t type;
-} ProtoPirateReceiverMenuItem;
-
-ARRAY_DEF(ProtoPirateReceiverMenuItemArray, ProtoPirateReceiverMenuItem, M_POD_OPLIST)
 
 struct ProtoPirateReceiver {
     View* view;
@@ -31,7 +25,10 @@ struct ProtoPirateReceiver {
 };
 
 typedef struct {
-    ProtoPirateReceiverMenuItemArray_t history_item_arr;
+    ProtoPirateReceiverItemCallback item_callback;
+    void* item_context;
+    uint16_t item_count;
+    FuriString* item_str;
     uint8_t list_offset;
     uint8_t history_item;
     float rssi;
@@ -119,7 +116,7 @@ static void protopirate_view_receiver_update_offset(ProtoPirateReceiver* receive
         {
             size_t history_item = model->history_item;
             size_t list_offset = model->list_offset;
-            size_t item_count = ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
+            size_t item_count = model->item_count;
 
             if(history_item < list_offset) {
                 model->list_offset = history_item;
@@ -139,20 +136,31 @@ static void protopirate_view_receiver_update_offset(ProtoPirateReceiver* receive
         true);
 }
 
-void protopirate_view_receiver_add_item_to_menu(
+void protopirate_view_receiver_set_item_source(
     ProtoPirateReceiver* receiver,
-    const char* name,
-    uint8_t type) {
+    ProtoPirateReceiverItemCallback callback,
+    void* context) {
     furi_check(receiver);
     with_view_model(
         receiver->view,
         ProtoPirateReceiverModel * model,
         {
-            ProtoPirateReceiverMenuItem* item_menu =
-                ProtoPirateReceiverMenuItemArray_push_raw(model->history_item_arr);
-            const char* safe_name = name ? name : "EMPTY_NAME";
-            item_menu->item_str = furi_string_alloc_set(safe_name);
-            item_menu->type = type;
+            model->item_callback = callback;
+            model->item_context = context;
+        },
+        false);
+}
+
+void protopirate_view_receiver_set_item_count(ProtoPirateReceiver* receiver, uint16_t count) {
+    furi_check(receiver);
+    with_view_model(
+        receiver->view,
+        ProtoPirateReceiverModel * model,
+        {
+            model->item_count = count;
+            if(model->history_item >= count) {
+                model->history_item = count > 0 ? count - 1 : 0;
+            }
         },
         true);
     protopirate_view_receiver_update_offset(receiver);
@@ -192,6 +200,9 @@ static void protopirate_view_receiver_draw_frame(Canvas* canvas, uint16_t idx, b
 }
 
 void protopirate_view_receiver_draw(Canvas* canvas, ProtoPirateReceiverModel* model) {
+    uint32_t frame_start = protopirate_frame_begin();
+    bool lean = protopirate_frame_lean(ProtoPirateFrameReceiver);
+
     canvas_clear(canvas);
     canvas_set_color(canvas, ColorBlack);
     canvas_set_font(canvas, FontSecondary);
@@ -200,11 +211,9 @@ void protopirate_view_receiver_draw(Canvas* canvas, ProtoPirateReceiverModel* mo
     static uint8_t animation_frame = 0;
     animation_frame = (animation_frame + 1) % 96;
 
-    size_t item_count = ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
+    size_t item_count = model->item_callback ? model->item_count : 0;
     bool scrollbar = item_count > MENU_ITEMS;
-
-    FuriString* str_buff;
-    str_buff = furi_string_alloc();
+    FuriString* str_buff = model->item_str;
 
     if(!model->sub_decode_mode) {
         //Config button. (Do it at the top so we dont get Inversion problems from the list view part.)
@@ -245,10 +254,8 @@ void protopirate_view_receiver_draw(Canvas* canvas, ProtoPirateReceiverModel* mo
 
         for(size_t i = 0; i < MIN(item_count, MENU_ITEMS); i++) {
             size_t idx = shift_position + i;
-            ProtoPirateReceiverMenuItem* item =
-                ProtoPirateReceiverMenuItemArray_get(model->history_item_arr, idx);
 
-            furi_string_set(str_buff, item->item_str);
+            model->item_callback(model->item_context, idx, str_buff);
             elements_string_fit_width(canvas, str_buff, scrollbar ? MAX_LEN_PX - 6 : MAX_LEN_PX);
 
             if(model->history_item == idx) {
@@ -289,9 +296,9 @@ void protopirate_view_receiver_draw(Canvas* canvas, ProtoPirateReceiverModel* mo
 
                     // Draw circle with dots
                     for(int angle = 0; angle < 360; angle += (360 / dot_density)) {
-                        float rad = (angle + wave * 15) * 3.14159 / 180.0;
-                        int x = center_x + base_radius * cosf(rad);
-                        int y = center_y + base_radius * sinf(rad);
+                        uint8_t rad = DRAW_DEGREES(angle + wave * 15);
+                        int x = draw_polar_x(center_x, base_radius, rad);
+                        int y = draw_polar_y(center_y, base_radius, rad);
 
                         // Only draw if within bounds and create fade effect
                         if(x > 0 && x < 128 && y > 0 && y < 48) {
@@ -320,44 +327,47 @@ void protopirate_view_receiver_draw(Canvas* canvas, ProtoPirateReceiverModel* mo
 
             // Static guide circles (very faint)
             for(int angle = 0; angle < 360; angle += 45) {
-                float rad = angle * 3.14159f / 180.0f;
-                canvas_draw_dot(canvas, center_x + 15 * cosf(rad), center_y + 15 * sinf(rad));
+                uint8_t rad = DRAW_DEGREES(angle);
+                canvas_draw_dot(
+                    canvas, draw_polar_x(center_x, 15, rad), draw_polar_y(center_y, 15, rad));
             }
 
-            // Rotating sweep line with glow effect
-            float sweep_angle = (animation_frame * 3.75f) * 3.14159f / 180.0f;
+            // Rotating sweep line with glow effect, 3.75 degrees a frame
+            uint8_t sweep_angle = animation_frame * 8 / 3;
 
             // Main sweep line
-            int sweep_x = center_x + 22 * cosf(sweep_angle);
-            int sweep_y = center_y + 22 * sinf(sweep_angle);
+            int sweep_x = draw_polar_x(center_x, 22, sweep_angle);
+            int sweep_y = draw_polar_y(center_y, 22, sweep_angle);
             canvas_draw_line(canvas, center_x, center_y, sweep_x, sweep_y);
 
-            // Sweep "glow" - additional lines at slight offsets
-            float glow_angle1 = sweep_angle - 0.05f;
-            float glow_angle2 = sweep_angle + 0.05f;
-            canvas_draw_line(
-                canvas,
-                center_x,
-                center_y,
-                center_x + 20 * cosf(glow_angle1),
-                center_y + 20 * sinf(glow_angle1));
-            canvas_draw_line(
-                canvas,
-                center_x,
-                center_y,
-                center_x + 20 * cosf(glow_angle2),
-                center_y + 20 * sinf(glow_angle2));
-
-            // Sweep trail (fading dots)
-            for(int i = 1; i <= 12; i++) {
-                float trail_angle = sweep_angle - (i * 0.15f);
-                int trail_radius = 22 - i;
-                if(trail_radius > 0) {
-                    int trail_x = center_x + trail_radius * cosf(trail_angle);
-                    int trail_y = center_y + trail_radius * sinf(trail_angle);
+            // Glow and trail are decoration, dropped while frames run long
+            if(!lean) {
+                // Sweep "glow" - additional lines about 3 degrees either side
+                uint8_t glow_angle1 = sweep_angle - 2;
+                uint8_t glow_angle2 = sweep_angle + 2;
+                canvas_draw_line(
+                    canvas,
+                    center_x,
+                    center_y,
+                    draw_polar_x(center_x, 20, glow_angle1),
+                    draw_polar_y(center_y, 20, glow_angle1));
+                canvas_draw_line(
+                    canvas,
+                    center_x,
+                    center_y,
+                    draw_polar_x(center_x, 20, glow_angle2),
+                    draw_polar_y(center_y, 20, glow_angle2));
+
+                // Sweep trail (fading dots), about 9 degrees apart
+                for(int i = 1; i <= 12; i++) {
+                    uint8_t trail_angle = sweep_angle - i * 6;
+                    int trail_radius = 22 - i;
                     // Only draw every other dot in trail for fade effect
                     if(i % 2 == 0 || i < 4) {
-                        canvas_draw_dot(canvas, trail_x, trail_y);
+                        canvas_draw_dot(
+                            canvas,
+                            draw_polar_x(center_x, trail_radius, trail_angle),
+                            draw_polar_y(center_y, trail_radius, trail_angle));
                     }
                 }
             }
@@ -400,7 +410,7 @@ void protopirate_view_receiver_draw(Canvas* canvas, ProtoPirateReceiverModel* mo
         }
     }
 
-    furi_string_free(str_buff);
+    protopirate_frame_end(ProtoPirateFrameReceiver, frame_start);
 }
 
 bool protopirate_view_receiver_input(InputEvent* event, void* context) {
@@ -464,8 +474,7 @@ bool protopirate_view_receiver_input(InputEvent* event, void* context) {
                 receiver->view,
                 ProtoPirateReceiverModel * model,
                 {
-                    size_t item_count =
-                        ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
+                    size_t item_count = model->item_count;
                     if(item_count > 0 && model->history_item < item_count - 1) {
                         model->history_item++;
                     }
@@ -481,6 +490,10 @@ bool protopirate_view_receiver_input(InputEvent* event, void* context) {
             consumed = true;
             break;
         case InputKeyRight:
+            if(event->type == InputTypeShort && receiver->callback) {
+                receiver->callback(
+                    ProtoPirateCustomEventViewReceiverDiagnostics, receiver->context);
+            }
             consumed = true;
             break;
         case InputKeyOk:
@@ -491,10 +504,7 @@ bool protopirate_view_receiver_input(InputEvent* event, void* context) {
                 receiver->view,
                 ProtoPirateReceiverModel * model,
                 {
-                    size_t item_count =
-                        ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
-
-                    if(item_count > 0) {
+                    if(model->item_count > 0) {
                         do_ok_cb = true;
                     } else if(event->type == InputTypeLong) {
                         do_toggle = true;
@@ -549,7 +559,10 @@ ProtoPirateReceiver* protopirate_view_receiver_alloc(bool auto_save) {
         receiver->view,
         ProtoPirateReceiverModel * model,
         {
-            ProtoPirateReceiverMenuItemArray_init(model->history_item_arr);
+            model->item_callback = NULL;
+            model->item_context = NULL;
+            model->item_count = 0;
+            model->item_str = furi_string_alloc();
             model->frequency_str = furi_string_alloc();
             model->preset_str = furi_string_alloc();
             model->history_stat_str = furi_string_alloc();
@@ -576,13 +589,7 @@ void protopirate_view_receiver_free(ProtoPirateReceiver* receiver) {
         receiver->view,
         ProtoPirateReceiverModel * model,
         {
-            for(size_t i = 0; i < ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
-                i++) {
-                ProtoPirateReceiverMenuItem* item =
-                    ProtoPirateReceiverMenuItemArray_get(model->history_item_arr, i);
-                furi_string_free(item->item_str);
-            }
-            ProtoPirateReceiverMenuItemArray_clear(model->history_item_arr);
+            furi_string_free(model->item_str);
             furi_string_free(model->frequency_str);
             furi_string_free(model->preset_str);
             furi_string_free(model->history_stat_str);
@@ -599,13 +606,10 @@ void protopirate_view_receiver_reset_menu(ProtoPirateReceiver* receiver) {
         receiver->view,
         ProtoPirateReceiverModel * model,
         {
-            for(size_t i = 0; i < ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
-                i++) {
-                ProtoPirateReceiverMenuItem* item =
-                    ProtoPirateReceiverMenuItemArray_get(model->history_item_arr, i);
-                furi_string_free(item->item_str);
-            }
-            ProtoPirateReceiverMenuItemArray_reset(model->history_item_arr);
+            // Rows live in the item source, so there is nothing to free here
+            model->item_callback = NULL;
+            model->item_context = NULL;
+            model->item_count = 0;
             model->history_item = 0;
             model->list_offset = 0;
         },
@@ -632,7 +636,7 @@ void protopirate_view_receiver_set_idx_menu(ProtoPirateReceiver* receiver, uint1
         ProtoPirateReceiverModel * model,
         {
             model->history_item = idx;
-            size_t item_count = ProtoPirateReceiverMenuItemArray_size(model->history_item_arr);
+            size_t item_count = model->item_count;
             if(model->history_item >= item_count) {
                 model->history_item = item_count > 0 ? item_count - 1 : 0;
             }
@@ -8,6 +8,10 @@ typedef struct ProtoPirateReceiver ProtoPirateReceiver;
 
 typedef void (*ProtoPirateReceiverCallback)(ProtoPirateCustomEvent event, void* context);
 
+// Renders the menu line for row idx. Called from the draw callback, only for
+// visible rows, so menu text is never copied into the view.
+typedef void (*ProtoPirateReceiverItemCallback)(void* context, uint16_t idx, FuriString* output);
+
 void protopirate_view_receiver_set_callback(
     ProtoPirateReceiver* receiver,
     ProtoPirateReceiverCallback callback,
@@ -17,10 +21,12 @@ ProtoPirateReceiver* protopirate_view_receiver_alloc(bool auto_save);
 void protopirate_view_receiver_free(ProtoPirateReceiver* receiver);
 View* protopirate_view_receiver_get_view(ProtoPirateReceiver* receiver);
 
-void protopirate_view_receiver_add_item_to_menu(
+void protopirate_view_receiver_set_item_source(
     ProtoPirateReceiver* receiver,
-    const char* name,
-    uint8_t type);
+    ProtoPirateReceiverItemCallback callback,
+    void* context);
+
+void protopirate_view_receiver_set_item_count(ProtoPirateReceiver* receiver, uint16_t count);
 
 void protopirate_view_receiver_add_data_statusbar(
     ProtoPirateReceiver* receiver,